@@ -109,6 +109,22 @@ typedef struct st_heap_block
 
 struct st_heap_info;			/* For referense */
 
+/*
+  Column that is stored with its actual length in the dynamic row format.
+  Only VARCHAR and BLOB columns are described, all other bytes of the
+  record are copied as is.
+*/
+
+typedef struct st_hp_columndef
+{
+  enum en_fieldtype type;		/* FIELD_VARCHAR or FIELD_BLOB */
+  uint offset;				/* Offset of column in record */
+  uint length;				/* Length of column in record */
+  uint length_bytes;			/* Bytes used to store data length */
+  uint null_pos;			/* Position of null byte */
+  uint8 null_bit;			/* If column may be NULL */
+} HP_COLUMNDEF;
+
 typedef struct st_hp_keydef		/* Key definition with open */
 {
   uint flag;				/* HA_NOSAME | HA_NULL_PART_KEY */
@@ -134,16 +150,21 @@ typedef struct st_heap_share
 {
   HP_BLOCK block;
   HP_KEYDEF  *keydef;
+  HP_COLUMNDEF *columndef;		/* Only used with dynamic rows */
   ulonglong data_length,index_length,max_table_size;
   ulonglong auto_increment;
   ulong min_records,max_records;	/* Params to open */
   ulong records;			/* records */
   ulong blength;			/* records rounded up to 2^n */
   ulong deleted;			/* Deleted records in database */
+  ulong chunks;				/* Used chunks with dynamic rows */
   uint key_stat_version;                /* version to indicate insert/delete */
   uint key_version;                     /* Updated on key change */
   uint file_version;                    /* Update on clear */
   uint reclength;			/* Length of one record */
+  uint visible;				/* Offset to the status byte */
+  uint chunk_length;			/* Data bytes in one chunk */
+  uint columns;				/* Elements in columndef */
   uint changed;
   uint keys,max_key_length;
   uint currently_disabled_keys;    /* saved value from "keys" when disabled */
@@ -155,6 +176,8 @@ typedef struct st_heap_share
   mysql_mutex_t intern_lock;            /* Locking for use with _locking */
   my_bool delete_on_close;
   my_bool internal;                     /* Internal temporary table */
+  my_bool dynamic;			/* Rows are stored in chunks */
+  my_bool blobs;			/* Dynamic rows with blob columns */
   LIST open_list;
   uint auto_key;
   uint auto_key_type;			/* real type of the auto key segment */
@@ -173,6 +196,10 @@ typedef struct st_heap_info
   uint opt_flag,update;
   uchar *lastkey;			/* Last used key with rkey */
   uchar *recbuf;                         /* Record buffer for rb-tree keys */
+  uchar *cmp_record;			/* Dynamic row unpacked for compare */
+  uchar *rec_buff;			/* Packed dynamic row */
+  uchar *blob_buff;			/* Blob data of last read row */
+  size_t rec_buff_length, blob_buff_length;
   enum ha_rkey_function last_find_flag;
   TREE_ELEMENT *parents[MAX_TREE_HEIGHT+1];
   TREE_ELEMENT **last_pos;
@@ -188,6 +215,8 @@ typedef struct st_heap_info
 typedef struct st_heap_create_info
 {
   HP_KEYDEF *keydef;
+  HP_COLUMNDEF *columndef;		/* Use dynamic rows if columns > 0 */
+  uint columns;
   uint auto_key;                        /* keynr [1 - maxkey] for auto key */
   uint auto_key_type;
   uint keys;
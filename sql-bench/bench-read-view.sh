@@ -0,0 +1,191 @@
+#!/usr/bin/perl
+# Copyright (c) 2015, MariaDB Corporation
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Library General Public
+# License as published by the Free Software Foundation; version 2
+# of the License.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Library General Public License for more details.
+#
+# You should have received a copy of the GNU Library General Public
+# License along with this library; if not, write to the Free
+# Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston,
+# MA 02110-1301, USA
+#
+# Test of opening InnoDB read views from many connections.
+# Every statement is a short READ COMMITTED primary key lookup, so that
+# the cost of taking the MVCC snapshot is a large part of it. The test
+# is run with 1, 2, 4 ... 64 connections, first without and then with a
+# connection that commits small transactions all the time.
+#
+##################### Standard benchmark inits ##############################
+
+use Cwd;
+use DBI;
+use Getopt::Long;
+use Benchmark;
+
+$opt_loop_count=20000;
+$opt_row_count=10000;
+@clients=(1,2,4,8,16,32,64);
+
+$pwd = cwd(); $pwd = "." if ($pwd eq '');
+require "$pwd/bench-init.pl" || die "Can't read Configuration file: $!\n";
+
+if ($opt_small_test)
+{
+  $opt_loop_count/=10;
+  $opt_row_count/=10;
+}
+
+print "Testing the speed of opening read views from many connections\n";
+print "Every connection does $opt_loop_count primary key lookups on a table with $opt_row_count rows\n\n";
+
+####
+####  Connect and start timeing
+####
+
+$dbh = $server->connect();
+$start_time=new Benchmark;
+
+####
+#### Create needed tables
+####
+
+goto select_test if ($opt_skip_create);
+
+print "Creating table\n";
+$dbh->do("drop table bench1" . $server->{'drop_attr'});
+
+do_many($dbh,$server->create("bench1",
+			     ["a integer NOT NULL",
+			      "b integer NOT NULL"],
+			     ["primary key (a)"]));
+
+print "Inserting $opt_row_count rows\n";
+$loop_time=new Benchmark;
+do_query($dbh,"begin");
+for ($i=0 ; $i < $opt_row_count ; $i++)
+{
+  do_query($dbh,"insert into bench1 values ($i,$i)");
+}
+do_query($dbh,"commit");
+$end_time=new Benchmark;
+print "Time to insert ($opt_row_count): " .
+    timestr(timediff($end_time, $loop_time),"all") . "\n\n";
+
+select_test:
+
+foreach $writer (0,1)
+{
+  print "Testing with " . ($writer ? "one" : "no") . " committing connection\n";
+  foreach $count (@clients)
+  {
+    $pid_writer=0;
+    if ($writer && !($pid_writer=fork()))
+    {
+      $dbh->{InactiveDestroy}=1;	# Don't close the parent connection
+      run_writer();
+      exit(0);
+    }
+    %status_before=read_view_status($dbh);
+    $loop_time=new Benchmark;
+    $hires_start=time_now();
+    for ($i=0 ; $i < $count ; $i++)
+    {
+      if (!fork())
+      {
+	$dbh->{InactiveDestroy}=1;
+	run_reader($i);
+	exit(0);
+      }
+    }
+    for ($i=0 ; $i < $count ; $i++)
+    {
+      wait();
+    }
+    $elapsed=time_now() - $hires_start;
+    $end_time=new Benchmark;
+    if ($pid_writer)
+    {
+      kill('TERM', $pid_writer);
+      waitpid($pid_writer, 0);
+    }
+    %status_after=read_view_status($dbh);
+    $statements=$count * $opt_loop_count;
+    printf("Time for select_key_rc with %2d connections (%d): %s\n",
+	   $count, $statements,
+	   timestr(timediff($end_time, $loop_time),"all"));
+    printf("  %.0f statements/second, read views reused: %d, recopied: %d\n",
+	   $elapsed > 0 ? $statements / $elapsed : 0,
+	   $status_after{'reused'} - $status_before{'reused'},
+	   $status_after{'recopied'} - $status_before{'recopied'});
+  }
+  print "\n";
+}
+
+####
+#### End of benchmark
+####
+
+$dbh->do("drop table bench1" . $server->{'drop_attr'})
+  if (!$opt_skip_delete);
+
+$dbh->disconnect;				# close connection
+
+end_benchmark($start_time);
+
+
+sub run_reader
+{
+  my ($client)=@_;
+  my ($dbh,$sth,$i);
+  $dbh = $server->connect();
+  $dbh->do("set session transaction isolation level read committed");
+  $sth=$dbh->prepare("select b from bench1 where a=?") or die $DBI::errstr;
+  for ($i=0 ; $i < $opt_loop_count ; $i++)
+  {
+    $sth->execute(($i * 7919 + $client) % $opt_row_count)
+      or die $DBI::errstr;
+    $sth->fetchall_arrayref();
+  }
+  $dbh->disconnect;
+}
+
+sub run_writer
+{
+  my ($dbh,$sth,$i);
+  $dbh = $server->connect();
+  $sth=$dbh->prepare("update bench1 set b=b+1 where a=?") or die $DBI::errstr;
+  for ($i=0 ; ; $i++)
+  {
+    $sth->execute($i % $opt_row_count) or die $DBI::errstr;
+  }
+}
+
+sub read_view_status
+{
+  my ($dbh)=@_;
+  my ($sth,$row,%status);
+  $status{'reused'}=$status{'recopied'}=0;
+  $sth=$dbh->prepare("show global status like 'Innodb_read_views_re%'");
+  if ($sth && $sth->execute)
+  {
+    while ($row=$sth->fetchrow_arrayref)
+    {
+      $status{'reused'}=$row->[1] if ($row->[0] =~ /reused$/i);
+      $status{'recopied'}=$row->[1] if ($row->[0] =~ /recopied$/i);
+    }
+    $sth->finish;
+  }
+  return %status;
+}
+
+sub time_now
+{
+  return $opt_hires ? Time::HiRes::time() : time();
+}
@@ -130,6 +130,8 @@ void Sort_param::init_for_filesort(uint sortlen, TABLE *table,
                               when rowids are required by executor)
   @param[out] examined_rows  Store number of examined rows here
   @param[out] found_rows     Store the number of found rows here
+  @param      tracker        If not NULL, report the number of threads
+                             used for sorting here (for ANALYZE)
 
   @note
     If we sort by position (like if sort_positions is 1) filesort() will
@@ -145,7 +147,8 @@ ha_rows filesort(THD *thd, TABLE *table, SORT_FIELD *sortorder, uint s_length,
 		 SQL_SELECT *select, ha_rows max_rows,
                  bool sort_positions,
                  ha_rows *examined_rows,
-                 ha_rows *found_rows)
+                 ha_rows *found_rows,
+                 Filesort_tracker *tracker)
 {
   int error;
   size_t memory_available= thd->variables.sortbuff_size;
@@ -195,6 +198,10 @@ ha_rows filesort(THD *thd, TABLE *table, SORT_FIELD *sortorder, uint s_length,
                           table,
                           thd->variables.max_length_for_sort_data,
                           max_rows, sort_positions);
+  param.sort_threads= (uint) thd->variables.filesort_threads;
+  if (param.sort_threads > 1)
+    param.workers= new Filesort_workers;
+  param.tracker= tracker;
 
   table_sort.addon_buf= 0;
   table_sort.addon_length= param.addon_length;
@@ -364,6 +371,7 @@ ha_rows filesort(THD *thd, TABLE *table, SORT_FIELD *sortorder, uint s_length,
   error= 0;
 
   err:
+  delete param.workers;
   my_free(param.tmp_buffer);
   if (!subselect || !subselect->is_uncacheable())
   {
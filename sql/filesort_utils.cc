@@ -18,6 +18,7 @@
 #include "sql_sort.h"
 #include "table.h"
 #include "my_sys.h"
+#include "mysqld.h"                             // key_thread_filesort
 
 
 namespace {
@@ -123,21 +124,394 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
+/*
+  MSD radix sort of memcmp-comparable keys.
+
+  The sort works on an array of (prefix, pointer) pairs, where prefix holds
+  the next 8 bytes of the key as a big-endian integer. Bucketing and the
+  final insertion sort of small buckets then mostly touch the contiguous
+  pair array instead of chasing the key pointers. When all 8 bytes of the
+  prefix are equal within a bucket, the prefixes of that bucket are
+  reloaded from the following 8 bytes of the keys.
+*/
+
+/* Buckets smaller than this are sorted with insertion sort */
+#define MSD_RADIX_INSERTION_SORT_LIMIT 32
+
+static inline ulonglong load_key_prefix(const uchar *key, size_t length)
+{
+  ulonglong prefix= 0;
+  size_t i;
+  for (i= 0; i < length && i < 8; i++)
+    prefix= (prefix << 8) | key[i];
+  return i < 8 ? prefix << (8 * (8 - i)) : prefix;
+}
+
+
+static void load_key_prefixes(Sort_key_prefix *keys, size_t count,
+                              size_t offset, size_t sort_length)
+{
+  for (Sort_key_prefix *end= keys + count; keys < end; keys++)
+    keys->prefix= load_key_prefix(keys->key + offset, sort_length - offset);
+}
+
+
+static inline int cmp_key_prefix(const Sort_key_prefix *a,
+                                 const Sort_key_prefix *b,
+                                 size_t offset, size_t sort_length)
+{
+  if (a->prefix != b->prefix)
+    return a->prefix < b->prefix ? -1 : 1;
+  if (offset + 8 >= sort_length)
+    return 0;
+  return memcmp(a->key + offset + 8, b->key + offset + 8,
+                sort_length - offset - 8);
+}
+
+
+static void insertion_sort_key_prefixes(Sort_key_prefix *keys, size_t count,
+                                        size_t offset, size_t sort_length)
+{
+  for (size_t i= 1; i < count; i++)
+  {
+    Sort_key_prefix tmp= keys[i];
+    size_t j= i;
+    for (; j > 0 && cmp_key_prefix(&tmp, &keys[j - 1], offset, sort_length) < 0;
+         j--)
+      keys[j]= keys[j - 1];
+    keys[j]= tmp;
+  }
+}
+
+
+/**
+  Sort keys[0..count) on byte 'byte' of the prefix and onwards.
+  All keys are known to be equal before byte 'byte' of the prefix,
+  which holds the key bytes starting at 'offset'.
+*/
+static void msd_radix_sort(Sort_key_prefix *keys, Sort_key_prefix *tmp,
+                           size_t count, uint byte, size_t offset,
+                           size_t sort_length)
+{
+  uint32 bucket[257];
+
+  for (;;)
+  {
+    if (byte == 8)
+    {
+      /* The whole prefix is equal, continue with the next 8 key bytes */
+      offset+= 8;
+      if (offset >= sort_length)
+        return;
+      load_key_prefixes(keys, count, offset, sort_length);
+      byte= 0;
+    }
+    if (offset + byte >= sort_length)
+      return;                                   // All keys are equal
+    if (count < MSD_RADIX_INSERTION_SORT_LIMIT)
+    {
+      insertion_sort_key_prefixes(keys, count, offset, sort_length);
+      return;
+    }
+
+    uint shift= 56 - 8 * byte;
+    bzero(bucket, sizeof(bucket));
+    for (size_t i= 0; i < count; i++)
+      bucket[(keys[i].prefix >> shift) & 0xff]++;
+    if (bucket[(keys[0].prefix >> shift) & 0xff] != count)
+      break;
+    byte++;                                     // Same byte in all keys
+  }
+
+  /* Turn the bucket sizes into bucket ends, and by scattering into starts */
+  for (uint b= 1; b < 256; b++)
+    bucket[b]+= bucket[b - 1];
+  bucket[256]= (uint32) count;
+  for (size_t i= count; i-- > 0; )
+    tmp[--bucket[(keys[i].prefix >> (56 - 8 * byte)) & 0xff]]= keys[i];
+  memcpy(keys, tmp, count * sizeof(*keys));
+
+  for (uint b= 0; b < 256; b++)
+  {
+    uint32 size= bucket[b + 1] - bucket[b];
+    if (size > 1)
+      msd_radix_sort(keys + bucket[b], tmp + bucket[b], size, byte + 1,
+                     offset, sort_length);
+  }
+}
+
+
+bool msd_radixsort_is_applicable(uint count, size_t sort_length)
+{
+  return count >= MSD_RADIX_MIN_KEYS && sort_length <= MSD_RADIX_MAX_KEY_LENGTH;
+}
+
+
+void msd_radixsort_for_str_ptr(uchar **keys, uint count, size_t sort_length,
+                               Sort_key_prefix *work)
+{
+  Sort_key_prefix *prefixes= work, *tmp= work + count;
+  for (uint i= 0; i < count; i++)
+    prefixes[i].key= keys[i];
+  load_key_prefixes(prefixes, count, 0, sort_length);
+  msd_radix_sort(prefixes, tmp, count, 0, 0, sort_length);
+  for (uint i= 0; i < count; i++)
+    keys[i]= prefixes[i].key;
+}
+
+
+/*
+  Do not hand less than this many keys to a sort thread; for smaller
+  buffers the cost of starting threads exceeds the gain.
+*/
+#define MIN_KEYS_PER_SORT_THREAD 16384
+
+/**
+  A piece of work for a filesort helper thread: either sort the
+  keys in [from, from+count), or merge the two sorted runs
+  [from, from+count) and [from+count, from+count+count2) into 'to'.
+  If work is not NULL, the keys are sorted with a radix sort using it
+  as work area.
+ */
+struct Sort_chunk
+{
+  uchar **from;
+  uchar **to;
+  Sort_key_prefix *work;
+  size_t count;
+  size_t count2;
+  size_t sort_length;
+};
+
+namespace {
+
+void sort_chunk(Sort_chunk *chunk)
+{
+  uint count= (uint) chunk->count;
+  size_t size= chunk->sort_length;
+  if (count <= 1)
+    return;
+  if (chunk->work)
+    msd_radixsort_for_str_ptr(chunk->from, count, size, chunk->work);
+  else
+    my_qsort2(chunk->from, count, sizeof(uchar*), get_ptr_compare(size), &size);
+}
+
+
+void merge_chunk(Sort_chunk *chunk)
+{
+  uchar **a= chunk->from, **a_end= a + chunk->count;
+  uchar **b= a_end, **b_end= b + chunk->count2;
+  uchar **to= chunk->to;
+  size_t size= chunk->sort_length;
+
+  while (a != a_end && b != b_end)
+    *to++= (memcmp(*b, *a, size) < 0) ? *b++ : *a++;
+  while (a != a_end)
+    *to++= *a++;
+  while (b != b_end)
+    *to++= *b++;
+}
+
+
+pthread_handler_t filesort_worker_thread(void *arg)
+{
+  my_thread_init();
+  ((Filesort_workers*) arg)->work();
+  my_thread_end();
+  return 0;
+}
+} // namespace
+
+
+Filesort_workers::Filesort_workers()
+  :n_threads(0), chunks(NULL), n_chunks(0), next_chunk(0), pending(0),
+   func(NULL), stop(FALSE)
+{
+  mysql_mutex_init(key_LOCK_filesort_workers, &lock, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_filesort_work, &cond_work, NULL);
+  mysql_cond_init(key_COND_filesort_done, &cond_done, NULL);
+}
+
+
+Filesort_workers::~Filesort_workers()
+{
+  mysql_mutex_lock(&lock);
+  stop= TRUE;
+  mysql_cond_broadcast(&cond_work);
+  mysql_mutex_unlock(&lock);
+  for (uint i= 0; i < n_threads; i++)
+    pthread_join(threads[i], NULL);
+  mysql_cond_destroy(&cond_done);
+  mysql_cond_destroy(&cond_work);
+  mysql_mutex_destroy(&lock);
+}
+
+
+/** Main loop of a helper thread: process chunks until stopped */
+
+void Filesort_workers::work()
+{
+  mysql_mutex_lock(&lock);
+  for (;;)
+  {
+    while (!stop && next_chunk >= n_chunks)
+      mysql_cond_wait(&cond_work, &lock);
+    if (stop)
+      break;
+    Sort_chunk *chunk= chunks + next_chunk++;
+    mysql_mutex_unlock(&lock);
+    func(chunk);
+    mysql_mutex_lock(&lock);
+    if (!--pending)
+      mysql_cond_signal(&cond_done);
+  }
+  mysql_mutex_unlock(&lock);
+}
+
+
+/**
+  Run func on all chunks, in the helper threads and in the caller.
+  Helper threads are started as needed, and if a thread cannot be
+  started, the chunks are processed by fewer threads.
+
+  @return number of threads that did the work, including the caller
+*/
+
+uint Filesort_workers::run(Sort_chunk *chunks_arg, uint n_chunks_arg,
+                           void (*func_arg)(Sort_chunk*))
+{
+  while (n_threads + 1 < n_chunks_arg &&
+         !mysql_thread_create(key_thread_filesort, &threads[n_threads], NULL,
+                              filesort_worker_thread, this))
+    n_threads++;
+
+  mysql_mutex_lock(&lock);
+  chunks= chunks_arg;
+  func= func_arg;
+  n_chunks= n_chunks_arg;
+  next_chunk= 0;
+  pending= n_chunks_arg;
+  mysql_cond_broadcast(&cond_work);
+  while (next_chunk < n_chunks)
+  {
+    Sort_chunk *chunk= chunks + next_chunk++;
+    mysql_mutex_unlock(&lock);
+    func(chunk);
+    mysql_mutex_lock(&lock);
+    pending--;
+  }
+  while (pending)
+    mysql_cond_wait(&cond_done, &lock);
+  n_chunks= next_chunk= 0;
+  mysql_mutex_unlock(&lock);
+  return MY_MIN(n_chunks_arg, n_threads + 1);
+}
+
+
+/**
+  Sort the key pointers using several threads.
+
+  The pointer array is split into n_threads chunks which are sorted
+  concurrently. The sorted chunks are then merged pairwise, the merges
+  of a round in parallel, ping-ponging between the pointer array and
+  'buffer' until a single run is left. The chunks are processed by the
+  helper threads of 'workers' and by the calling thread.
+
+  @param work  If not NULL, work area of 2*count elements for radix
+               sorting the chunks
+
+  @return number of threads used for merging
+*/
+static uint parallel_sort(Filesort_workers *workers, uchar **keys,
+                          uchar **buffer, Sort_key_prefix *work,
+                          uint count, size_t sort_length, uint n_threads,
+                          uint *sort_threads)
+{
+  Sort_chunk chunks[MAX_FILESORT_THREADS];
+  size_t run_length[MAX_FILESORT_THREADS];
+  uint n_runs= n_threads;
+  uint merge_threads= 0;
+  size_t per_chunk= count / n_threads;
+
+  for (uint i= 0; i < n_runs; i++)
+  {
+    chunks[i].from= keys + i * per_chunk;
+    chunks[i].to= buffer + i * per_chunk;
+    chunks[i].work= work ? work + 2 * i * per_chunk : NULL;
+    chunks[i].count= (i == n_runs - 1) ? count - i * per_chunk : per_chunk;
+    chunks[i].sort_length= sort_length;
+    run_length[i]= chunks[i].count;
+  }
+  *sort_threads= workers->run(chunks, n_runs, sort_chunk);
+
+  uchar **from= keys, **to= buffer;
+  while (n_runs > 1)
+  {
+    uint n_merges= 0;
+    size_t offset= 0;
+    for (uint i= 0; i < n_runs; i+= 2)
+    {
+      Sort_chunk *chunk= &chunks[n_merges];
+      chunk->from= from + offset;
+      chunk->to= to + offset;
+      chunk->count= run_length[i];
+      chunk->count2= (i + 1 < n_runs) ? run_length[i + 1] : 0;
+      chunk->sort_length= sort_length;
+      run_length[n_merges++]= chunk->count + chunk->count2;
+      offset+= chunk->count + chunk->count2;
+    }
+    set_if_bigger(merge_threads,
+                  workers->run(chunks, n_merges, merge_chunk));
+    n_runs= n_merges;
+    swap_variables(uchar**, from, to);
+  }
+  if (from != keys)
+    memcpy(keys, from, count * sizeof(uchar*));
+  return merge_threads;
+}
+
+
 void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
+  uint sort_threads= 1, merge_threads= 0;
   if (count <= 1 || size == 0)
     return;
   uchar **keys= get_sort_keys();
-  uchar **buffer= NULL;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
-      (buffer= (uchar**) my_malloc(count*sizeof(char*),
+  uchar *buffer;
+  uint n_threads= param->workers ?
+    MY_MIN(param->sort_threads, count / MIN_KEYS_PER_SORT_THREAD) : 1;
+  set_if_smaller(n_threads, MAX_FILESORT_THREADS);
+  bool use_radix= msd_radixsort_is_applicable(count, size);
+
+  /*
+    Layout of buffer: work area for radix sort (if used) followed by the
+    pointer array used for merging (if sorting in parallel).
+  */
+  size_t work_size= use_radix ? 2 * count * sizeof(Sort_key_prefix) : 0;
+  size_t merge_size= n_threads > 1 ? count * sizeof(uchar*) : 0;
+  if (work_size + merge_size &&
+      !(buffer= (uchar*) my_malloc(work_size + merge_size,
                                    MYF(MY_THREAD_SPECIFIC))))
   {
-    radixsort_for_str_ptr(keys, count, param->sort_length, buffer);
-    my_free(buffer);
-    return;
+    /* Out of memory, fall back to an in-place sort */
+    work_size= merge_size= 0;
   }
-  
-  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+  Sort_key_prefix *work= work_size ? (Sort_key_prefix*) buffer : NULL;
+
+  if (merge_size)
+    merge_threads= parallel_sort(param->workers, keys,
+                                 (uchar**) (buffer + work_size), work,
+                                 count, size, n_threads, &sort_threads);
+  else if (work)
+    msd_radixsort_for_str_ptr(keys, count, size, work);
+  else
+    my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+
+  if (work_size + merge_size)
+    my_free(buffer);
+
+  if (param->tracker)
+    param->tracker->report_sort_threads(sort_threads, merge_threads);
 }
@@ -19,8 +19,11 @@
 #include "my_global.h"
 #include "my_base.h"
 #include "sql_array.h"
+#include "sql_const.h"
+#include "mysql/psi/mysql_thread.h"
 
 class Sort_param;
+struct Sort_chunk;
 /*
   Calculate cost of merge sort
 
@@ -45,6 +48,39 @@ double get_merge_many_buffs_cost_fast(ha_rows num_rows,
                                       uint    elem_size);
 
 
+/* Radix sort is used for buffers with at least this many keys */
+#define MSD_RADIX_MIN_KEYS 1000
+/* ... and keys not longer than this */
+#define MSD_RADIX_MAX_KEY_LENGTH 32
+
+/**
+  Element of the work area of msd_radixsort_for_str_ptr():
+  the key and the next 8 bytes of it as a big-endian integer.
+*/
+struct Sort_key_prefix
+{
+  ulonglong prefix;
+  uchar *key;
+};
+
+bool msd_radixsort_is_applicable(uint count, size_t sort_length);
+
+/**
+  Sort an array of pointers to memcmp-comparable keys of sort_length
+  bytes with a most-significant-digit-first radix sort.
+
+  @param keys         Pointers to the keys; sorted on return
+  @param count        Number of keys
+  @param sort_length  Length of each key
+  @param work         Work area of 2*count elements
+
+  @note
+    Declared here in order to be able to unit test it.
+*/
+void msd_radixsort_for_str_ptr(uchar **keys, uint count, size_t sort_length,
+                               Sort_key_prefix *work);
+
+
 /**
   A wrapper class around the buffer used by filesort().
   The buffer is a contiguous chunk of memory,
@@ -126,4 +162,34 @@ class Filesort_buffer
   uchar     *m_start_of_data;
 };
 
+
+/**
+  Helper threads of a parallel filesort.
+
+  The threads are started when a buffer is first sorted in parallel and
+  then take the chunks of all later runs and merge rounds of the same
+  filesort() call. They are stopped when the object is destroyed.
+*/
+class Filesort_workers
+{
+public:
+  Filesort_workers();
+  ~Filesort_workers();
+
+  uint run(Sort_chunk *chunks_arg, uint n_chunks_arg,
+           void (*func_arg)(Sort_chunk*));
+  void work();
+
+private:
+  mysql_mutex_t lock;
+  mysql_cond_t cond_work;                  // Signalled when chunks are added
+  mysql_cond_t cond_done;                  // Signalled when all are done
+  pthread_t threads[MAX_FILESORT_THREADS];
+  uint n_threads;
+  Sort_chunk *chunks;
+  uint n_chunks, next_chunk, pending;
+  void (*func)(Sort_chunk*);
+  bool stop;
+};
+
 #endif  // FILESORT_UTILS_INCLUDED
@@ -5396,6 +5396,7 @@ int handler::compare_key2(key_range *range)
 
 /**
   ICP callback - to be called by an engine to check the pushed condition
+  and the pushed rowid filter
 */
 extern "C" enum icp_result handler_index_cond_check(void* h_arg)
 {
@@ -5410,11 +5411,22 @@ extern "C" enum icp_result handler_index_cond_check(void* h_arg)
 
   if (h->end_range && h->compare_key2(h->end_range) > 0)
     return ICP_OUT_OF_RANGE;
-  h->increment_statistics(&SSV::ha_icp_attempts);
-  if ((res= h->pushed_idx_cond->val_int()? ICP_MATCH : ICP_NO_MATCH) ==
-      ICP_MATCH)
+  if (h->pushed_idx_cond)
+  {
+    h->increment_statistics(&SSV::ha_icp_attempts);
+    if ((res= h->pushed_idx_cond->val_int()? ICP_MATCH : ICP_NO_MATCH) ==
+        ICP_NO_MATCH)
+      return res;
     h->increment_statistics(&SSV::ha_icp_match);
-  return res;
+  }
+  /* The rowid of the index entry is known before the row is read */
+  if (h->pushed_rowid_filter && h->active_index == h->pushed_rowid_filter_keyno)
+  {
+    h->position(h->table->record[0]);
+    if (!h->pushed_rowid_filter->check(h->ref))
+      return ICP_NO_MATCH;
+  }
+  return ICP_MATCH;
 }
 
 int handler::index_read_idx_map(uchar * buf, uint index, const uchar * key,
@@ -5844,6 +5856,7 @@ int handler::ha_reset()
   tracker= NULL;
   /* Reset information about pushed engine conditions */
   cancel_pushed_idx_cond();
+  cancel_pushed_rowid_filter();
   /* Reset information about pushed index conditions */
   DBUG_RETURN(reset());
 }
@@ -252,6 +252,12 @@ enum enum_alter_inplace_result {
  */
 #define HA_CAN_EXPORT                 (1LL << 45)
 
+/*
+  The engine checks a rowid filter pushed with handler::rowid_filter_push()
+  for the index entries it reads, before it reads their rows
+*/
+#define HA_DO_ROWID_FILTER_PUSHDOWN   (1LL << 46)
+
 
 /*
   Set of all binlog flags. Currently only contain the capabilities
@@ -1573,6 +1579,7 @@ typedef struct {
 
 #define UNDEF_NODEGROUP 65535
 class Item;
+class Rowid_filter;
 struct st_table_log_memory_entry;
 
 class partition_info;
@@ -2603,6 +2610,9 @@ class handler :public Sql_alloc
   Item *pushed_idx_cond;
   uint pushed_idx_cond_keyno;  /* The index which the above condition is for */
 
+  Rowid_filter *pushed_rowid_filter;
+  uint pushed_rowid_filter_keyno; /* The index which the above filter is for */
+
   Discrete_interval auto_inc_interval_for_cur_row;
   /**
      Number of reserved auto-increment intervals. Serves as a heuristic
@@ -2656,6 +2666,8 @@ class handler :public Sql_alloc
     tracker(NULL),
     pushed_idx_cond(NULL),
     pushed_idx_cond_keyno(MAX_KEY),
+    pushed_rowid_filter(NULL),
+    pushed_rowid_filter_keyno(MAX_KEY),
     auto_inc_intervals_count(0),
     m_psi(NULL), m_lock_type(F_UNLCK), ha_share(NULL)
   {
@@ -3504,6 +3516,31 @@ class handler :public Sql_alloc
    pushed_idx_cond_keyno= MAX_KEY;
    in_range_check_pushed_down= false;
  }
+
+ /**
+   Push a rowid filter down to the storage engine
+
+   @details
+   The engine must not return the rows read with the index keyno whose
+   rowids are not in the filter.  Engines that support this have
+   HA_DO_ROWID_FILTER_PUSHDOWN in their table flags and check the filter
+   together with the pushed index condition, see handler_index_cond_check().
+
+   @param keyno   the index that the rows are read with
+   @param filter  the built filter
+
+   @retval FALSE  the filter is pushed
+   @retval TRUE   the engine does not check the filter
+ */
+ virtual bool rowid_filter_push(uint keyno, Rowid_filter *filter)
+ { return TRUE; }
+
+ /** Reset information about the pushed rowid filter */
+ virtual void cancel_pushed_rowid_filter()
+ {
+   pushed_rowid_filter= NULL;
+   pushed_rowid_filter_keyno= MAX_KEY;
+ }
  /**
    Part of old, deprecated in-place ALTER API.
  */
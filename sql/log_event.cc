@@ -6364,8 +6364,10 @@ bool Binlog_checkpoint_log_event::write(IO_CACHE *file)
 
 Gtid_log_event::Gtid_log_event(const char *buf, uint event_len,
                const Format_description_log_event *description_event)
-  : Log_event(buf, description_event), seq_no(0), commit_id(0)
+  : Log_event(buf, description_event), seq_no(0), commit_id(0),
+    write_set_count(0)
 {
+  const char *start= buf;
   uint8 header_size= description_event->common_header_len;
   uint8 post_header_len= description_event->post_header_len[GTID_EVENT-1];
   if (event_len < header_size + post_header_len ||
@@ -6388,6 +6390,20 @@ Gtid_log_event::Gtid_log_event(const char *buf, uint event_len,
     ++buf;
     commit_id= uint8korr(buf);
   }
+  if (flags2 & FL_WRITE_SET)
+  {
+    uint offset= header_size + GTID_HEADER_LEN +
+      ((flags2 & FL_GROUP_COMMIT_ID) ? 2 : 0);
+    if (event_len < offset + 1 ||
+        (write_set_count= (uchar) start[offset]) > GTID_MAX_WRITE_SET ||
+        event_len < offset + 1 + 4 * write_set_count)
+    {
+      seq_no= 0;                                // So is_valid() returns false
+      return;
+    }
+    for (uint i= 0; i < write_set_count; i++)
+      write_set[i]= uint4korr(start + offset + 1 + 4 * i);
+  }
 }
 
 
@@ -6399,7 +6415,8 @@ Gtid_log_event::Gtid_log_event(THD *thd_arg, uint64 seq_no_arg,
                                uint64 commit_id_arg)
   : Log_event(thd_arg, flags_arg, is_transactional),
     seq_no(seq_no_arg), commit_id(commit_id_arg), domain_id(domain_id_arg),
-    flags2((standalone ? FL_STANDALONE : 0) | (commit_id_arg ? FL_GROUP_COMMIT_ID : 0))
+    flags2((standalone ? FL_STANDALONE : 0) | (commit_id_arg ? FL_GROUP_COMMIT_ID : 0)),
+    write_set_count(0)
 {
   cache_type= Log_event::EVENT_NO_CACHE;
   if (thd_arg->transaction.stmt.trans_did_wait() ||
@@ -6414,6 +6431,15 @@ Gtid_log_event::Gtid_log_event(THD *thd_arg, uint64 seq_no_arg,
   /* Preserve any DDL or WAITED flag in the slave's binlog. */
   if (thd_arg->rgi_slave)
     flags2|= (thd_arg->rgi_slave->gtid_ev_flags2 & (FL_DDL|FL_WAITED));
+  if (thd_arg->variables.binlog_write_set && !(flags2 & FL_DDL) &&
+      thd_arg->transaction.write_set_count &&
+      !thd_arg->transaction.write_set_overflow)
+  {
+    flags2|= FL_WRITE_SET;
+    write_set_count= (uint8) thd_arg->transaction.write_set_count;
+    memcpy(write_set, thd_arg->transaction.write_set,
+           write_set_count * sizeof(write_set[0]));
+  }
 }
 
 
@@ -6456,7 +6482,7 @@ Gtid_log_event::peek(const char *event_start, size_t event_len,
 bool
 Gtid_log_event::write(IO_CACHE *file)
 {
-  uchar buf[GTID_HEADER_LEN+2];
+  uchar buf[GTID_HEADER_LEN+2+1+4*GTID_MAX_WRITE_SET];
   size_t write_len;
 
   int8store(buf, seq_no);
@@ -6472,6 +6498,12 @@ Gtid_log_event::write(IO_CACHE *file)
     bzero(buf+13, GTID_HEADER_LEN-13);
     write_len= GTID_HEADER_LEN;
   }
+  if (flags2 & FL_WRITE_SET)
+  {
+    buf[write_len++]= write_set_count;
+    for (uint i= 0; i < write_set_count; i++, write_len+= 4)
+      int4store(buf + write_len, write_set[i]);
+  }
   return write_header(file, write_len) ||
     wrapper_my_b_safe_write(file, buf, write_len) ||
     write_footer(file);
@@ -6503,6 +6535,18 @@ Gtid_log_event::make_compatible_event(String *packet, bool *need_dummy_event,
   }
 
   *need_dummy_event= true;
+  if (flags2 & FL_WRITE_SET)
+  {
+    /* Strip the write-set, the BEGIN event is made from the fixed part. */
+    ulong event_len= LOG_EVENT_HEADER_LEN + GTID_HEADER_LEN +
+      ((flags2 & FL_GROUP_COMMIT_ID) ? 2 : 0) +
+      (checksum_alg == BINLOG_CHECKSUM_ALG_CRC32 ? BINLOG_CHECKSUM_LEN : 0);
+    if (packet->length() - ev_offset < event_len)
+      return 1;
+    packet->length(ev_offset + event_len);
+    int4store((char *) packet->ptr() + ev_offset + EVENT_LEN_OFFSET,
+              event_len);
+  }
   return Query_log_event::begin_event(packet, ev_offset, checksum_alg);
 }
 
@@ -6641,6 +6685,8 @@ Gtid_log_event::print(FILE *file, PRINT_EVENT_INFO *print_event_info)
       my_b_write_string(&cache, " trans");
     if (flags2 & FL_WAITED)
       my_b_write_string(&cache, " waited");
+    if (flags2 & FL_WRITE_SET)
+      my_b_printf(&cache, " write_set=%u", (uint) write_set_count);
     my_b_printf(&cache, "\n");
 
     if (!print_event_info->allow_parallel_printed ||
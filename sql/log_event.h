@@ -3139,6 +3139,9 @@ class Binlog_checkpoint_log_event: public Log_event
         @@SESSION.replicate_allow_parallel value was true at commit).</td>
     <td>Bit 4 set indicates that this transaction encountered a row (or other)
         lock wait during execution.</td>
+    <td>Bit 5 set indicates that the event group contains DDL.</td>
+    <td>Bit 6 set indicates that the write-set of the event group follows
+        the post-header.</td>
   </tr>
 
   <tr>
@@ -3148,10 +3151,20 @@ class Binlog_checkpoint_log_event: public Log_event
         group commit). OR commit id, same for all GTIDs in the same group
         commit (see flags bit 1).</td>
   </tr>
+
+  <tr>
+    <td>write-set (see flags bit 6)</td>
+    <td>1 byte count n, followed by n 4 byte unsigned integers</td>
+    <td>Hashes of the unique keys of the rows changed by the event group.
+        Two event groups with no hash in common did not change the same
+        row, so they can be applied in parallel. Only present if flags
+        bit 6 is set.</td>
+  </tr>
   </table>
 
   The Body of Gtid_log_event is empty. The total event size is 19 bytes +
-  the normal 19 bytes common-header.
+  the normal 19 bytes common-header (plus the commit id and the write-set
+  when present).
 */
 
 class Gtid_log_event: public Log_event
@@ -3161,6 +3174,9 @@ class Gtid_log_event: public Log_event
   uint64 commit_id;
   uint32 domain_id;
   uchar flags2;
+  /* The write-set of the event group, valid if FL_WRITE_SET is set. */
+  uint8 write_set_count;
+  uint32 write_set[GTID_MAX_WRITE_SET];
 
   /* Flags2. */
 
@@ -3188,6 +3204,11 @@ class Gtid_log_event: public Log_event
   static const uchar FL_WAITED= 16;
   /* FL_DDL is set for event group containing DDL. */
   static const uchar FL_DDL= 32;
+  /*
+    FL_WRITE_SET is set when the hashes of all the unique keys of the rows
+    changed by the event group are logged (@@binlog_write_set).
+  */
+  static const uchar FL_WRITE_SET= 64;
 
 #ifdef MYSQL_SERVER
   Gtid_log_event(THD *thd_arg, uint64 seq_no, uint32 domain_id, bool standalone,
@@ -3207,7 +3228,8 @@ class Gtid_log_event: public Log_event
   Log_event_type get_type_code() { return GTID_EVENT; }
   int get_data_size()
   {
-    return GTID_HEADER_LEN + ((flags2 & FL_GROUP_COMMIT_ID) ? 2 : 0);
+    return GTID_HEADER_LEN + ((flags2 & FL_GROUP_COMMIT_ID) ? 2 : 0) +
+      ((flags2 & FL_WRITE_SET) ? 1 + 4 * write_set_count : 0);
   }
   bool is_valid() const { return seq_no != 0; }
 #ifdef MYSQL_SERVER
@@ -1861,3 +1861,130 @@ void get_sweep_read_cost(TABLE *table, ha_rows nrows, bool interrupted,
  ***************************************************************************/
 
 
+
+/****************************************************************************
+ * Rowid_filter implementation
+ ***************************************************************************/
+
+Rowid_filter::Rowid_filter(QUICK_RANGE_SELECT *quick_arg,
+                           ulonglong max_size_arg)
+  :quick(quick_arg), file(quick_arg->head->file), keyno(quick_arg->index),
+   max_size(max_size_arg), built(FALSE), usable(FALSE)
+{
+  my_init_dynamic_array(&rowids, file->ref_length,
+                        (uint) MY_MIN(quick->records + 1,
+                                      max_size / file->ref_length + 1),
+                        1024, MYF(MY_THREAD_SPECIFIC));
+}
+
+
+Rowid_filter::~Rowid_filter()
+{
+  delete quick;
+  delete_dynamic(&rowids);
+}
+
+
+static int rowid_cmp(void *file, uchar *a, uchar *b)
+{
+  return ((handler*)file)->cmp_ref(a, b);
+}
+
+
+/**
+  Collect and sort the rowids of the range with an index-only scan
+
+  @details
+  Must be called before the handler is initialized for the access that
+  the filter is pushed into.  If the range has more rows than fit in
+  max_size bytes, the filter stays unusable.
+
+  @retval 0      ok
+  @retval other  error code of the handler
+*/
+
+int Rowid_filter::build()
+{
+  TABLE *table= quick->head;
+  bool keyread= !table->key_read && !table->no_keyread;
+  uchar *prev= NULL;
+  int error;
+  DBUG_ENTER("Rowid_filter::build");
+  DBUG_ASSERT(!built && file->inited == handler::NONE);
+
+  built= TRUE;
+  usable= TRUE;
+  /* Only the rowids are needed, never the rows */
+  quick->mrr_flags|= HA_MRR_USE_DEFAULT_IMPL;
+  if (keyread)
+    table->enable_keyread();
+  if (!(error= quick->init()) && !(error= quick->reset()))
+  {
+    while (!(error= quick->get_next()))
+    {
+      file->position(table->record[0]);
+      if ((rowids.elements + 1) * (ulonglong) file->ref_length > max_size)
+      {
+        usable= FALSE;
+        break;
+      }
+      if (insert_dynamic(&rowids, file->ref))
+      {
+        error= HA_ERR_OUT_OF_MEM;
+        break;
+      }
+    }
+  }
+  quick->range_end();
+  if (keyread)
+    table->disable_keyread();
+  delete quick;
+  quick= NULL;
+
+  if (error == HA_ERR_END_OF_FILE)
+    error= 0;
+  if (error || !usable)
+  {
+    usable= FALSE;
+    delete_dynamic(&rowids);
+    DBUG_RETURN(error);
+  }
+
+  /* Sort the rowids and remove the duplicates of an index over a set */
+  my_qsort2(rowids.buffer, rowids.elements, rowids.size_of_element,
+            (qsort2_cmp) rowid_cmp, (void*) file);
+  uint unique= 0;
+  for (uint i= 0; i < rowids.elements; i++)
+  {
+    uchar *rowid= dynamic_array_ptr(&rowids, i);
+    if (prev && !file->cmp_ref(prev, rowid))
+      continue;
+    prev= dynamic_array_ptr(&rowids, unique++);
+    if (prev != rowid)
+      memcpy(prev, rowid, rowids.size_of_element);
+  }
+  rowids.elements= unique;
+  DBUG_PRINT("info", ("rowid filter with %u rows", unique));
+  DBUG_RETURN(0);
+}
+
+
+/** Check whether a rowid is in the filter, with a binary search */
+
+bool Rowid_filter::check(const uchar *rowid)
+{
+  uint lo= 0, hi= rowids.elements;
+  DBUG_ASSERT(built && usable);
+  while (lo < hi)
+  {
+    uint mid= (lo + hi) / 2;
+    int cmp= file->cmp_ref(dynamic_array_ptr(&rowids, mid), rowid);
+    if (!cmp)
+      return TRUE;
+    if (cmp < 0)
+      lo= mid + 1;
+    else
+      hi= mid;
+  }
+  return FALSE;
+}
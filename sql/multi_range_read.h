@@ -657,3 +657,41 @@ class DsMrr_impl
   @} (end of group DS-MRR declarations)
 */
 
+
+class QUICK_RANGE_SELECT;
+
+/**
+  A sorted set of the rowids of the rows that are in a range scan
+
+  @details
+  A table that is joined with ref access on one index may have a selective
+  range condition over another index.  The rowids of the rows in that range
+  are collected once with an index-only scan and sorted like the rowids of
+  DS-MRR.  The filter is then pushed into the handler with
+  handler::rowid_filter_push(), and the engine skips the index entries of
+  the ref access whose rows are not in the set, without reading the rows.
+*/
+
+class Rowid_filter : public Sql_alloc
+{
+  QUICK_RANGE_SELECT *quick;            /* The range, until build() */
+  handler *file;
+  uint keyno;                           /* Index of the range */
+  DYNAMIC_ARRAY rowids;
+  ulonglong max_size;                   /* Limit on the size of rowids */
+  bool built;
+  bool usable;                          /* FALSE if the set is too big */
+
+public:
+  Rowid_filter(QUICK_RANGE_SELECT *quick_arg, ulonglong max_size_arg);
+  ~Rowid_filter();
+
+  uint get_key() const { return keyno; }
+  bool is_built() const { return built; }
+  bool is_usable() const { return usable; }
+  /* Used when the engine does not accept the filter */
+  void set_not_usable() { built= TRUE; usable= FALSE; }
+  int build();
+  bool check(const uchar *rowid);
+};
+
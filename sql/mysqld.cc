@@ -510,6 +510,7 @@ ulonglong binlog_stmt_cache_size=0;
 ulonglong  max_binlog_stmt_cache_size=0;
 ulonglong query_cache_size=0;
 ulong query_cache_limit=0;
+uint query_cache_partitions= 1;
 ulong executed_events=0;
 query_id_t global_query_id;
 ulong aborted_threads, aborted_connects;
@@ -521,7 +522,7 @@ ulong binlog_cache_use= 0, binlog_cache_disk_use= 0;
 ulong binlog_stmt_cache_use= 0, binlog_stmt_cache_disk_use= 0;
 ulong max_connections, max_connect_errors;
 ulong extra_max_connections;
-ulong slave_retried_transactions;
+ulong slave_retried_transactions, slave_write_set_conflicts;
 ulonglong slave_skipped_errors;
 ulong feature_files_opened_with_delayed_keys;
 ulonglong denied_connections;
@@ -893,6 +894,7 @@ PSI_mutex_key key_LOCK_stats,
   key_LOCK_global_index_stats,
   key_LOCK_wakeup_ready, key_LOCK_wait_commit;
 PSI_mutex_key key_LOCK_gtid_waiting;
+PSI_mutex_key key_LOCK_filesort_workers;
 
 PSI_mutex_key key_LOCK_after_binlog_sync;
 PSI_mutex_key key_LOCK_prepare_ordered, key_LOCK_commit_ordered,
@@ -943,6 +945,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_LOCK_wakeup_ready, "THD::LOCK_wakeup_ready", 0},
   { &key_LOCK_wait_commit, "wait_for_commit::LOCK_wait_commit", 0},
   { &key_LOCK_gtid_waiting, "gtid_waiting::LOCK_gtid_waiting", 0},
+  { &key_LOCK_filesort_workers, "Filesort_workers::lock", 0},
   { &key_LOCK_thd_data, "THD::LOCK_thd_data", 0},
   { &key_LOCK_user_conn, "LOCK_user_conn", PSI_FLAG_GLOBAL},
   { &key_LOCK_uuid_short_generator, "LOCK_uuid_short_generator", PSI_FLAG_GLOBAL},
@@ -1019,6 +1022,7 @@ PSI_cond_key key_COND_rpl_thread_queue, key_COND_rpl_thread,
   key_COND_parallel_entry, key_COND_group_commit_orderer,
   key_COND_prepare_ordered, key_COND_slave_init;
 PSI_cond_key key_COND_wait_gtid, key_COND_gtid_ignore_duplicates;
+PSI_cond_key key_COND_filesort_work, key_COND_filesort_done;
 
 static PSI_cond_info all_server_conds[]=
 {
@@ -1067,6 +1071,8 @@ static PSI_cond_info all_server_conds[]=
   { &key_COND_group_commit_orderer, "COND_group_commit_orderer", 0},
   { &key_COND_prepare_ordered, "COND_prepare_ordered", 0},
   { &key_COND_slave_init, "COND_slave_init", 0},
+  { &key_COND_filesort_work, "Filesort_workers::cond_work", 0},
+  { &key_COND_filesort_done, "Filesort_workers::cond_done", 0},
   { &key_COND_wait_gtid, "COND_wait_gtid", 0},
   { &key_COND_gtid_ignore_duplicates, "COND_gtid_ignore_duplicates", 0}
 };
@@ -1074,7 +1080,7 @@ static PSI_cond_info all_server_conds[]=
 PSI_thread_key key_thread_bootstrap, key_thread_delayed_insert,
   key_thread_handle_manager, key_thread_main,
   key_thread_one_connection, key_thread_signal_hand,
-  key_thread_slave_init, key_rpl_parallel_thread;
+  key_thread_slave_init, key_rpl_parallel_thread, key_thread_filesort;
 
 static PSI_thread_info all_server_threads[]=
 {
@@ -1101,7 +1107,8 @@ static PSI_thread_info all_server_threads[]=
   { &key_thread_one_connection, "one_connection", 0},
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
   { &key_thread_slave_init, "slave_init", PSI_FLAG_GLOBAL},
-  { &key_rpl_parallel_thread, "rpl_parallel_thread", 0}
+  { &key_rpl_parallel_thread, "rpl_parallel_thread", 0},
+  { &key_thread_filesort, "filesort", 0}
 };
 
 #ifdef HAVE_MMAP
@@ -8146,6 +8153,33 @@ int show_threadpool_idle_threads(THD *thd, SHOW_VAR *var, char *buff,
 }
 #endif
 
+#ifdef HAVE_QUERY_CACHE
+static SHOW_VAR qcache_status_vars[]= {
+  {"free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
+  {"free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
+  {"hits",              (char*) &query_cache.hits,       SHOW_LONG},
+  {"inserts",           (char*) &query_cache.inserts,    SHOW_LONG},
+  {"lowmem_prunes",     (char*) &query_cache.lowmem_prunes, SHOW_LONG},
+  {"not_cached",        (char*) &query_cache.refused,    SHOW_LONG},
+  {"queries_in_cache",  (char*) &query_cache.queries_in_cache, SHOW_LONG_NOFLUSH},
+  {"total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
+  {NullS, NullS, SHOW_LONG}
+};
+
+/*
+  The query cache may be partitioned, in which case its statistics
+  have to be summed up over all partitions before they are shown.
+*/
+static int show_qcache_status(THD *thd, SHOW_VAR *var, char *buff,
+                              enum enum_var_type scope)
+{
+  query_cache.collect_statistics(thd);
+  var->type= SHOW_ARRAY;
+  var->value= (char*) &qcache_status_vars;
+  return 0;
+}
+#endif /*HAVE_QUERY_CACHE*/
+
 /*
   Variables shown by SHOW STATUS in alphabetical order
 */
@@ -8239,18 +8273,13 @@ SHOW_VAR status_vars[]= {
   {"Opened_tables",            (char*) offsetof(STATUS_VAR, opened_tables), SHOW_LONG_STATUS},
   {"Opened_views",             (char*) offsetof(STATUS_VAR, opened_views), SHOW_LONG_STATUS},
   {"Prepared_stmt_count",      (char*) &show_prepared_stmt_count, SHOW_SIMPLE_FUNC},
+  {"Prepared_stmt_plan_cache_hits", (char*) offsetof(STATUS_VAR, stmt_plan_cache_hits), SHOW_LONG_STATUS},
+  {"Prepared_stmt_plan_cache_misses", (char*) offsetof(STATUS_VAR, stmt_plan_cache_misses), SHOW_LONG_STATUS},
   {"Rows_sent",                (char*) offsetof(STATUS_VAR, rows_sent), SHOW_LONGLONG_STATUS},
   {"Rows_read",                (char*) offsetof(STATUS_VAR, rows_read), SHOW_LONGLONG_STATUS},
   {"Rows_tmp_read",            (char*) offsetof(STATUS_VAR, rows_tmp_read), SHOW_LONGLONG_STATUS},
 #ifdef HAVE_QUERY_CACHE
-  {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
-  {"Qcache_free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
-  {"Qcache_hits",              (char*) &query_cache.hits,       SHOW_LONG},
-  {"Qcache_inserts",           (char*) &query_cache.inserts,    SHOW_LONG},
-  {"Qcache_lowmem_prunes",     (char*) &query_cache.lowmem_prunes, SHOW_LONG},
-  {"Qcache_not_cached",        (char*) &query_cache.refused,    SHOW_LONG},
-  {"Qcache_queries_in_cache",  (char*) &query_cache.queries_in_cache, SHOW_LONG_NOFLUSH},
-  {"Qcache_total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
+  {"Qcache",                   (char*) &show_qcache_status,     SHOW_FUNC},
 #endif /*HAVE_QUERY_CACHE*/
   {"Queries",                  (char*) &show_queries,            SHOW_SIMPLE_FUNC},
   {"Questions",                (char*) offsetof(STATUS_VAR, questions), SHOW_LONG_STATUS},
@@ -8269,6 +8298,7 @@ SHOW_VAR status_vars[]= {
   {"Slave_retried_transactions",(char*)&slave_retried_transactions, SHOW_LONG},
   {"Slave_running",            (char*) &show_slave_running,     SHOW_SIMPLE_FUNC},
   {"Slave_skipped_errors",     (char*) &slave_skipped_errors, SHOW_LONGLONG},
+  {"Slave_write_set_conflicts",(char*) &slave_write_set_conflicts, SHOW_LONG},
 #endif
   {"Slow_launch_threads",      (char*) &slow_launch_threads,    SHOW_LONG},
   {"Slow_queries",             (char*) offsetof(STATUS_VAR, long_query_count), SHOW_LONG_STATUS},
@@ -8322,6 +8352,9 @@ SHOW_VAR status_vars[]= {
 #endif
 #ifdef HAVE_POOL_OF_THREADS
   {"Threadpool_idle_threads",  (char *) &show_threadpool_idle_threads, SHOW_SIMPLE_FUNC},
+#ifndef _WIN32
+  {"Threadpool_steals",        (char *) &show_threadpool_steals, SHOW_FUNC},
+#endif
   {"Threadpool_threads",       (char *) &tp_stats.num_worker_threads, SHOW_INT},
 #endif
   {"Threads_cached",           (char*) &cached_thread_count,    SHOW_LONG_NOFLUSH},
@@ -8568,6 +8601,7 @@ static int mysql_init_variables(void)
   report_user= report_password = report_host= 0;	/* TO BE DELETED */
   opt_relay_logname= opt_relaylog_index_name= 0;
   slave_retried_transactions= 0;
+  slave_write_set_conflicts= 0;
 
   /* Variables in libraries */
   charsets_dir= 0;
@@ -9739,6 +9773,10 @@ void refresh_status(THD *thd)
 
   /* Reset the counters of all key caches (default and named). */
   process_key_caches(reset_key_cache_counters, 0);
+#ifdef HAVE_QUERY_CACHE
+  /* Qcache_* are not reset by reset_status_vars(), see show_qcache_status() */
+  query_cache.reset_statistics();
+#endif
   flush_status_time= time((time_t*) 0);
   mysql_mutex_unlock(&LOCK_status);
 
@@ -11301,6 +11301,56 @@ QUICK_RANGE_SELECT *get_quick_select_for_ref(THD *thd, TABLE *table,
 }
 
 
+/*
+  Create quick select over the ranges of one index for a rowid filter
+
+  SYNOPSIS
+    get_quick_select_for_rowid_filter()
+      thd          Thread handle
+      table        Table to access
+      keyno        Index of the ranges
+      cond         Condition on the table
+      const_tables Tables whose values are known
+
+  NOTES
+    Only the parts of cond that use the columns of table and the constant
+    tables are turned into ranges, so every row that satisfies cond is
+    in the ranges.  The caller must not rely on the quick select to check
+    cond.
+
+  RETURN
+    Quick select over the ranges of keyno
+    NULL if there are no usable ranges over keyno, or on error
+*/
+
+QUICK_RANGE_SELECT *get_quick_select_for_rowid_filter(THD *thd, TABLE *table,
+                                                      uint keyno, COND *cond,
+                                                      table_map const_tables)
+{
+  SQL_SELECT *select;
+  QUICK_RANGE_SELECT *quick= NULL;
+  key_map keys;
+  int error;
+  DBUG_ENTER("get_quick_select_for_rowid_filter");
+
+  if (!(select= make_select(table, const_tables, const_tables, cond, 0,
+                            &error)))
+    DBUG_RETURN(NULL);
+  keys.clear_all();
+  keys.set_bit(keyno);
+  if (select->test_quick_select(thd, keys, const_tables, HA_POS_ERROR,
+                                TRUE, FALSE, FALSE) > 0 &&
+      select->quick && select->quick->index == keyno &&
+      select->quick->get_type() == QUICK_SELECT_I::QS_TYPE_RANGE)
+  {
+    quick= (QUICK_RANGE_SELECT*) select->quick;
+    select->quick= NULL;
+  }
+  delete select;
+  DBUG_RETURN(quick);
+}
+
+
 /*
   Perform key scans for all used indexes (except CPK), get rowids and merge 
   them into an ordered non-recurrent sequence of rowids.
@@ -1047,6 +1047,9 @@ FT_SELECT *get_ft_select(THD *thd, TABLE *table, uint key);
 QUICK_RANGE_SELECT *get_quick_select_for_ref(THD *thd, TABLE *table,
                                              struct st_table_ref *ref,
                                              ha_rows records);
+QUICK_RANGE_SELECT *get_quick_select_for_rowid_filter(THD *thd, TABLE *table,
+                                                      uint keyno, COND *cond,
+                                                      table_map const_tables);
 SQL_SELECT *make_select(TABLE *head, table_map const_tables,
 			table_map read_tables, COND *conds,
                         bool allow_null_cond,  int *error);
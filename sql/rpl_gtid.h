@@ -22,6 +22,12 @@
 
 /* Definitions for MariaDB global transaction ID (GTID). */
 
+/*
+  Max number of key hashes in the write-set of an event group, see
+  Gtid_log_event::FL_WRITE_SET. Transactions that change more rows are
+  logged without a write-set.
+*/
+#define GTID_MAX_WRITE_SET 64
 
 extern const LEX_STRING rpl_gtid_slave_state_table_name;
 
@@ -1612,6 +1612,77 @@ rpl_parallel_entry::choose_thread(rpl_group_info *rgi, bool *did_enter_cond,
   return thr;
 }
 
+
+/*
+  Check the write-set of a new event group against the write-sets of the
+  event groups queued before it that have not yet committed, and record it
+  for the event groups that follow.
+
+  Returns WRITE_SET_CONFLICT if the event group changes a row that one of
+  those event groups also changes, WRITE_SET_INDEPENDENT if it is known to
+  change no such row, and WRITE_SET_UNKNOWN if the write-set of the event
+  group or of one of those event groups is not known.
+
+  Note that the write-set only covers unique keys, so conflicts through
+  eg. foreign keys or gap locks are still handled by the normal rollback
+  and retry of optimistic parallel replication.
+*/
+rpl_parallel_entry::enum_write_set_check
+rpl_parallel_entry::check_write_set(Gtid_log_event *gtid_ev, uint64 sub_id)
+{
+  enum_write_set_check res;
+  uint64 committed;
+  uint32 i, j, idx;
+
+  if (!(gtid_ev->flags2 & Gtid_log_event::FL_WRITE_SET))
+  {
+    write_set_unknown_sub_id= sub_id;
+    return WRITE_SET_UNKNOWN;
+  }
+
+  mysql_mutex_lock(&LOCK_parallel_entry);
+  committed= last_committed_sub_id;
+  mysql_mutex_unlock(&LOCK_parallel_entry);
+
+  if (write_set_unknown_sub_id > committed)
+    res= WRITE_SET_UNKNOWN;
+  else
+  {
+    res= WRITE_SET_INDEPENDENT;
+    /*
+      Entries are recorded in sub_id order, so scan backwards only until the
+      first one that has committed.
+    */
+    idx= write_set_history_idx;
+    for (i= 0; i < WRITE_SET_HISTORY_SIZE && res == WRITE_SET_INDEPENDENT; ++i)
+    {
+      idx= (idx + WRITE_SET_HISTORY_SIZE - 1) % WRITE_SET_HISTORY_SIZE;
+      if (write_set_history[idx].sub_id <= committed)
+        break;
+      for (j= 0; j < gtid_ev->write_set_count; ++j)
+      {
+        if (write_set_history[idx].hash == gtid_ev->write_set[j])
+        {
+          res= WRITE_SET_CONFLICT;
+          break;
+        }
+      }
+    }
+  }
+
+  for (j= 0; j < gtid_ev->write_set_count; ++j)
+  {
+    write_set_entry *entry= &write_set_history[write_set_history_idx];
+    /* Overwriting the entry of an event group that is maybe still running. */
+    if (entry->sub_id > committed && entry->sub_id > write_set_unknown_sub_id)
+      write_set_unknown_sub_id= entry->sub_id;
+    entry->sub_id= sub_id;
+    entry->hash= gtid_ev->write_set[j];
+    write_set_history_idx= (write_set_history_idx + 1) % WRITE_SET_HISTORY_SIZE;
+  }
+  return res;
+}
+
 static void
 free_rpl_parallel_entry(void *element)
 {
@@ -1665,15 +1736,18 @@ rpl_parallel::find(uint32 domain_id)
     if (count == 0 || count > opt_slave_parallel_threads)
       count= opt_slave_parallel_threads;
     rpl_parallel_thread **p;
+    rpl_parallel_entry::write_set_entry *w;
     if (!my_multi_malloc(MYF(MY_WME|MY_ZEROFILL),
                          &e, sizeof(*e),
                          &p, count*sizeof(*p),
+                         &w, rpl_parallel_entry::WRITE_SET_HISTORY_SIZE*sizeof(*w),
                          NULL))
     {
       my_error(ER_OUTOFMEMORY, MYF(0), (int)(sizeof(*e)+count*sizeof(*p)));
       return NULL;
     }
     e->rpl_threads= p;
+    e->write_set_history= w;
     e->rpl_thread_max= count;
     e->domain_id= domain_id;
     e->stop_on_error_sub_id= (uint64)ULONGLONG_MAX;
@@ -2155,6 +2229,7 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     group_commit_orderer *gco;
     uint8 force_switch_flag;
     enum rpl_group_info::enum_speculation speculation;
+    rpl_parallel_entry::enum_write_set_check write_set_check;
 
     if (!(rgi= cur_thread->get_rgi(rli, gtid_ev, e, event_size)))
     {
@@ -2181,6 +2256,10 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     rgi->wait_commit_sub_id= e->current_sub_id;
     rgi->wait_commit_group_info= e->current_group_info;
 
+    write_set_check= rpl_parallel_entry::WRITE_SET_UNKNOWN;
+    if (mode >= SLAVE_PARALLEL_OPTIMISTIC)
+      write_set_check= e->check_write_set(gtid_ev, rgi->gtid_sub_id);
+
     speculation= rpl_group_info::SPECULATE_NO;
     new_gco= true;
     force_switch_flag= 0;
@@ -2222,7 +2301,8 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
         new_gco= false;
         if (!(gtid_flags & Gtid_log_event::FL_TRANSACTIONAL) ||
             ( (!(gtid_flags & Gtid_log_event::FL_ALLOW_PARALLEL) ||
-               (gtid_flags & Gtid_log_event::FL_WAITED)) &&
+               ((gtid_flags & Gtid_log_event::FL_WAITED) &&
+                write_set_check != rpl_parallel_entry::WRITE_SET_INDEPENDENT)) &&
               (mode < SLAVE_PARALLEL_AGGRESSIVE)))
         {
           /*
@@ -2238,6 +2318,16 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
           */
           speculation= rpl_group_info::SPECULATE_WAIT;
         }
+        else if (write_set_check == rpl_parallel_entry::WRITE_SET_CONFLICT)
+        {
+          /*
+            The write-sets show that this transaction changes a row that a
+            prior transaction also changes. Running it in parallel would only
+            lead to a rollback and retry, so wait for the prior commit.
+          */
+          speculation= rpl_group_info::SPECULATE_WAIT;
+          statistic_increment(slave_write_set_conflicts, LOCK_status);
+        }
         else
           speculation= rpl_group_info::SPECULATE_OPTIMISTIC;
       }
@@ -311,11 +311,35 @@ struct rpl_parallel_entry {
   uint64 count_committing_event_groups;
   /* The group_commit_orderer object for the events currently being queued. */
   group_commit_orderer *current_gco;
+  /*
+    Cyclic array of the write-set hashes (Gtid_log_event::FL_WRITE_SET) of
+    the last event groups queued, in sub_id order. Used in optimistic
+    parallel mode to find event groups that are known not to conflict with
+    the event groups still executing, and those that are known to conflict.
+    Only accessed by the SQL driver thread.
+  */
+  static const uint32 WRITE_SET_HISTORY_SIZE= 1024;
+  struct write_set_entry {
+    uint64 sub_id;
+    uint32 hash;
+  } *write_set_history;
+  uint32 write_set_history_idx;
+  /*
+    The sub_id of the last event group whose write-set is not (or no longer)
+    in write_set_history. Until it has committed, we can not know that a
+    following event group does not conflict with what runs before it.
+  */
+  uint64 write_set_unknown_sub_id;
+  enum enum_write_set_check {
+    WRITE_SET_UNKNOWN, WRITE_SET_INDEPENDENT, WRITE_SET_CONFLICT
+  };
 
   rpl_parallel_thread * choose_thread(rpl_group_info *rgi, bool *did_enter_cond,
                                       PSI_stage_info *old_stage, bool reuse);
   int queue_master_restart(rpl_group_info *rgi,
                            Format_description_log_event *fdev);
+  enum_write_set_check check_write_set(Gtid_log_event *gtid_ev,
+                                       uint64 sub_id);
 };
 struct rpl_parallel {
   HASH domain_hash;
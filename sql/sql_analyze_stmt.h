@@ -48,3 +48,32 @@ class Exec_time_tracker
   }
 };
 
+
+
+/*
+  A class for collecting how filesort used its helper threads
+*/
+class Filesort_tracker
+{
+  ulonglong parallel_sorts;
+  uint max_sort_threads;
+  uint max_merge_threads;
+public:
+  Filesort_tracker() :
+    parallel_sorts(0), max_sort_threads(0), max_merge_threads(0) {}
+
+  // interface for collecting data
+  void report_sort_threads(uint sort_threads, uint merge_threads)
+  {
+    if (sort_threads > 1)
+      parallel_sorts++;
+    set_if_bigger(max_sort_threads, sort_threads);
+    set_if_bigger(max_merge_threads, merge_threads);
+  }
+
+  // interface for getting the data
+  bool has_data() { return parallel_sorts != 0; }
+  ulonglong get_parallel_sorts() { return parallel_sorts; }
+  uint get_sort_threads() { return max_sort_threads; }
+  uint get_merge_threads() { return max_merge_threads; }
+};
@@ -1073,6 +1073,13 @@ Query_cache::insert(Query_cache_tls *query_cache_tls,
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
 
+  if (partitions)
+  {
+    query_cache_tls->partition->insert(query_cache_tls, packet, length,
+                                       pkt_nr);
+    DBUG_VOID_RETURN;
+  }
+
   DBUG_ASSERT(current_thd);
 
   QC_DEBUG_SYNC("wait_in_query_cache_insert");
@@ -1113,8 +1120,8 @@ Query_cache::insert(Query_cache_tls *query_cache_tls,
     header->result(result);
     DBUG_PRINT("qcache", ("free query 0x%lx", (ulong) query_block));
     // The following call will remove the lock on query_block
-    query_cache.free_query(query_block);
-    query_cache.refused++;
+    free_query(query_block);
+    refused++;
     // append_result_data no success => we need unlock
     unlock();
     DBUG_VOID_RETURN;
@@ -1139,6 +1146,12 @@ Query_cache::abort(Query_cache_tls *query_cache_tls)
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
 
+  if (partitions)
+  {
+    query_cache_tls->partition->abort(query_cache_tls);
+    DBUG_VOID_RETURN;
+  }
+
   if (try_lock(current_thd, Query_cache::WAIT))
     DBUG_VOID_RETURN;
 
@@ -1176,6 +1189,12 @@ void Query_cache::end_of_result(THD *thd)
   if (query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
 
+  if (partitions)
+  {
+    query_cache_tls->partition->end_of_result(thd);
+    DBUG_VOID_RETURN;
+  }
+
   /* Ensure that only complete results are cached. */
   DBUG_ASSERT(thd->get_stmt_da()->is_eof());
 
@@ -1225,9 +1244,9 @@ void Query_cache::end_of_result(THD *thd)
     }
     last_result_block= header->result()->prev;
     allign_size= ALIGN_SIZE(last_result_block->used);
-    len= MY_MAX(query_cache.min_allocation_unit, allign_size);
-    if (last_result_block->length >= query_cache.min_allocation_unit + len)
-      query_cache.split_block(last_result_block,len);
+    len= MY_MAX(min_allocation_unit, allign_size);
+    if (last_result_block->length >= min_allocation_unit + len)
+      split_block(last_result_block,len);
 
     header->found_rows(limit_found_rows);
     header->result()->type= Query_cache_block::RESULT;
@@ -1276,12 +1295,14 @@ Query_cache::Query_cache(ulong query_cache_limit_arg,
    queries_in_cache(0), hits(0), inserts(0), refused(0),
    total_blocks(0), lowmem_prunes(0),
    m_cache_status(OK),
+   partitions(0), partition_count(0),
    min_allocation_unit(ALIGN_SIZE(min_allocation_unit_arg)),
    min_result_data_size(ALIGN_SIZE(min_result_data_size_arg)),
    def_query_hash_size(ALIGN_SIZE(def_query_hash_size_arg)),
    def_table_hash_size(ALIGN_SIZE(def_table_hash_size_arg)),
    initialized(0)
 {
+  bzero(table_filter, sizeof(table_filter));
   ulong min_needed= (ALIGN_SIZE(sizeof(Query_cache_block)) +
 		     ALIGN_SIZE(sizeof(Query_cache_block_table)) +
 		     ALIGN_SIZE(sizeof(Query_cache_query)) + 3);
@@ -1307,6 +1328,18 @@ ulong Query_cache::resize(ulong query_cache_size_arg)
     DBUG_RETURN(0);
   }
 
+  if (partitions)
+  {
+    /* Memory is split evenly between the partitions */
+    ulong partition_size= query_cache_size_arg / partition_count;
+    new_query_cache_size= 0;
+    for (uint i= 0; i < partition_count; i++)
+      new_query_cache_size+= partitions[i].resize(partition_size);
+    query_cache_size= new_query_cache_size;
+    m_cache_status= new_query_cache_size ? OK : DISABLED;
+    DBUG_RETURN(new_query_cache_size);
+  }
+
   lock_and_suspend();
 
   /*
@@ -1360,12 +1393,22 @@ ulong Query_cache::resize(ulong query_cache_size_arg)
 ulong Query_cache::set_min_res_unit(ulong size)
 {
   DBUG_ASSERT(size % 8 == 0);
+  for (uint i= 0; i < partition_count; i++)
+    partitions[i].set_min_res_unit(size);
   if (size < min_allocation_unit)
     size= ALIGN_SIZE(min_allocation_unit);
   return (min_result_data_size= size);
 }
 
 
+void Query_cache::result_size_limit(ulong limit)
+{
+  query_cache_limit= limit;
+  for (uint i= 0; i < partition_count; i++)
+    partitions[i].result_size_limit(limit);
+}
+
+
 void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
 {
   TABLE_COUNTER_TYPE local_tables;
@@ -1387,6 +1430,13 @@ void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
     DBUG_PRINT("qcache", ("Query cache not ready"));
     DBUG_VOID_RETURN;
   }
+  if (partitions)
+  {
+    /* Same partition as used by send_result_to_client() for the lookup */
+    partition_for(thd, thd->query(), thd->query_length())->
+      store_query(thd, tables_used);
+    DBUG_VOID_RETURN;
+  }
   if (thd->lex->sql_command != SQLCOM_SELECT)
   {
     DBUG_PRINT("qcache", ("Ignoring not SELECT command"));
@@ -1558,6 +1608,7 @@ def_week_frmt: %lu, in_trans: %d, autocommit: %d",
 	inserts++;
 	queries_in_cache++;
 	thd->query_cache_tls.first_query_block= query_block;
+	thd->query_cache_tls.partition= this;
 	header->writer(&thd->query_cache_tls);
 	header->tables_type(tables_type);
 
@@ -1721,6 +1772,10 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
       thd->variables.query_cache_type == 0)
     goto err;
 
+  if (partitions)
+    DBUG_RETURN(partition_for(thd, org_sql, query_length)->
+                send_result_to_client(thd, org_sql, query_length));
+
   /*
     The following can only happen for prepared statements that was found
     during parsing or later that the query was not cacheable.
@@ -2306,6 +2361,13 @@ void Query_cache::invalidate(THD *thd, char *db)
 
   DBUG_ASSERT(ok_for_lower_case_names(db));
 
+  if (partitions)
+  {
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].invalidate(thd, db);
+    DBUG_VOID_RETURN;
+  }
+
   bool restart= FALSE;
   /*
     Lock the query cache and queue all invalidation attempts to avoid
@@ -2395,6 +2457,13 @@ void Query_cache::flush()
   if (is_disabled())
     DBUG_VOID_RETURN;
 
+  if (partitions)
+  {
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].flush();
+    DBUG_VOID_RETURN;
+  }
+
   QC_DEBUG_SYNC("wait_in_query_cache_flush1");
 
   lock_and_suspend();
@@ -2405,7 +2474,7 @@ void Query_cache::flush()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   unlock();
   DBUG_VOID_RETURN;
 }
@@ -2428,6 +2497,13 @@ void Query_cache::pack(THD *thd, ulong join_limit, uint iteration_limit)
   if (is_disabled())
     DBUG_VOID_RETURN;
 
+  if (partitions)
+  {
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].pack(thd, join_limit, iteration_limit);
+    DBUG_VOID_RETURN;
+  }
+
   /*
     If the entire qc is being invalidated we can bail out early
     instead of waiting for the lock.
@@ -2470,6 +2546,15 @@ void Query_cache::destroy()
     mysql_mutex_destroy(&structure_guard_mutex);
     initialized = 0;
     DBUG_ASSERT(m_requests_in_progress == 0);
+
+    if (partitions)
+    {
+      for (uint i= 0; i < partition_count; i++)
+        partitions[i].destroy();
+      delete [] partitions;
+      partitions= 0;
+      partition_count= 0;
+    }
   }
   DBUG_VOID_RETURN;
 }
@@ -2477,6 +2562,18 @@ void Query_cache::destroy()
 
 void Query_cache::disable_query_cache(THD *thd)
 {
+  if (partitions)
+  {
+    /*
+      Partitions free their memory once their last request completes;
+      the router stops handing out requests right away.
+    */
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].disable_query_cache(thd);
+    m_cache_status= DISABLED;
+    return;
+  }
+
   m_cache_status= DISABLE_REQUEST;
   /*
     If there is no requests in progress try to free buffer.
@@ -2488,13 +2585,152 @@ void Query_cache::disable_query_cache(THD *thd)
 }
 
 
+/*****************************************************************************
+  Partitioning
+*****************************************************************************/
+
+/**
+  Slot of a table key in the table filter.
+*/
+
+uint Query_cache::table_filter_slot(const uchar *key, uint32 key_length)
+{
+  ulong nr1= 1, nr2= 4;
+  my_charset_bin.coll->hash_sort(&my_charset_bin, key, key_length,
+                                 &nr1, &nr2);
+  return (uint) (nr1 % QUERY_CACHE_TABLE_FILTER_SIZE);
+}
+
+
+/**
+  Forget all registered tables.
+
+  @pre structure_guard_mutex is acquired or LOCKED is set, and there are
+       no tables in the cache.
+*/
+
+void Query_cache::clear_table_filter()
+{
+  for (uint i= 0; i < QUERY_CACHE_TABLE_FILTER_SIZE; i++)
+  {
+    if (table_filter[i])
+      my_atomic_store32(&table_filter[i], 0);
+  }
+}
+
+
+/**
+  Choose the partition for a query.
+
+  The raw query text and the current database are hashed. Both
+  send_result_to_client() and store_query() see the same text, so a
+  query is always looked up in the partition it was stored in.
+
+  @note With query_cache_strip_comments, queries that differ only in
+  comments may go to different partitions and thus do not share a
+  cached result.
+*/
+
+Query_cache *Query_cache::partition_for(THD *thd, const char *query,
+                                        size_t query_length)
+{
+  ulong nr1= 1, nr2= 4;
+  DBUG_ASSERT(partitions);
+  my_charset_bin.coll->hash_sort(&my_charset_bin, (const uchar*) query,
+                                 query_length, &nr1, &nr2);
+  if (thd->db_length)
+    my_charset_bin.coll->hash_sort(&my_charset_bin, (const uchar*) thd->db,
+                                   thd->db_length, &nr1, &nr2);
+  return &partitions[nr1 % partition_count];
+}
+
+
+bool Query_cache::partition_disable_in_progress()
+{
+  for (uint i= 0; i < partition_count; i++)
+  {
+    if (partitions[i].is_disable_in_progress())
+      return true;
+  }
+  return false;
+}
+
+
+/**
+  Sum up the statistics of all partitions into the router object,
+  whose members are shown by SHOW STATUS.
+
+  The counters of a partition are read under its lock. The router
+  members are written under the structure_guard_mutex of the router,
+  which serializes concurrent SHOW STATUS.
+*/
+
+void Query_cache::collect_statistics(THD *thd)
+{
+  if (!partitions)
+    return;
+
+  ulong mem= 0, queries= 0, hit= 0, ins= 0, ref= 0, blocks= 0, total= 0,
+        prunes= 0;
+  for (uint i= 0; i < partition_count; i++)
+  {
+    Query_cache *part= &partitions[i];
+    part->lock(thd);
+    mem+=    part->free_memory;
+    queries+= part->queries_in_cache;
+    hit+=    part->hits;
+    ins+=    part->inserts;
+    ref+=    part->refused;
+    blocks+= part->free_memory_blocks;
+    total+=  part->total_blocks;
+    prunes+= part->lowmem_prunes;
+    part->unlock();
+  }
+  mysql_mutex_lock(&structure_guard_mutex);
+  free_memory= mem;
+  queries_in_cache= queries;
+  hits= hit;
+  inserts= ins;
+  refused= ref;
+  free_memory_blocks= blocks;
+  total_blocks= total;
+  lowmem_prunes= prunes;
+  mysql_mutex_unlock(&structure_guard_mutex);
+}
+
+
+void Query_cache::reset_statistics()
+{
+  hits= inserts= refused= lowmem_prunes= 0;
+  for (uint i= 0; i < partition_count; i++)
+    partitions[i].reset_statistics();
+}
+
+
 /*****************************************************************************
   init/destroy
 *****************************************************************************/
 
-void Query_cache::init()
+void Query_cache::init(uint partitions_arg)
 {
   DBUG_ENTER("Query_cache::init");
+  if (partitions_arg > 1 &&
+      (partitions= new (std::nothrow) Query_cache[partitions_arg]))
+  {
+    partition_count= partitions_arg;
+    for (uint i= 0; i < partition_count; i++)
+    {
+      /*
+        Unlike the static query_cache object, the partitions are not
+        zero-filled, and resize() frees whatever the cache points to.
+      */
+      partitions[i].make_disabled();
+      my_hash_clear(&partitions[i].queries);
+      my_hash_clear(&partitions[i].tables);
+      partitions[i].set_min_res_unit(min_result_data_size);
+      partitions[i].init();
+    }
+  }
   mysql_mutex_init(key_structure_guard_mutex,
                    &structure_guard_mutex, MY_MUTEX_INIT_FAST);
   mysql_cond_init(key_COND_cache_status_changed,
@@ -2549,7 +2785,8 @@ ulong Query_cache::init_cache()
 
   DBUG_ENTER("Query_cache::init_cache");
 
-  approx_additional_data_size = (sizeof(Query_cache) +
+  /* The table filter is not allocated from the cache memory */
+  approx_additional_data_size = (sizeof(Query_cache) - sizeof(table_filter) +
 				 sizeof(uchar*)*(def_query_hash_size+
 					       def_table_hash_size));
   if (query_cache_size < approx_additional_data_size)
@@ -2764,6 +3001,7 @@ void Query_cache::free_cache()
   make_disabled();
   my_hash_free(&queries);
   my_hash_free(&tables);
+  clear_table_filter();
   DBUG_VOID_RETURN;
 }
 
@@ -2795,6 +3033,8 @@ void Query_cache::flush_cache()
     BLOCK_LOCK_WR(queries_blocks);
     free_query_internal(queries_blocks);
   }
+  /* All tables went away with the queries */
+  clear_table_filter();
 }
 
 /*
@@ -3231,6 +3471,18 @@ void Query_cache::invalidate_table(THD *thd, TABLE *table)
 
 void Query_cache::invalidate_table(THD *thd, uchar * key, uint32  key_length)
 {
+  if (partitions)
+  {
+    uint slot= table_filter_slot(key, key_length);
+    for (uint i= 0; i < partition_count; i++)
+    {
+      /* Skip partitions which never had a query using this table */
+      if (my_atomic_load32(&partitions[i].table_filter[slot]))
+        partitions[i].invalidate_table(thd, key, key_length);
+    }
+    return;
+  }
+
   DEBUG_SYNC(thd, "wait_in_query_cache_invalidate1");
 
   /*
@@ -3437,6 +3689,18 @@ Query_cache::insert_table(uint key_len, const char *key,
 
   THD *thd= current_thd;
 
+  /*
+    Count the table in the filter before it becomes visible in the hash,
+    so that a concurrent invalidation never skips this partition. The
+    count is taken back below unless a new table block is hashed.
+  */
+  int32 *filter_slot= NULL;
+  if (hash)
+  {
+    filter_slot= &table_filter[table_filter_slot((uchar*) key, key_len)];
+    my_atomic_add32(filter_slot, 1);
+  }
+
   Query_cache_block *table_block=
     (hash ?
      (Query_cache_block *) my_hash_search(&tables, (uchar*) key, key_len) :
@@ -3473,6 +3737,8 @@ Query_cache::insert_table(uint key_len, const char *key,
     if (table_block == 0)
     {
       DBUG_PRINT("qcache", ("Can't write table name to cache"));
+      if (filter_slot)
+        my_atomic_add32(filter_slot, -1);
       DBUG_RETURN(0);
     }
     Query_cache_table *header= table_block->table();
@@ -3496,6 +3762,7 @@ Query_cache::insert_table(uint key_len, const char *key,
       DBUG_PRINT("qcache", ("Can't insert table to hash"));
       // write_block_data return locked block
       free_memory_block(table_block);
+      my_atomic_add32(filter_slot, -1);
       DBUG_RETURN(0);
     }
     char *db= header->db();
@@ -3513,6 +3780,8 @@ Query_cache::insert_table(uint key_len, const char *key,
     */
     header->m_cached_query_count= 0;
   }
+  else if (filter_slot)
+    my_atomic_add32(filter_slot, -1);           // Already counted
 
   /*
     Table is now in the cache; link the table_block-node associated
@@ -3561,7 +3830,12 @@ void Query_cache::unlink_table(Query_cache_block_table *node)
                                &tables_blocks);
     Query_cache_table *header= table_block->table();
     if (header->is_hashed())
+    {
       my_hash_delete(&tables,(uchar *) table_block);
+      my_atomic_add32(&table_filter[table_filter_slot((uchar*) header->db(),
+                                                      header->key_length())],
+                      -1);
+    }
     free_memory_block(table_block);
   }
   DBUG_VOID_RETURN;
@@ -4792,6 +5066,13 @@ my_bool Query_cache::check_integrity(bool locked)
   uint i;
   DBUG_ENTER("check_integrity");
 
+  if (partitions)
+  {
+    for (i= 0; i < partition_count; i++)
+      result|= partitions[i].check_integrity(locked);
+    DBUG_RETURN(result);
+  }
+
   if (!locked)
     lock_and_suspend();
 
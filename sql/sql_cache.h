@@ -65,6 +65,13 @@ typedef struct st_changed_table_list CHANGED_TABLE_LIST;
 /* packing parameters */
 #define QUERY_CACHE_PACK_ITERATION		2
 #define QUERY_CACHE_PACK_LIMIT			(512*1024L)
+/* Maximum number of query cache partitions */
+#define QUERY_CACHE_MAX_PARTITIONS		64
+/*
+  Number of slots in the per-partition filter of cached table keys
+  (see Query_cache::table_filter)
+*/
+#define QUERY_CACHE_TABLE_FILTER_SIZE		1024
 
 #define TABLE_COUNTER_TYPE uint
 
@@ -311,6 +318,36 @@ class Query_cache
   void free_query_internal(Query_cache_block *point);
   void invalidate_table_internal(THD *thd, uchar *key, uint32 key_length);
 
+  /*
+    A partitioned query cache consists of a number of independent
+    Query_cache objects, each with its own memory, hashes and lock.
+    A query is stored in the partition chosen by hashing its text and
+    the current database, so lookups of different queries do not
+    contend on the same structure_guard_mutex.
+
+    The object that owns 'partitions' only routes calls, its own
+    memory and hashes stay unused.
+  */
+  Query_cache *partitions;
+  uint partition_count;
+
+  /*
+    Filter of the keys of the tables cached in this cache (partition).
+    A slot counts the hashed table blocks whose key falls into it, and
+    goes back to 0 when the queries using these tables are freed. A table
+    is invalidated only in partitions whose filter slot for the table key
+    is not 0, so writes to a table do not lock partitions that do not
+    cache a query using it. The slots are changed under the lock, and
+    read without it.
+  */
+  int32 table_filter[QUERY_CACHE_TABLE_FILTER_SIZE];
+
+  static uint table_filter_slot(const uchar *key, uint32 key_length);
+  void clear_table_filter();
+  Query_cache *partition_for(THD *thd, const char *query,
+                             size_t query_length);
+  bool partition_disable_in_progress();
+
 protected:
   /*
     The following mutex is locked when searching or changing global
@@ -445,14 +482,18 @@ class Query_cache
 
   inline bool is_disabled(void) { return m_cache_status != OK; }
   inline bool is_disable_in_progress(void)
-  { return m_cache_status == DISABLE_REQUEST; }
+  {
+    if (partitions)
+      return partition_disable_in_progress();
+    return m_cache_status == DISABLE_REQUEST;
+  }
 
-  /* initialize cache (mutex) */
-  void init();
+  /* initialize cache (mutex), create partitions if requested */
+  void init(uint partitions_arg= 1);
   /* resize query cache (return real query size, 0 if disabled) */
   ulong resize(ulong query_cache_size);
   /* set limit on result size */
-  inline void result_size_limit(ulong limit){query_cache_limit=limit;}
+  void result_size_limit(ulong limit);
   /* set minimal result data allocation unit size */
   ulong set_min_res_unit(ulong size);
 
@@ -531,6 +572,11 @@ class Query_cache
   void unlock(void);
 
   void disable_query_cache(THD *thd);
+
+  /* Sum up statistics of all partitions, for SHOW STATUS */
+  void collect_statistics(THD *thd);
+  /* Reset statistics counters, for FLUSH STATUS */
+  void reset_statistics();
 };
 
 #ifdef HAVE_QUERY_CACHE
@@ -563,7 +609,7 @@ struct Query_cache_query_flags
 #define query_cache_store_query(A, B) query_cache.store_query(A, B)
 #define query_cache_destroy() query_cache.destroy()
 #define query_cache_result_size_limit(A) query_cache.result_size_limit(A)
-#define query_cache_init() query_cache.init()
+#define query_cache_init() query_cache.init(query_cache_partitions)
 #define query_cache_resize(A) query_cache.resize(A)
 #define query_cache_set_min_res_unit(A) query_cache.set_min_res_unit(A)
 #define query_cache_invalidate3(A, B, C) query_cache.invalidate(A, B, C)
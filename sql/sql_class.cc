@@ -1009,6 +1009,8 @@ THD::THD(bool is_wsrep_applier)
   peer_port= 0;					// For SHOW PROCESSLIST
   transaction.m_pending_rows_event= 0;
   transaction.on= 1;
+  transaction.write_set_count= 0;
+  transaction.write_set_overflow= false;
   wt_thd_lazy_init(&transaction.wt, &variables.wt_deadlock_search_depth_short,
                                     &variables.wt_timeout_short,
                                     &variables.wt_deadlock_search_depth_long,
@@ -6129,6 +6131,83 @@ CPP_UNNAMED_NS_START
 
 CPP_UNNAMED_NS_END
 
+/**
+  Add the unique keys of a row to the write-set of the transaction.
+
+  A hash is computed for the value of every unique key of the row,
+  including the database and table name. The hash uses the collation of
+  the key parts, so equal keys get equal hashes. The slave uses the
+  write-sets to see if two event groups may change the same row.
+
+  If the row has no unique key without NULL values, a unique key has a
+  prefix or BLOB part, or there are too many keys, the write-set of the
+  transaction is marked as unknown.
+
+  @param table   Table of the row
+  @param record  Row image, either table->record[0] or table->record[1]
+*/
+
+void THD::binlog_add_write_set(TABLE *table, const uchar *record)
+{
+  my_ptrdiff_t ptr_diff= (my_ptrdiff_t) (record - table->record[0]);
+  bool found= false;
+  uint key;
+
+  if (transaction.write_set_overflow)
+    return;
+  for (key= 0; key < table->s->keys; key++)
+  {
+    KEY *key_info= table->key_info + key;
+    KEY_PART_INFO *key_part, *end;
+    uchar key_nr= (uchar) key;
+    ha_checksum hash;
+    uint i;
+
+    if (!(key_info->flags & HA_NOSAME))
+      continue;
+    hash= my_checksum(0, (uchar*) table->s->table_cache_key.str,
+                      table->s->table_cache_key.length);
+    hash= my_checksum(hash, &key_nr, 1);
+    end= key_info->key_part + key_info->user_defined_key_parts;
+    for (key_part= key_info->key_part; key_part < end; key_part++)
+    {
+      Field *field= key_part->field;
+      ulong nr= 1, nr2= 4;
+      uchar buf[16];
+      if (key_part->key_part_flag & (HA_PART_KEY_SEG | HA_BLOB_PART))
+        goto unknown;
+      if (field->is_real_null(ptr_diff))
+        break;
+      /*
+        Field::hash() is only good for short values, so mix the hash of
+        every key part into a checksum.
+      */
+      field->move_field_offset(ptr_diff);
+      field->hash(&nr, &nr2);
+      field->move_field_offset(-ptr_diff);
+      int8store(buf, (ulonglong) nr);
+      int8store(buf + 8, (ulonglong) nr2);
+      hash= my_checksum(hash, buf, sizeof(buf));
+    }
+    if (key_part < end)
+      continue;                         /* A NULL value is never a duplicate */
+    found= true;
+    for (i= 0; i < transaction.write_set_count; i++)
+      if (transaction.write_set[i] == hash)
+        break;
+    if (i < transaction.write_set_count)
+      continue;
+    if (transaction.write_set_count == GTID_MAX_WRITE_SET)
+      goto unknown;
+    transaction.write_set[transaction.write_set_count++]= hash;
+  }
+  if (found)
+    return;
+unknown:
+  transaction.write_set_overflow= true;
+}
+
+
 int THD::binlog_write_row(TABLE* table, bool is_trans, 
                           MY_BITMAP const* cols, size_t colcnt, 
                           uchar const *record) 
@@ -6136,6 +6215,8 @@ int THD::binlog_write_row(TABLE* table, bool is_trans,
 
   DBUG_ASSERT(is_current_stmt_binlog_format_row() &&
            ((WSREP(this) && wsrep_emulate_bin_log) || mysql_bin_log.is_open()));
+  if (variables.binlog_write_set)
+    binlog_add_write_set(table, record);
   /*
     Pack records into format for transfer. We are allocating more
     memory than needed, but that doesn't matter.
@@ -6170,6 +6251,11 @@ int THD::binlog_update_row(TABLE* table, bool is_trans,
 {
   DBUG_ASSERT(is_current_stmt_binlog_format_row() &&
             ((WSREP(this) && wsrep_emulate_bin_log) || mysql_bin_log.is_open()));
+  if (variables.binlog_write_set)
+  {
+    binlog_add_write_set(table, before_record);
+    binlog_add_write_set(table, after_record);
+  }
 
   size_t const before_maxlen = max_row_length(table, before_record);
   size_t const after_maxlen  = max_row_length(table, after_record);
@@ -6220,6 +6306,8 @@ int THD::binlog_delete_row(TABLE* table, bool is_trans,
 {
   DBUG_ASSERT(is_current_stmt_binlog_format_row() &&
             ((WSREP(this) && wsrep_emulate_bin_log) || mysql_bin_log.is_open()));
+  if (variables.binlog_write_set)
+    binlog_add_write_set(table, record);
 
   /* 
      Pack records into format for transfer. We are allocating more
@@ -6638,6 +6726,8 @@ int THD::binlog_query(THD::enum_binlog_query_type qtype, char const *query_arg,
       not enabled. This is possible because wsrep patch partially enables
       binary logging by setting wsrep_emulate_binlog.
     */
+    /* The rows changed by a statement logged as such are not known */
+    transaction.write_set_overflow= true;
     if (mysql_bin_log.is_open())
     {
       Query_log_event qinfo(this, query_arg, query_len, is_trans, direct,
@@ -387,6 +387,7 @@ class MY_LOCALE;
 */
 
 struct Query_cache_block;
+class Query_cache;
 
 struct Query_cache_tls
 {
@@ -395,12 +396,17 @@ struct Query_cache_tls
     functions and methods to maintain proper locking.
   */
   Query_cache_block *first_query_block;
+  /*
+    Query cache partition which first_query_block belongs to
+    (the query cache itself if it is not partitioned).
+  */
+  Query_cache *partition;
   void set_first_query_block(Query_cache_block *first_query_block_arg)
   {
     first_query_block= first_query_block_arg;
   }
 
-  Query_cache_tls() :first_query_block(NULL) {}
+  Query_cache_tls() :first_query_block(NULL), partition(NULL) {}
 };
 
 /* SIGNAL / RESIGNAL / GET DIAGNOSTICS */
@@ -524,6 +530,7 @@ typedef struct system_variables
   sql_mode_t old_behavior; ///< which old SQL behaviour should be enabled
   ulonglong option_bits; ///< OPTION_xxx constants, e.g. OPTION_PROFILING
   ulonglong join_buff_space_limit;
+  ulonglong max_rowid_filter_size;
   ulonglong log_slow_filter; 
   ulonglong log_slow_verbosity; 
   ulonglong bulk_insert_buff_size;
@@ -545,10 +552,12 @@ typedef struct system_variables
   ulong auto_increment_increment, auto_increment_offset;
   ulong lock_wait_timeout;
   ulong join_cache_level;
+  ulong join_cache_spill_partitions;
   ulong max_allowed_packet;
   ulong max_error_count;
   ulong max_length_for_sort_data;
   ulong max_sort_length;
+  ulong filesort_threads;
   ulong max_tmp_tables;
   ulong max_insert_delayed_threads;
   ulong min_examined_row_limit;
@@ -617,11 +626,14 @@ typedef struct system_variables
   my_bool old_alter_table;
   my_bool old_passwords;
   my_bool big_tables;
+  my_bool tmp_table_dynamic_rows;
+  my_bool prepared_stmt_plan_cache;
   my_bool query_cache_strip_comments;
   my_bool sql_log_slow;
   my_bool sql_log_bin;
   my_bool binlog_annotate_row_events;
   my_bool binlog_direct_non_trans_update;
+  my_bool binlog_write_set;
 
   plugin_ref table_plugin;
   plugin_ref tmp_table_plugin;
@@ -734,6 +746,9 @@ typedef struct system_status_var
   ulong com_stmt_fetch;
   ulong com_stmt_reset;
   ulong com_stmt_close;
+  /* Join orders of prepared statements reused or chosen anew */
+  ulong stmt_plan_cache_hits;
+  ulong stmt_plan_cache_misses;
 
   /* Features used */
   ulong feature_dynamic_columns;    /* +1 when creating a dynamic column */
@@ -2105,6 +2120,7 @@ class THD :public Statement,
   int binlog_update_row(TABLE* table, bool is_transactional,
                         MY_BITMAP const* cols, size_t colcnt,
                         const uchar *old_data, const uchar *new_data);
+  void binlog_add_write_set(TABLE *table, const uchar *record);
 
   void set_server_id(uint32 sid) { variables.server_id = sid; }
 
@@ -2235,11 +2251,22 @@ class THD :public Statement,
     */
     CHANGED_TABLE_LIST* changed_tables;
     MEM_ROOT mem_root; // Transaction-life memory allocation pool
+    /*
+      Hashes of the unique keys of the rows changed by the transaction,
+      logged in the GTID event when @@binlog_write_set is set. See
+      THD::binlog_add_write_set().
+    */
+    uint32 write_set[GTID_MAX_WRITE_SET];
+    uint write_set_count;
+    /* Set when the write-set of the transaction is not known */
+    bool write_set_overflow;
     void cleanup()
     {
       DBUG_ENTER("thd::cleanup");
       changed_tables= 0;
       savepoints= 0;
+      write_set_count= 0;
+      write_set_overflow= false;
       /*
         If rm_error is raised, it means that this piece of a distributed
         transaction has failed and must be rolled back. But the user must
@@ -4884,16 +4911,49 @@ class Unique :public Sql_alloc
 
   bool merge(TABLE *table, uchar *buff, bool without_last_merge);
 
+  /*
+    Open addressing hash set used instead of the tree when the elements
+    are compared as byte strings and need not be returned in order.
+    hash_codes[i] is 0 for an empty slot, otherwise it contains the high
+    bits of the hash value of the element stored in hash_keys at i*size.
+  */
+  bool hashed;
+  uint32 *hash_codes;
+  uchar *hash_keys;
+  ulong hash_capacity;
+  ulong hash_max_capacity;
+  ulong hash_count;
+  /* Files with the flushed elements, partitioned by hash value */
+  IO_CACHE *hash_files;
+  /* Buffer for an element read from hash_files */
+  uchar *hash_read_buff;
+
+  bool hash_add(uchar *key);
+  int hash_insert(uchar *key, ulonglong nr, bool no_limit);
+  bool hash_resize(ulong capacity);
+  void hash_clear();
+  bool hash_flush();
+  bool hash_write(IO_CACHE *files, uchar *key, ulonglong nr, uint level);
+  int hash_walk_set(tree_walk_action action, void *walk_action_arg);
+  int hash_walk_file(IO_CACHE *file, uint level,
+                     tree_walk_action action, void *walk_action_arg);
+  int hash_split_file(IO_CACHE *file, uint level,
+                      tree_walk_action action, void *walk_action_arg);
+  void hash_close_files(IO_CACHE *files);
+
 public:
   ulong elements;
   Unique(qsort_cmp2 comp_func, void *comp_func_fixed_arg,
 	 uint size_arg, ulonglong max_in_memory_size_arg,
-         uint min_dupl_count_arg= 0);
+         uint min_dupl_count_arg= 0, bool hashed_arg= FALSE);
   ~Unique();
-  ulong elements_in_tree() { return tree.elements_in_tree; }
+  ulong elements_in_tree()
+  { return hashed ? hash_count : tree.elements_in_tree; }
   inline bool unique_add(void *ptr)
   {
     DBUG_ENTER("unique_add");
+    if (hashed)
+      DBUG_RETURN(hash_add((uchar*) ptr));
     DBUG_PRINT("info", ("tree %u - %lu", tree.elements_in_tree, max_elements));
     if (!(tree.flag & TREE_ONLY_DUPS) && 
         tree.elements_in_tree >= max_elements && flush())
@@ -4901,7 +4961,7 @@ class Unique :public Sql_alloc
     DBUG_RETURN(!tree_insert(&tree, ptr, 0, tree.custom_arg));
   }
 
-  bool is_in_memory() { return (my_b_tell(&file) == 0); }
+  bool is_in_memory() { return hashed ? !elements : my_b_tell(&file) == 0; }
   void close_for_expansion() { tree.flag= TREE_ONLY_DUPS; }
 
   bool get(TABLE *table);
@@ -74,6 +74,7 @@
 
 #define MAX_SORT_MEMORY 2048*1024
 #define MIN_SORT_MEMORY 1024
+#define MAX_FILESORT_THREADS 64   /* Max value of filesort_threads */
 
 /* Some portable defines */
 
@@ -979,3 +979,320 @@ bool mysql_derived_reinit(THD *thd, LEX *lex, TABLE_LIST *derived)
   unit->set_thd(thd);
   DBUG_RETURN(FALSE);
 }
+
+
+/**
+  Check whether a column of a materialized derived table/view can be
+  referenced by a condition pushed into one of its SELECTs.
+
+  @param sl               SELECT of the derived table
+  @param field            column of the derived table
+  @param[out] into_where  set to FALSE if the column can be referenced
+                          only in the HAVING clause of 'sl'
+
+  @return TRUE   the column can be referenced
+  @return FALSE  otherwise
+*/
+
+static bool derived_column_pushable(SELECT_LEX *sl, Field *field,
+                                    bool *into_where)
+{
+  JOIN *join= sl->join;
+  Item *item= join->ref_pointer_array[field->field_index];
+
+  /*
+    The condition compares the column of 'sl' instead of the column of the
+    derived table, so both must have the same type.
+  */
+  if (item->with_subselect || item->is_expensive() ||
+      (item->used_tables() & RAND_TABLE_BIT) ||
+      item->field_type() != field->type() ||
+      (item->result_type() == STRING_RESULT &&
+       item->collation.collation != field->charset()))
+    return FALSE;
+
+  if (item->real_item()->type() == Item::FIELD_ITEM && !item->with_sum_func)
+  {
+    if (!join->group_list)
+      return TRUE;
+    for (ORDER *ord= join->group_list; ord; ord= ord->next)
+    {
+      if ((*ord->item)->real_item()->eq(item->real_item(), FALSE))
+        return TRUE;
+    }
+  }
+  /* Aggregates and columns that are not grouped on can be used in HAVING */
+  *into_where= FALSE;
+  return join->group_list != NULL;
+}
+
+
+/**
+  Check whether a condition can be pushed into a SELECT of a materialized
+  derived table/view.
+
+  @details
+  The condition may consist of comparisons, BETWEEN, IN, IS [NOT] NULL,
+  NOT, AND and OR over constants and columns of the derived table.
+
+  @param cond             condition of the embedding SELECT
+  @param derived          the derived table/view
+  @param sl               SELECT of the derived table
+  @param[out] into_where  set to FALSE if the condition can be pushed
+                          only into the HAVING clause of 'sl'
+
+  @return TRUE   the condition can be pushed
+  @return FALSE  otherwise
+*/
+
+static bool derived_cond_pushable(Item *cond, TABLE_LIST *derived,
+                                  SELECT_LEX *sl, bool *into_where)
+{
+  Item *item= cond->real_item();
+
+  if (item->basic_const_item())
+    return TRUE;
+  if (item->type() == Item::FIELD_ITEM)
+  {
+    Field *field= ((Item_field*) item)->field;
+    return field && field->table == derived->table &&
+           derived_column_pushable(sl, field, into_where);
+  }
+  if ((item->type() != Item::FUNC_ITEM && item->type() != Item::COND_ITEM) ||
+      item->with_subselect)
+    return FALSE;
+
+  switch (((Item_func*) item)->functype()) {
+  case Item_func::COND_AND_FUNC:
+  case Item_func::COND_OR_FUNC:
+  {
+    List_iterator_fast<Item> li(*((Item_cond*) item)->argument_list());
+    Item *arg;
+    while ((arg= li++))
+    {
+      if (!derived_cond_pushable(arg, derived, sl, into_where))
+        return FALSE;
+    }
+    return TRUE;
+  }
+  case Item_func::EQ_FUNC:
+  case Item_func::EQUAL_FUNC:
+  case Item_func::NE_FUNC:
+  case Item_func::LT_FUNC:
+  case Item_func::LE_FUNC:
+  case Item_func::GE_FUNC:
+  case Item_func::GT_FUNC:
+  case Item_func::BETWEEN:
+  case Item_func::IN_FUNC:
+  case Item_func::ISNULL_FUNC:
+  case Item_func::ISNOTNULL_FUNC:
+  case Item_func::NOT_FUNC:
+  {
+    Item_func *func= (Item_func*) item;
+    for (uint i= 0; i < func->argument_count(); i++)
+    {
+      if (!derived_cond_pushable(func->arguments()[i], derived, sl,
+                                 into_where))
+        return FALSE;
+    }
+    return TRUE;
+  }
+  default:
+    return FALSE;
+  }
+}
+
+
+/**
+  Build a copy of a condition accepted by derived_cond_pushable() for
+  a SELECT of a materialized derived table/view.
+
+  @details
+  Columns of the derived table are replaced by the columns of the
+  underlying table in WHERE, and by references to the select list of 'sl'
+  in HAVING. Constants are copied.
+
+  @return the copy, not fixed, or NULL if the copy could not be built
+*/
+
+static Item *derived_cond_clone(THD *thd, Item *cond, SELECT_LEX *sl,
+                                bool into_where)
+{
+  Item *item= cond->real_item();
+
+  if (item->basic_const_item())
+    return item->clone_item();
+  if (item->type() == Item::FIELD_ITEM)
+  {
+    Item **ref= sl->join->ref_pointer_array +
+                ((Item_field*) item)->field->field_index;
+    if (into_where)
+      return new Item_field(thd, (Item_field*) (*ref)->real_item());
+    return new Item_ref(&sl->context, ref, NullS, (*ref)->name);
+  }
+  if (item->type() == Item::COND_ITEM)
+  {
+    List<Item> list;
+    List_iterator_fast<Item> li(*((Item_cond*) item)->argument_list());
+    Item *arg;
+    while ((arg= li++))
+    {
+      Item *copy= derived_cond_clone(thd, arg, sl, into_where);
+      if (!copy || list.push_back(copy))
+        return NULL;
+    }
+    if (((Item_cond*) item)->functype() == Item_func::COND_AND_FUNC)
+      return new Item_cond_and(list);
+    return new Item_cond_or(list);
+  }
+
+  Item_func *func= (Item_func*) item;
+  List<Item> args;
+  for (uint i= 0; i < func->argument_count(); i++)
+  {
+    Item *copy= derived_cond_clone(thd, func->arguments()[i], sl, into_where);
+    if (!copy || args.push_back(copy))
+      return NULL;
+  }
+  List_iterator_fast<Item> ai(args);
+  Item *a= ai++;
+  Item *b= ai++;
+  Item *c= ai++;
+
+  switch (func->functype()) {
+  case Item_func::EQ_FUNC:
+    return new Item_func_eq(a, b);
+  case Item_func::EQUAL_FUNC:
+    return new Item_func_equal(a, b);
+  case Item_func::NE_FUNC:
+    return new Item_func_ne(a, b);
+  case Item_func::LT_FUNC:
+    return new Item_func_lt(a, b);
+  case Item_func::LE_FUNC:
+    return new Item_func_le(a, b);
+  case Item_func::GE_FUNC:
+    return new Item_func_ge(a, b);
+  case Item_func::GT_FUNC:
+    return new Item_func_gt(a, b);
+  case Item_func::ISNULL_FUNC:
+    return new Item_func_isnull(a);
+  case Item_func::ISNOTNULL_FUNC:
+    return new Item_func_isnotnull(a);
+  case Item_func::NOT_FUNC:
+    return new Item_func_not(a);
+  case Item_func::BETWEEN:
+  {
+    Item_func_between *between= new Item_func_between(a, b, c);
+    if (between)
+      between->negated= ((Item_func_between*) func)->negated;
+    return between;
+  }
+  case Item_func::IN_FUNC:
+  {
+    Item_func_in *in= new Item_func_in(args);
+    if (in)
+      in->negated= ((Item_func_in*) func)->negated;
+    return in;
+  }
+  default:
+    DBUG_ASSERT(0);
+    return NULL;
+  }
+}
+
+
+/**
+  Push conditions of the embedding SELECT into a materialized derived
+  table/view.
+
+  @param thd      thread handle
+  @param cond     condition of the embedding SELECT, may be NULL
+  @param derived  the derived table/view
+
+  @details
+  Every top-level conjunct of 'cond' that depends only on the columns of
+  'derived' is copied into the SELECTs of the derived table for which
+  filtering the rows before the materialization does not change the rows
+  the conjunct accepts: SELECTs without LIMIT, ROLLUP or aggregation
+  without GROUP BY. The copy goes into WHERE if every column it uses is
+  a column of an underlying table that is grouped on (or the SELECT is
+  not grouped), and into HAVING of a grouped SELECT otherwise.
+  The conjunct itself stays in 'cond'.
+
+  The copies are kept in st_select_lex::cond_pushed_into_where and
+  st_select_lex::cond_pushed_into_having until JOIN::optimize() of the
+  SELECT adds them to its conditions.
+
+  @return FALSE  OK
+  @return TRUE   Error
+*/
+
+bool pushdown_cond_for_derived(THD *thd, Item *cond, TABLE_LIST *derived)
+{
+  SELECT_LEX_UNIT *unit= derived->get_unit();
+  SELECT_LEX *save_current_select= thd->lex->current_select;
+  List<Item> single_conjunct;
+  List<Item> *conjuncts= &single_conjunct;
+  bool res= FALSE;
+  DBUG_ENTER("pushdown_cond_for_derived");
+
+  if (!cond || !derived->table || !unit || unit->optimized ||
+      !derived->is_materialized_derived())
+    DBUG_RETURN(FALSE);
+
+  /* A condition on an inner table of an outer join does not filter it */
+  for (TABLE_LIST *tbl= derived; tbl; tbl= tbl->embedding)
+  {
+    if (tbl->outer_join)
+      DBUG_RETURN(FALSE);
+  }
+  if (unit->is_union() && unit->global_parameters()->explicit_limit)
+    DBUG_RETURN(FALSE);
+
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond*) cond)->functype() == Item_func::COND_AND_FUNC)
+    conjuncts= ((Item_cond*) cond)->argument_list();
+  else if (single_conjunct.push_back(cond))
+    DBUG_RETURN(TRUE);
+
+  for (SELECT_LEX *sl= unit->first_select(); sl; sl= sl->next_select())
+  {
+    JOIN *join= sl->join;
+    if (!join || sl->explicit_limit || sl->olap != UNSPECIFIED_OLAP_TYPE ||
+        (sl->with_sum_func && !join->group_list))
+      continue;
+
+    thd->lex->current_select= sl;
+    List_iterator_fast<Item> li(*conjuncts);
+    Item *item;
+    while ((item= li++))
+    {
+      bool into_where= TRUE;
+      Item *copy;
+
+      if (item->const_item() || item->is_expensive() ||
+          !derived_cond_pushable(item, derived, sl, &into_where))
+        continue;
+      if (!(copy= derived_cond_clone(thd, item, sl, into_where)))
+      {
+        if ((res= thd->is_error()))
+          goto end;
+        continue;
+      }
+      if ((res= copy->fix_fields(thd, &copy)))
+        goto end;
+
+      Item **pushed= (into_where ? &sl->cond_pushed_into_where :
+                                   &sl->cond_pushed_into_having);
+      if (!(*pushed= and_items(*pushed, copy)))
+      {
+        res= TRUE;
+        goto end;
+      }
+    }
+  }
+
+end:
+  thd->lex->current_select= save_current_select;
+  DBUG_RETURN(res);
+}
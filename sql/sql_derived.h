@@ -18,12 +18,14 @@
 
 struct TABLE_LIST;
 class THD;
+class Item;
 struct LEX;
 
 bool mysql_handle_derived(LEX *lex, uint phases);
 bool mysql_handle_single_derived(LEX *lex, TABLE_LIST *derived, uint phases);
 bool mysql_handle_list_of_derived(LEX *lex, TABLE_LIST *dt_list, uint phases);
 bool mysql_derived_reinit(THD *thd, LEX *lex, TABLE_LIST *derived);
+bool pushdown_cond_for_derived(THD *thd, Item *cond, TABLE_LIST *derived);
 
 /**
    Cleans up the SELECT_LEX_UNIT for the derived table (if any).
@@ -756,6 +756,17 @@ void Explain_select::print_explain_json(Explain_query *query,
       writer->add_member("r_loops").add_ll(time_tracker.get_loops());
       writer->add_member("r_total_time_ms").add_double(time_tracker.get_time_ms());
     }
+    if (is_analyze && filesort_tracker.has_data())
+    {
+      writer->add_member("r_filesort_threads").start_object();
+      writer->add_member("r_parallel_sorts").
+        add_ll(filesort_tracker.get_parallel_sorts());
+      writer->add_member("r_sort_threads").
+        add_ll(filesort_tracker.get_sort_threads());
+      writer->add_member("r_merge_threads").
+        add_ll(filesort_tracker.get_merge_threads());
+      writer->end_object();
+    }
     if (exec_const_cond)
     {
       writer->add_member("const_condition");
@@ -1201,6 +1212,11 @@ void Explain_table_access::tag_to_json(Json_writer *writer, enum explain_extra_t
     case ET_USING_MRR:
       writer->add_member("mrr_type").add_str(mrr_type.c_ptr());
       break;
+    case ET_USING_ROWID_FILTER:
+      writer->add_member("rowid_filter").start_object();
+      writer->add_member("key").add_str(rowid_filter_key.c_ptr());
+      writer->end_object();
+      break;
     default:
       DBUG_ASSERT(0);
   }
@@ -1451,7 +1467,9 @@ const char * extra_tag_text[]=
 
   "const row not found",
   "unique row not found",
-  "Impossible ON condition"
+  "Impossible ON condition",
+
+  "Using rowid filter" // special handling
 };
 
 
@@ -1515,6 +1533,14 @@ void Explain_table_access::append_tag_name(String *str, enum explain_extra_tag t
         str->append(" (scanning)");
       break;
     }
+    case ET_USING_ROWID_FILTER:
+    {
+      str->append(extra_tag_text[tag]);
+      str->append(" (");
+      str->append(rowid_filter_key);
+      str->append(")");
+      break;
+    }
     default:
      str->append(extra_tag_text[tag]);
   }
@@ -161,7 +161,7 @@ class Explain_node : public Sql_alloc
 {
 public:
   Explain_node(MEM_ROOT *root)
-    :children(root)
+    :connection_type(EXPLAIN_NODE_OTHER), children(root)
   {}
   /* A type specifying what kind of node this is */
   enum explain_node_type 
@@ -304,6 +304,7 @@ class Explain_select : public Explain_basic_join
 
   /* ANALYZE members */
   Exec_time_tracker time_tracker;
+  Filesort_tracker filesort_tracker;
   
   int print_explain(Explain_query *query, select_result_sink *output, 
                     uint8 explain_flags, bool is_analyze);
@@ -525,6 +526,8 @@ enum explain_extra_tag
   ET_UNIQUE_ROW_NOT_FOUND,
   ET_IMPOSSIBLE_ON_CONDITION,
 
+  ET_USING_ROWID_FILTER,
+
   ET_total
 };
 
@@ -679,6 +682,8 @@ class Explain_table_access : public Sql_alloc
   // valid with ET_USING_MRR
   StringBuffer<32> mrr_type;
   StringBuffer<32> firstmatch_table_name;
+  // valid with ET_USING_ROWID_FILTER
+  StringBuffer<32> rowid_filter_key;
 
   /* 
     Non-zero number means this is a derived table. The number can be used to
@@ -0,0 +1,384 @@
+/*
+   Copyright (c) 2015, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <my_global.h>
+#include "sql_priv.h"
+#include "sql_select.h"
+#include "sql_hash_agg.h"
+
+/* Initial number of slots of a partition */
+#define HASH_AGG_MIN_SLOTS 32
+/* Block size of the MEM_ROOT of a partition */
+#define HASH_AGG_BLOCK_SIZE 8192
+
+
+/**
+  Prepare the hash table for an execution of the join
+
+  @param table_arg  grouping temporary table, which has a key over the
+                    GROUP BY list and no blobs
+  @param param_arg  parameters of the temporary table
+
+  @details
+  The memory limit is the one of an in-memory temporary table.
+
+  @retval FALSE  ok
+  @retval TRUE   error (cannot happen now)
+*/
+
+bool Hash_aggregation::init(TABLE *table_arg, TMP_TABLE_PARAM *param_arg)
+{
+  THD *thd= table_arg->in_use;
+  DBUG_ENTER("Hash_aggregation::init");
+  DBUG_ASSERT(!inited);
+  DBUG_ASSERT(table_arg->group && table_arg->s->keys &&
+              !table_arg->s->blob_fields);
+
+  table= table_arg;
+  param= param_arg;
+  key_length= ALIGN_SIZE(param->group_length);
+  rec_length= table->s->reclength;
+  max_memory= (size_t) MY_MIN(thd->variables.tmp_table_size,
+                              thd->variables.max_heap_table_size);
+  memory= 0;
+  groups= 0;
+  free_slot= NULL;
+
+  for (Partition *p= part; p < part + HASH_AGG_PARTITIONS; p++)
+  {
+    init_alloc_root(&p->root, HASH_AGG_BLOCK_SIZE, 0,
+                    MYF(MY_THREAD_SPECIFIC));
+    p->slots= NULL;
+    p->size= 0;
+    p->records= 0;
+    p->first= NULL;
+    p->last= &p->first;
+    p->memory= 0;
+    p->spilled= FALSE;
+  }
+  inited= TRUE;
+  DBUG_RETURN(FALSE);
+}
+
+
+void Hash_aggregation::free_partition(Partition *p)
+{
+  free_root(&p->root, MYF(0));
+  my_free(p->slots);
+  p->slots= NULL;
+  p->size= 0;
+  p->records= 0;
+  p->first= NULL;
+  p->last= &p->first;
+  memory-= p->memory;
+  p->memory= 0;
+}
+
+
+/** Free the memory of all partitions; may be called more than once */
+
+void Hash_aggregation::cleanup()
+{
+  if (!inited)
+    return;
+  for (Partition *p= part; p < part + HASH_AGG_PARTITIONS; p++)
+    free_partition(p);
+  inited= FALSE;
+}
+
+
+/**
+  Calculate the hash value of the group key in TMP_TABLE_PARAM::group_buff
+
+  @note
+  The values are hashed as by the collations of the key fields, so that
+  keys that compare as equal have the same hash value.
+*/
+
+ulong Hash_aggregation::hash_key()
+{
+  ulong nr= 1, nr2= 4;
+  KEY_PART_INFO *key_part= table->key_info->key_part;
+  for (ORDER *group= table->group; group; group= group->next, key_part++)
+  {
+    if (key_part->null_bit && group->buff[-1])
+      nr^= (nr << 1) | 1;
+    else
+      group->field->hash(&nr, &nr2);
+  }
+  return nr;
+}
+
+
+/**
+  Check whether a stored group key differs from the one in
+  TMP_TABLE_PARAM::group_buff
+*/
+
+bool Hash_aggregation::keys_differ(const uchar *key)
+{
+  KEY_PART_INFO *key_part= table->key_info->key_part;
+  for (ORDER *group= table->group; group; group= group->next, key_part++)
+  {
+    uchar *ptr= (uchar*) group->buff;
+    size_t offset= ptr - param->group_buff;
+    if (key_part->null_bit)
+    {
+      if (key[offset - 1] != ptr[-1])
+        return TRUE;
+      if (ptr[-1])
+        continue;                               /* Both are NULL */
+    }
+    if (group->field->cmp(key + offset, ptr))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+/**
+  Look up the group of the key in TMP_TABLE_PARAM::group_buff
+
+  @param hash  hash_key() of the key, whose partition is not spilled
+
+  @return the row of the group, or NULL if there is no such group
+*/
+
+uchar *Hash_aggregation::find(ulong hash)
+{
+  Partition *p= partition(hash);
+  DBUG_ASSERT(!p->spilled);
+
+  free_slot= NULL;
+  if (!p->slots)
+    return NULL;
+
+  uint mask= p->size - 1;
+  for (uint i= first_slot(p, hash); ; i= (i + 1) & mask)
+  {
+    Slot *slot= p->slots + i;
+    if (!slot->entry)
+    {
+      free_slot= slot;
+      return NULL;
+    }
+    if (slot->hash == hash && !keys_differ(entry_key(slot->entry)))
+      return entry_rec(slot->entry);
+  }
+}
+
+
+/** Double the number of slots of a partition */
+
+bool Hash_aggregation::grow(Partition *p)
+{
+  uint new_size= p->size ? p->size * 2 : HASH_AGG_MIN_SLOTS;
+  Slot *slots;
+  if (!(slots= (Slot*) my_malloc(new_size * sizeof(Slot),
+                                 MYF(MY_WME | MY_ZEROFILL |
+                                     MY_THREAD_SPECIFIC))))
+    return TRUE;
+
+  uint mask= new_size - 1;
+  for (Slot *slot= p->slots; slot < p->slots + p->size; slot++)
+  {
+    if (!slot->entry)
+      continue;
+    uint i= (uint) (slot->hash / HASH_AGG_PARTITIONS) & mask;
+    while (slots[i].entry)
+      i= (i + 1) & mask;
+    slots[i]= *slot;
+  }
+  my_free(p->slots);
+  memory+= (new_size - p->size) * sizeof(Slot);
+  p->memory+= (new_size - p->size) * sizeof(Slot);
+  p->slots= slots;
+  p->size= new_size;
+  return FALSE;
+}
+
+
+/**
+  Add a group after find() did not find it
+
+  @param hash  hash_key() of the key in TMP_TABLE_PARAM::group_buff
+
+  @details
+  The group key is copied from TMP_TABLE_PARAM::group_buff and the row
+  from record[0] of the temporary table.
+
+  @return the row of the new group, or NULL on out of memory
+*/
+
+uchar *Hash_aggregation::add(ulong hash)
+{
+  Partition *p= partition(hash);
+  Entry *entry;
+  size_t entry_length= sizeof(Entry) + key_length + rec_length;
+  DBUG_ASSERT(!p->spilled);
+
+  /* Keep at least half of the slots free */
+  if (!free_slot || (p->records + 1) * 2 > p->size)
+  {
+    if ((p->records + 1) * 2 > p->size && grow(p))
+      return NULL;
+    uint mask= p->size - 1;
+    uint i= first_slot(p, hash);
+    while (p->slots[i].entry)
+      i= (i + 1) & mask;
+    free_slot= p->slots + i;
+  }
+
+  if (!(entry= (Entry*) alloc_root(&p->root, entry_length)))
+    return NULL;
+  entry->next= NULL;
+  entry->seq= groups++;
+  memcpy(entry_key(entry), param->group_buff, param->group_length);
+  memcpy(entry_rec(entry), table->record[0], rec_length);
+
+  free_slot->hash= hash;
+  free_slot->entry= entry;
+  free_slot= NULL;
+  *p->last= entry;
+  p->last= &entry->next;
+  p->records++;
+  p->memory+= entry_length;
+  memory+= entry_length;
+  return entry_rec(entry);
+}
+
+
+/**
+  Write a list of groups into the temporary table
+
+  @details
+  The first group that does not fit in an in-memory temporary table
+  moves it to disk.
+*/
+
+bool Hash_aggregation::write_groups(Entry *entry)
+{
+  THD *thd= table->in_use;
+  for (; entry; entry= entry->next)
+  {
+    int error;
+    memcpy(table->record[0], entry_rec(entry), rec_length);
+    if ((error= table->file->ha_write_tmp_row(table->record[0])))
+    {
+      if (create_internal_tmp_table_from_heap(thd, table,
+                                              param->start_recinfo,
+                                              &param->recinfo,
+                                              error, 0, NULL))
+        return TRUE;
+      if ((error= table->file->ha_index_init(0, 0)))
+      {
+        table->file->print_error(error, MYF(0));
+        return TRUE;
+      }
+    }
+    if (thd->check_killed())
+    {
+      thd->send_kill_message();
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+
+/**
+  Move the largest partition into the temporary table to free memory
+
+  @details
+  An in-memory temporary table is moved to disk first, so that the spilled
+  groups do not take memory there.  Later rows of the partition are grouped
+  in the temporary table.
+*/
+
+bool Hash_aggregation::spill()
+{
+  Partition *victim= NULL;
+  Entry *entry;
+  DBUG_ENTER("Hash_aggregation::spill");
+
+  for (Partition *p= part; p < part + HASH_AGG_PARTITIONS; p++)
+  {
+    if (!p->spilled && p->records &&
+        (!victim || p->memory > victim->memory))
+      victim= p;
+  }
+  if (!victim)
+    DBUG_RETURN(FALSE);
+
+  DBUG_PRINT("info", ("spilling partition %d with %u groups",
+                      (int) (victim - part), victim->records));
+  victim->spilled= TRUE;
+  entry= victim->first;
+  if (table->s->db_type() == heap_hton)
+  {
+    /*
+      The first group of the partition is written by the conversion,
+      as the row that did not fit.
+    */
+    int error;
+    memcpy(table->record[0], entry_rec(entry), rec_length);
+    if (create_internal_tmp_table_from_heap(table->in_use, table,
+                                            param->start_recinfo,
+                                            &param->recinfo,
+                                            HA_ERR_RECORD_FILE_FULL, 0, NULL))
+      DBUG_RETURN(TRUE);
+    if ((error= table->file->ha_index_init(0, 0)))
+    {
+      table->file->print_error(error, MYF(0));
+      DBUG_RETURN(TRUE);
+    }
+    entry= entry->next;
+  }
+  if (write_groups(entry))
+    DBUG_RETURN(TRUE);
+  free_partition(victim);
+  DBUG_RETURN(FALSE);
+}
+
+
+/**
+  Write the groups that are in memory into the temporary table, in the
+  order in which they were created
+*/
+
+bool Hash_aggregation::flush()
+{
+  DBUG_ENTER("Hash_aggregation::flush");
+  for (;;)
+  {
+    Partition *next= NULL;
+    for (Partition *p= part; p < part + HASH_AGG_PARTITIONS; p++)
+    {
+      if (p->first && (!next || p->first->seq < next->first->seq))
+        next= p;
+    }
+    if (!next)
+      break;
+
+    Entry *entry= next->first;
+    next->first= entry->next;
+    entry->next= NULL;
+    if (write_groups(entry))
+      DBUG_RETURN(TRUE);
+  }
+  cleanup();
+  DBUG_RETURN(FALSE);
+}
@@ -0,0 +1,106 @@
+/*
+   Copyright (c) 2015, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef SQL_HASH_AGG_INCLUDED
+#define SQL_HASH_AGG_INCLUDED
+
+/*
+  This file contains the in-memory hash table that end_hash_update() uses
+  for GROUP BY over a temporary table
+*/
+
+#define HASH_AGG_PARTITIONS 16
+
+/**
+  Groups of a GROUP BY query that are kept in memory
+
+  @details
+  The rows of the grouping temporary table are kept in memory, each
+  together with a copy of its group key, and the aggregate functions are
+  updated in them.  The groups are hashed into HASH_AGG_PARTITIONS
+  partitions, each being an open addressing hash table whose rows are
+  allocated from a MEM_ROOT of its own.
+
+  When the memory used exceeds the limit of the in-memory temporary table,
+  the largest partition is written into the temporary table, which is
+  moved to disk, and its memory is freed.  The rows of a spilled partition
+  are then grouped in the temporary table itself.  At the end of the join
+  the groups that remain in memory are written into the temporary table in
+  the order in which they were created.
+*/
+
+class Hash_aggregation
+{
+  /* Header of a group; the group key and the row follow it */
+  struct Entry
+  {
+    Entry *next;                        /* Next group of the partition */
+    ulonglong seq;                      /* Number of the group */
+  };
+  struct Slot
+  {
+    ulong hash;
+    Entry *entry;                       /* NULL if the slot is free */
+  };
+  struct Partition
+  {
+    MEM_ROOT root;
+    Slot *slots;
+    uint size;                          /* Number of slots, a power of 2 */
+    uint records;
+    Entry *first, **last;               /* Groups in creation order */
+    size_t memory;
+    bool spilled;
+  };
+
+  TABLE *table;
+  TMP_TABLE_PARAM *param;
+  uint key_length;
+  uint rec_length;
+  size_t max_memory;
+  size_t memory;
+  ulonglong groups;
+  Slot *free_slot;                      /* Set by find() */
+  bool inited;
+  Partition part[HASH_AGG_PARTITIONS];
+
+  uchar *entry_key(Entry *entry) { return (uchar*) (entry + 1); }
+  uchar *entry_rec(Entry *entry) { return entry_key(entry) + key_length; }
+  Partition *partition(ulong hash) { return part + hash % HASH_AGG_PARTITIONS; }
+  uint first_slot(Partition *p, ulong hash)
+  {
+    return (uint) (hash / HASH_AGG_PARTITIONS) & (p->size - 1);
+  }
+  bool keys_differ(const uchar *key);
+  bool grow(Partition *p);
+  bool write_groups(Entry *entry);
+  void free_partition(Partition *p);
+
+public:
+  Hash_aggregation() :inited(FALSE) {}
+
+  bool init(TABLE *table_arg, TMP_TABLE_PARAM *param_arg);
+  void cleanup();
+  ulong hash_key();
+  bool is_spilled(ulong hash) { return partition(hash)->spilled; }
+  uchar *find(ulong hash);
+  uchar *add(ulong hash);
+  bool is_full() const { return memory > max_memory; }
+  bool spill();
+  bool flush();
+};
+
+#endif /* SQL_HASH_AGG_INCLUDED */
@@ -34,6 +34,18 @@
 
 #define NO_MORE_RECORDS_IN_BUFFER  (uint)(-1)
 
+#ifdef __GNUC__
+#define JOIN_CACHE_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define JOIN_CACHE_PREFETCH(addr) ((void) 0)
+#endif
+
+/* Bits of the Bloom filter of a hashed join cache per hash table entry */
+#define JOIN_CACHE_BLOOM_BITS_PER_ENTRY 8
+/* Minimal and maximal number of bits of the Bloom filter */
+#define JOIN_CACHE_BLOOM_MIN_BITS (1U << 9)
+#define JOIN_CACHE_BLOOM_MAX_BITS (1U << 23)
+
 static void save_or_restore_used_tabs(JOIN_TAB *join_tab, bool save);
 
 /*****************************************************************************
@@ -2687,7 +2699,9 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   ref_key_info= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
   ref_used_key_parts= join_tab->ref.key_parts;
 
-  hash_func= &JOIN_CACHE_HASHED::get_hash_idx_simple;
+  hash_func= key_length <= sizeof(ulonglong) ?
+              &JOIN_CACHE_HASHED::get_hash_idx_short :
+              &JOIN_CACHE_HASHED::get_hash_idx_simple;
   hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_simple;
 
   KEY_PART_INFO *key_part= ref_key_info->key_part;
@@ -2772,6 +2786,7 @@ int JOIN_CACHE_HASHED::init_hash_table()
    
   /* Initialize the hash table */ 
   hash_table= buff + (buff_size-hash_entries*size_of_key_ofs);
+  init_bloom_filter();
   cleanup_hash_table();
   curr_key_entry= hash_table;
 
@@ -2971,6 +2986,8 @@ bool JOIN_CACHE_HASHED::put_record()
     DBUG_ASSERT(last_key_entry >= end_pos);
     /* Increment the counter of key_entries in the hash table */ 
     key_entries++;
+    if (bloom_filter)
+      add_to_bloom_filter(key);
   }  
   return is_full;
 }
@@ -3084,9 +3101,40 @@ bool JOIN_CACHE_HASHED::skip_if_not_needed_match()
 
 bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
                                    uchar **key_ref_ptr) 
+{
+  return key_search(key, key_len, (this->*hash_func)(key, key_length),
+                    key_ref_ptr);
+}
+
+
+/* 
+  Search for a key in the hash table of the join buffer
+
+  SYNOPSIS
+    key_search()
+      key             pointer to the key value
+      key_len         key value length
+      idx             index of the hash entry for the key 
+      key_ref_ptr OUT position of the reference to the next key from 
+                      the hash element for the found key , or
+                      a position where the reference to the the hash 
+                      element for the key is to be added in the
+                      case when the key has not been found
+      
+  DESCRIPTION
+    The function does the same as the function key_search above, 
+    but uses the index of the hash entry for the key calculated by
+    the caller.
+
+  RETURN VALUE
+    TRUE    the key is found in the hash table
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len, uint idx,
+                                   uchar **key_ref_ptr) 
 {
   bool is_found= FALSE;
-  uint idx= (this->*hash_func)(key, key_length);
   uchar *ref_ptr= hash_table+size_of_key_ofs*idx;
   while (!is_null_key_ref(ref_ptr))
   {
@@ -3139,6 +3187,61 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
 }
 
 
+/* 
+  Hash function for short keys considered as byte arrays
+
+  SYNOPSIS
+    get_hash_idx_short()
+      key             pointer to the key value
+      key_len         key value length, not greater than 8
+      
+  DESCRIPTION
+    The function calculates an index of the hash entry in the hash table
+    of the join buffer for the given key as get_hash_idx_simple does, but
+    reads the whole key as one word and mixes it with one multiplication
+    instead of processing it byte by byte. This is used for keys over
+    integer columns.
+
+  RETURN VALUE
+    the calculated index of the hash entry for the given key  
+*/
+
+inline
+uint JOIN_CACHE_HASHED::get_hash_idx_short(uchar *key, uint key_len)
+{
+  ulonglong nr= 0;
+  memcpy(&nr, key, key_len);
+  nr*= 0x9E3779B97F4A7C15ULL;
+  return (uint) ((nr >> 32) % hash_entries);
+}
+
+
+/* Prefetch the hash entry with the index idx */
+
+void JOIN_CACHE_HASHED::prefetch_hash_entry(uint idx)
+{
+  JOIN_CACHE_PREFETCH(hash_table+size_of_key_ofs*idx);
+}
+
+
+/*
+  Prefetch the first key entry attached to the hash entry with the index idx
+
+  NOTES
+    The hash entry is supposed to have been prefetched already.
+*/
+
+void JOIN_CACHE_HASHED::prefetch_key_entry(uint idx)
+{
+  uchar *ref_ptr= hash_table+size_of_key_ofs*idx;
+  if (is_null_key_ref(ref_ptr))
+    return;
+  ref_ptr= get_next_key_ref(ref_ptr);
+  JOIN_CACHE_PREFETCH(use_emb_key ? ref_ptr-get_size_of_rec_offset() :
+                                    ref_ptr-key_length);
+}
+
+
 /* 
   Hash function that takes into account collations of the components of the key  
 
@@ -3247,6 +3350,117 @@ void JOIN_CACHE_HASHED:: cleanup_hash_table()
   last_key_entry= hash_table;
   bzero(hash_table, (buff+buff_size)-hash_table);
   key_entries= 0;
+  if (bloom_filter)
+    bzero(bloom_filter, (bloom_filter_mask+1)/8);
+}
+
+
+/*
+  Allocate the Bloom filter over the keys in the hash table
+
+  DESCRIPTION
+    If use_bloom_filter is set, the function allocates a Bloom filter 
+    with JOIN_CACHE_BLOOM_BITS_PER_ENTRY bits per hash table entry, 
+    rounded up to a power of 2 and bounded by JOIN_CACHE_BLOOM_MIN_BITS
+    and JOIN_CACHE_BLOOM_MAX_BITS, so that the filter stays small enough
+    to be kept in the processor cache.
+    If the memory cannot be allocated the cache just does not use the filter.
+    The function is called whenever the hash table is initialized within
+    a new join buffer.
+*/
+
+void JOIN_CACHE_HASHED::init_bloom_filter()
+{
+  my_free(bloom_filter);
+  bloom_filter= 0;
+  if (!use_bloom_filter)
+    return;
+
+  ulonglong bits= (ulonglong) hash_entries*JOIN_CACHE_BLOOM_BITS_PER_ENTRY;
+  uint size= JOIN_CACHE_BLOOM_MIN_BITS;
+  while (size < bits && size < JOIN_CACHE_BLOOM_MAX_BITS)
+    size<<= 1;
+  bloom_filter= (uchar*) my_malloc(size/8, MYF(MY_THREAD_SPECIFIC));
+  bloom_filter_mask= size-1;
+}
+
+
+/*
+  Calculate the hash value of a key for the Bloom filter
+
+  DESCRIPTION
+    Equal keys get the same hash value: if the keys are compared taking
+    into account the collations of their components the value is
+    calculated by key_hashnr(), otherwise the key is considered as a
+    sequence of bytes. The value is scrambled by a multiplication, so that
+    its high bits depend on all bits of the key.
+*/
+
+inline
+ulonglong JOIN_CACHE_HASHED::get_bloom_hash(uchar *key)
+{
+  ulonglong nr;
+  if (hash_cmp_func == &JOIN_CACHE_HASHED::equal_keys_complex)
+    nr= key_hashnr(ref_key_info, ref_used_key_parts, key);
+  else if (key_length <= sizeof(ulonglong))
+  {
+    nr= 0;
+    memcpy(&nr, key, key_length);
+  }
+  else
+  {
+    /* FNV-1a */
+    nr= 0xCBF29CE484222325ULL;
+    for (uchar *pos= key, *end= key+key_length; pos < end; pos++)
+      nr= (nr ^ *pos) * 0x100000001B3ULL;
+  }
+  return nr * 0x9E3779B97F4A7C15ULL;
+}
+
+
+/*
+  Add a key to the Bloom filter of the hashed join cache
+
+  DESCRIPTION
+    Two bits of the filter are set for the key. Their positions are taken
+    from two non-overlapping ranges of the high bits of the hash value.
+*/
+
+void JOIN_CACHE_HASHED::add_to_bloom_filter(uchar *key)
+{
+  ulonglong nr= get_bloom_hash(key);
+  uint bit1= (uint) (nr >> 41) & bloom_filter_mask;
+  uint bit2= (uint) (nr >> 18) & bloom_filter_mask;
+  bloom_filter[bit1 >> 3]|= (uchar) (1 << (bit1 & 7));
+  bloom_filter[bit2 >> 3]|= (uchar) (1 << (bit2 & 7));
+}
+
+
+/*
+  Check whether a key may be in the hash table by the Bloom filter
+
+  RETURN VALUE
+    FALSE   the key is not in the hash table
+    TRUE    the key may be in the hash table, or there is no Bloom filter
+*/
+
+bool JOIN_CACHE_HASHED::bloom_filter_may_contain(uchar *key)
+{
+  if (!bloom_filter)
+    return TRUE;
+  ulonglong nr= get_bloom_hash(key);
+  uint bit1= (uint) (nr >> 41) & bloom_filter_mask;
+  uint bit2= (uint) (nr >> 18) & bloom_filter_mask;
+  return (bloom_filter[bit1 >> 3] & (1 << (bit1 & 7))) &&
+         (bloom_filter[bit2 >> 3] & (1 << (bit2 & 7)));
+}
+
+
+void JOIN_CACHE_HASHED::free()
+{
+  my_free(bloom_filter);
+  bloom_filter= 0;
+  JOIN_CACHE::free();
 }
 
 
@@ -3353,7 +3567,9 @@ int JOIN_TAB_SCAN::open()
     match some records in the buffer of the join cache 'cache'. To do
     this the function calls the function that scans table records and
     looks for the next one that meets the condition pushed to the
-    joined table join_tab.
+    joined table join_tab. The records that the join cache tells cannot
+    match any record from its buffer are skipped before the condition
+    is evaluated for them.
 
   NOTES
     The function catches the signal that kills the query.
@@ -3366,7 +3582,7 @@ int JOIN_TAB_SCAN::open()
 int JOIN_TAB_SCAN::next()
 {
   int err= 0;
-  int skip_rc;
+  int skip_rc= 0;
   READ_RECORD *info= &join_tab->read_record;
   SQL_SELECT *select= join_tab->cache_select;
   TABLE *table= join_tab->table;
@@ -3384,13 +3600,15 @@ int JOIN_TAB_SCAN::next()
       update_virtual_fields(thd, table);
   }
 
-  while (!err && select && (skip_rc= select->skip_record(thd)) <= 0)
+  while (!err &&
+         (cache->cannot_match_join_tab_record() ||
+          (select && (skip_rc= select->skip_record(thd)) <= 0)))
   {
     if (thd->check_killed() || skip_rc < 0) 
       return 1;
     /* 
-      Move to the next record if the last retrieved record does not
-      meet the condition pushed to the table join_tab.
+      Move to the next record if the last retrieved record cannot match
+      or does not meet the condition pushed to the table join_tab.
     */
     err= info->read_record(info);
     if (!err)
@@ -3648,6 +3866,14 @@ uchar *JOIN_CACHE_BNLH::get_matching_chain_by_join_key()
   TABLE *table= join_tab->table;
   TABLE_REF *ref= &join_tab->ref;
   KEY *keyinfo= join_tab->get_keyinfo_by_key_no(ref->key);
+  if (bnlh_scan && bnlh_scan->curr_key)
+  {
+    /* The key and its hash entry have been calculated when reading ahead */
+    if (!key_search(bnlh_scan->curr_key, key_length,
+                    bnlh_scan->curr_hash_idx, &key_ref_ptr))
+      return 0;
+    return key_ref_ptr+get_size_of_key_offset();
+  }
   /* Build the join key value out of the record in the record buffer */
   key_copy(key_buff, table->record[0], keyinfo, key_length, TRUE);
   /* Look for this key in the join buffer */
@@ -3801,12 +4027,574 @@ void JOIN_CACHE_BNLH::read_next_candidate_for_match(uchar *rec_ptr)
 
 int JOIN_CACHE_BNLH::init(bool for_explain)
 {
+  int rc;
+  uint partitions= (uint) join->thd->variables.join_cache_spill_partitions;
   DBUG_ENTER("JOIN_CACHE_BNLH::init");
 
-  if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
+  spill_partitions= 0;
+  spilling= FALSE;
+  bnlh_scan= 0;
+  use_bloom_filter= !for_explain &&
+    optimizer_flag(join->thd, OPTIMIZER_SWITCH_JOIN_CACHE_BLOOM_FILTER);
+  if (!for_explain && (can_read_ahead() || (partitions && !prev_cache)))
+  {
+    if (!(bnlh_scan= new JOIN_TAB_SCAN_BNLH(join, join_tab, this)))
+      DBUG_RETURN(1);
+    join_tab_scan= bnlh_scan;
+  }
+  else if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
     DBUG_RETURN(1);
 
-  DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
+  if ((rc= JOIN_CACHE_HASHED::init(for_explain)) || !bnlh_scan)
+    DBUG_RETURN(rc);
+
+  if (can_read_ahead() && bnlh_scan->init_batch(key_length))
+    DBUG_RETURN(1);
+
+  if (!partitions || prev_cache)
+    DBUG_RETURN(0);
+
+  build_rec_length= 0;
+  for (JOIN_TAB *tab= start_tab; tab != join_tab; tab++)
+    build_rec_length+= tab->table->s->reclength;
+  if (!(build_files= (IO_CACHE*) sql_calloc(2*partitions*sizeof(IO_CACHE))) ||
+      !(build_file_records= (ha_rows*) sql_calloc(partitions*sizeof(ha_rows))) ||
+      !(build_rec= (uchar*) sql_alloc(build_rec_length)))
+    DBUG_RETURN(1);
+  probe_files= build_files + partitions;
+  for (uint i= 0; i < 2*partitions; i++)
+    my_b_clear(&build_files[i]);
+  spill_partitions= partitions;
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Check whether records of join_tab can be read ahead to probe the cache
+
+  DESCRIPTION
+    A record read ahead is kept as a copy of the record buffer of join_tab
+    and copied back when it is to be joined. This is not possible if the
+    record refers to blob data owned by the handler, if the row id of the
+    current record of join_tab is needed, or if the access method for
+    join_tab can change for every record from the join buffer.
+    Read-ahead is also turned off by the optimizer switch
+    join_cache_read_ahead.
+*/
+
+bool JOIN_CACHE_BNLH::can_read_ahead()
+{
+  return optimizer_flag(join->thd, OPTIMIZER_SWITCH_JOIN_CACHE_READ_AHEAD) &&
+         !join_tab->keep_current_rowid && join_tab->use_quick != 2 &&
+         !join_tab->table->s->blob_fields;
+}
+
+
+/*
+  Check whether the BNLH join cache can spill its records to disk
+
+  DESCRIPTION
+    Records are spilled by writing the record buffers of the tables
+    to files and restoring them later. This is possible only when the 
+    cache is not linked to other caches, the tables have no blobs and 
+    no row ids of them are needed, and join_tab is joined by an inner 
+    join that is not executed as a semi-join with the first match 
+    strategy.
+
+  RETURN VALUE
+    TRUE    the cache can spill
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::can_spill()
+{
+  if (!spill_partitions || prev_cache || next_cache ||
+      join_tab->first_inner || join_tab->check_only_first_match() ||
+      join_tab->bush_root_tab || join_tab->use_quick == 2)
+    return FALSE;
+  for (JOIN_TAB *tab= start_tab; tab <= join_tab; tab++)
+  {
+    if (tab->bush_children || tab->keep_current_rowid ||
+        tab->table->s->blob_fields)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+
+/*
+  Switch the BNLH join cache to writing new records to the spill files
+
+  RETURN VALUE
+    TRUE    the spill files are ready
+    FALSE   the cache cannot spill
+*/
+
+bool JOIN_CACHE_BNLH::start_spilling()
+{
+  if (!can_spill())
+    return FALSE;
+  for (uint i= 0; i < 2*spill_partitions; i++)
+  {
+    IO_CACHE *file= &build_files[i];
+    if (my_b_inited(file) ? reinit_io_cache(file, WRITE_CACHE, 0L, 0, 0) :
+        open_cached_file(file, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
+                         MYF(MY_WME)))
+      return FALSE;
+  }
+  bzero(build_file_records, spill_partitions*sizeof(ha_rows));
+  spilling= TRUE;
+  spill_error= FALSE;
+  return TRUE;
+}
+
+
+/* Get the spill partition for a join key */
+
+uint JOIN_CACHE_BNLH::get_spill_partition(uchar *key)
+{
+  ulong nr= key_hashnr(ref_key_info, ref_used_key_parts, key);
+  return (uint) ((nr ^ (nr >> 16)) % spill_partitions);
+}
+
+
+/* Copy the record buffers of the tables in the cache into rec */
+
+void JOIN_CACHE_BNLH::save_build_record(uchar *rec)
+{
+  for (JOIN_TAB *tab= start_tab; tab != join_tab; tab++)
+  {
+    memcpy(rec, tab->table->record[0], tab->table->s->reclength);
+    rec+= tab->table->s->reclength;
+  }
+}
+
+
+/* Restore the record buffers of the tables in the cache from rec */
+
+void JOIN_CACHE_BNLH::restore_build_record(uchar *rec)
+{
+  for (JOIN_TAB *tab= start_tab; tab != join_tab; tab++)
+  {
+    memcpy(tab->table->record[0], rec, tab->table->s->reclength);
+    tab->table->status= 0;
+    tab->table->null_row= 0;
+    rec+= tab->table->s->reclength;
+  }
+}
+
+
+/*
+  Add a record into the buffer of a BNLH join cache or its spill files
+
+  DESCRIPTION
+    This implementation of the virtual function put_record writes the
+    record into the join buffer as the JOIN_CACHE_HASHED implementation
+    does, unless the cache has started spilling.
+    When the buffer becomes full and the cache can spill, the cache starts
+    spilling instead of reporting that the buffer is full. From then on all
+    records are written to the spill file of the partition of their join key.
+
+  RETURN VALUE
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer,
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::put_record()
+{
+  if (spilling)
+  {
+    if (spill_build_record())
+      spill_error= TRUE;
+    return FALSE;
+  }
+  bool is_full= JOIN_CACHE_HASHED::put_record();
+  if (is_full && spill_partitions && start_spilling())
+    return FALSE;
+  return is_full;
+}
+
+
+/* Write the current partial join record to its spill file */
+
+bool JOIN_CACHE_BNLH::spill_build_record()
+{
+  if (spill_error)
+    return TRUE;
+  cp_buffer_from_ref(join->thd, join_tab->table, &join_tab->ref);
+  uint part= get_spill_partition(join_tab->ref.key_buff);
+  /* Records of join_tab matching the spilled record must not be skipped */
+  if (bloom_filter)
+    add_to_bloom_filter(join_tab->ref.key_buff);
+  save_build_record(build_rec);
+  build_file_records[part]++;
+  return my_b_write(&build_files[part], build_rec, build_rec_length);
+}
+
+
+/* Write the current record of join_tab with the join key key to its spill file */
+
+bool JOIN_CACHE_BNLH::spill_probe_record(uchar *key)
+{
+  TABLE *table= join_tab->table;
+  if (!key)
+  {
+    key_copy(key_buff, table->record[0], ref_key_info, key_length, TRUE);
+    key= key_buff;
+  }
+  uint part= get_spill_partition(key);
+  if (!build_file_records[part])
+    return FALSE;                   // No partial join record can match it
+  return my_b_write(&probe_files[part], table->record[0],
+                    table->s->reclength);
+}
+
+
+/*
+  Read the next spilled record of join_tab from partition part
+
+  RETURN VALUE
+    TRUE    a record has been read into the record buffer of join_tab
+    FALSE   no more records, *error is set to -1 at the end of the
+            file and to 1 on a read error
+*/
+
+bool JOIN_CACHE_BNLH::read_probe_record(uint part, int *error)
+{
+  TABLE *table= join_tab->table;
+  IO_CACHE *file= &probe_files[part];
+  if (my_b_tell(file) >= file->end_of_file)
+  {
+    *error= -1;
+    return FALSE;
+  }
+  if (my_b_read(file, table->record[0], table->s->reclength))
+  {
+    *error= 1;
+    return FALSE;
+  }
+  table->status= 0;
+  table->null_row= 0;
+  return TRUE;
+}
+
+
+/*
+  Find matches from join_tab for records from the BNLH join cache
+
+  DESCRIPTION
+    This implementation of the virtual function join_matching_records
+    calls the default implementation unless the cache has spilled
+    records. In that case it joins the records from the buffer with
+    all records of join_tab, writing the records of join_tab to the 
+    spill files on the way, and then joins the spill files partition
+    by partition.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_matching_records(bool skip_last)
+{
+  enum_nested_loop_state rc;
+  bool has_spilled= FALSE;
+  DBUG_ENTER("JOIN_CACHE_BNLH::join_matching_records");
+
+  if (spilling)
+  {
+    for (uint i= 0; i < spill_partitions; i++)
+      has_spilled|= MY_TEST(build_file_records[i]);
+    spilling= FALSE;
+  }
+  if (!has_spilled)
+    DBUG_RETURN(JOIN_CACHE::join_matching_records(skip_last));
+
+  if (spill_error)
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+
+  /* The record last put is in build_rec, restore it after the join */
+  DBUG_ASSERT(!skip_last);
+  bnlh_scan->spill_records= TRUE;
+  rc= JOIN_CACHE::join_matching_records(FALSE);
+  bnlh_scan->spill_records= FALSE;
+  if (rc == NESTED_LOOP_OK || rc == NESTED_LOOP_NO_MORE_ROWS)
+    rc= join_spilled_partitions();
+
+  reset(TRUE);
+  restore_build_record(build_rec);
+  DBUG_RETURN(rc);
+}
+
+
+/*
+  Join the spilled partial join records with the spilled records of
+  join_tab partition by partition
+
+  DESCRIPTION
+    The partial join records of each partition are loaded into the join
+    buffer. Whenever the buffer is full, or all records of the partition
+    have been loaded, the records of join_tab from the same partition are
+    read from their spill file to find the matches.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_spilled_partitions()
+{
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  uchar *last_build_rec= build_rec;
+  uchar *rec;
+  DBUG_ENTER("JOIN_CACHE_BNLH::join_spilled_partitions");
+
+  /* Keep the last spilled record, it is restored by the caller */
+  if (!(build_rec= (uchar*) my_malloc(build_rec_length,
+                                      MYF(MY_WME | MY_THREAD_SPECIFIC))))
+  {
+    build_rec= last_build_rec;
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+  }
+  rec= build_rec;
+
+  for (uint part= 0; part < spill_partitions; part++)
+  {
+    IO_CACHE *build_file= &build_files[part];
+    IO_CACHE *probe_file= &probe_files[part];
+    ha_rows left= build_file_records[part];
+    if (!left)
+      continue;
+    if (flush_io_cache(build_file) || flush_io_cache(probe_file) ||
+        reinit_io_cache(build_file, READ_CACHE, 0L, 0, 0))
+    {
+      rc= NESTED_LOOP_ERROR;
+      break;
+    }
+    bnlh_scan->partition= part;
+    while (left && rc == NESTED_LOOP_OK)
+    {
+      bool is_full= FALSE;
+      reset(TRUE);
+      while (left && !is_full)
+      {
+        if (my_b_read(build_file, rec, build_rec_length))
+        {
+          rc= NESTED_LOOP_ERROR;
+          break;
+        }
+        left--;
+        restore_build_record(rec);
+        is_full= JOIN_CACHE_HASHED::put_record();
+      }
+      if (rc == NESTED_LOOP_OK)
+      {
+        rc= JOIN_CACHE::join_matching_records(FALSE);
+        if (rc == NESTED_LOOP_NO_MORE_ROWS)
+          rc= NESTED_LOOP_OK;
+      }
+    }
+    bnlh_scan->partition= -1;
+    if (rc != NESTED_LOOP_OK)
+      break;
+  }
+  my_free(rec);
+  build_rec= last_build_rec;
+  DBUG_RETURN(rc);
+}
+
+
+/* Free the join buffer and close the spill files of a BNLH join cache */
+
+void JOIN_CACHE_BNLH::free()
+{
+  close_spill_files();
+  JOIN_CACHE_HASHED::free();
+}
+
+
+void JOIN_CACHE_BNLH::close_spill_files()
+{
+  if (!build_files)
+    return;
+  for (uint i= 0; i < 2*spill_partitions; i++)
+    close_cached_file(&build_files[i]);
+  spilling= FALSE;
+}
+
+
+/*
+  Check whether the current record of join_tab cannot match any record
+  from the BNLH join cache
+
+  DESCRIPTION
+    This implementation of the virtual function builds the join key from
+    the record of join_tab and looks for it in the Bloom filter over the
+    keys of the records in the join buffer and in the spill files.
+
+  RETURN VALUE
+    TRUE    the record cannot match 
+    FALSE   the record may match, or the cache has no Bloom filter
+*/
+
+bool JOIN_CACHE_BNLH::cannot_match_join_tab_record()
+{
+  if (!bloom_filter)
+    return FALSE;
+  key_copy(key_buff, join_tab->table->record[0], ref_key_info, key_length,
+           TRUE);
+  return !bloom_filter_may_contain(key_buff);
+}
+
+
+/*
+  Allocate the buffers for the records of join_tab read ahead
+
+  SYNOPSIS
+    init_batch()
+      key_length      length of the join key
+
+  RETURN VALUE
+    0   the buffers have been allocated
+    1   otherwise
+*/
+
+int JOIN_TAB_SCAN_BNLH::init_batch(uint key_length)
+{
+  rec_length= join_tab->table->s->reclength;
+  if (!(batch_recs= (uchar*) sql_alloc(JOIN_CACHE_PROBE_BATCH*rec_length)) ||
+      !(batch_keys= (uchar*) sql_alloc(JOIN_CACHE_PROBE_BATCH*key_length)) ||
+      !(batch_hash_idx= (uint*) sql_alloc(JOIN_CACHE_PROBE_BATCH*sizeof(uint))))
+  {
+    batch_recs= 0;
+    return 1;
+  }
+  return 0;
+}
+
+
+/*
+  Open the iterator over join_tab for a BNLH join cache
+
+  DESCRIPTION
+    If no spill partition is set, the function starts a scan of join_tab
+    as JOIN_TAB_SCAN::open does. Otherwise it prepares to read the records
+    of join_tab from the spill file of the partition.
+
+  RETURN VALUE   
+    0            the initiation is a success 
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_BNLH::open()
+{
+  batch_count= batch_pos= 0;
+  batch_error= 0;
+  curr_key= 0;
+  if (partition < 0)
+    return JOIN_TAB_SCAN::open();
+  save_or_restore_used_tabs(join_tab, FALSE);
+  return reinit_io_cache(&bnlh_cache->probe_files[partition], READ_CACHE,
+                         0L, 0, 0);
+}
+
+
+/*
+  Read ahead the next batch of records of join_tab
+
+  DESCRIPTION
+    The function reads up to JOIN_CACHE_PROBE_BATCH records of join_tab
+    that meet the condition pushed to join_tab and saves them. For each
+    record it builds the join key, calculates the hash entry for it and
+    prefetches the entry. After this it prefetches the first key entries
+    attached to the hash entries. The loads of all hash entries of the
+    batch overlap instead of stalling the probe for each record.
+
+  RETURN VALUE   
+    0            at least one record has been read
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_BNLH::fill_batch()
+{
+  int err= batch_error;
+  TABLE *table= join_tab->table;
+  uint key_length= bnlh_cache->key_length;
+
+  batch_count= batch_pos= 0;
+  if (err)
+    return err;
+  while (batch_count < JOIN_CACHE_PROBE_BATCH && !(err= JOIN_TAB_SCAN::next()))
+  {
+    uchar *key= batch_keys+batch_count*key_length;
+    memcpy(batch_recs+batch_count*rec_length, table->record[0], rec_length);
+    key_copy(key, table->record[0], bnlh_cache->ref_key_info, key_length,
+             TRUE);
+    batch_hash_idx[batch_count]= bnlh_cache->get_hash_idx(key);
+    bnlh_cache->prefetch_hash_entry(batch_hash_idx[batch_count]);
+    batch_count++;
+  }
+  batch_error= err;
+  if (!batch_count)
+    return err;
+  for (uint i= 0; i < batch_count; i++)
+    bnlh_cache->prefetch_key_entry(batch_hash_idx[i]);
+  return 0;
+}
+
+
+/*
+  Read the next record of join_tab for a BNLH join cache
+
+  DESCRIPTION
+    If no spill partition is set, the function reads the next record
+    of join_tab that meets the condition pushed to join_tab, taking it
+    from the batch of records read ahead if possible, and writes it to
+    its spill file if spill_records is set. Otherwise it reads the next
+    record of join_tab from the spill file of the partition.
+
+  RETURN VALUE   
+    0            the next record exists and has been successfully read 
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_BNLH::next()
+{
+  int err= 0;
+  if (partition >= 0)
+  {
+    if (!bnlh_cache->read_probe_record(partition, &err))
+      return err;
+    return 0;
+  }
+  if (!batch_recs)
+    err= JOIN_TAB_SCAN::next();
+  else if (batch_pos < batch_count || !(err= fill_batch()))
+  {
+    TABLE *table= join_tab->table;
+    memcpy(table->record[0], batch_recs+batch_pos*rec_length, rec_length);
+    table->status= 0;
+    table->null_row= 0;
+    curr_key= batch_keys+batch_pos*bnlh_cache->key_length;
+    curr_hash_idx= batch_hash_idx[batch_pos];
+    batch_pos++;
+  }
+  else
+    curr_key= 0;
+  if (!err && spill_records && bnlh_cache->spill_probe_record(curr_key))
+    err= 1;
+  return err;
+}
+
+
+void JOIN_TAB_SCAN_BNLH::close()
+{
+  curr_key= 0;
+  if (partition >= 0)
+  {
+    save_or_restore_used_tabs(join_tab, TRUE);
+    return;
+  }
+  JOIN_TAB_SCAN::close();
 }
 
 
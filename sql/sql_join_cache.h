@@ -664,11 +664,17 @@ class JOIN_CACHE :public Sql_alloc
   /* Add a comment on the join algorithm employed by the join cache */
   virtual void save_explain_data(EXPLAIN_BKA_TYPE *explain);
 
+  /*
+    Shall check whether the record of join_tab in its record buffer
+    cannot match any record from the join buffer
+  */
+  virtual bool cannot_match_join_tab_record() { return FALSE; }
+
   THD *thd();
 
   virtual ~JOIN_CACHE() {}
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -792,6 +798,7 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   uint data_fields_offset;
 
   inline uint get_hash_idx_simple(uchar *key, uint key_len);
+  inline uint get_hash_idx_short(uchar *key, uint key_len);
   inline uint get_hash_idx_complex(uchar *key, uint key_len);
 
   inline bool equal_keys_simple(uchar *key1, uchar *key2, uint key_len);
@@ -799,6 +806,12 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
 
   int init_hash_table();
   void cleanup_hash_table();
+
+  /* Number of bits in the Bloom filter minus 1, the number is a power of 2 */
+  uint bloom_filter_mask;
+
+  void init_bloom_filter();
+  inline ulonglong get_bloom_hash(uchar *key);
   
 protected:
 
@@ -835,6 +848,11 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* Number of key entries in the hash table (number of distinct keys) */
   uint key_entries;
 
+  /* TRUE if a Bloom filter is to be built over the keys in the hash table */
+  bool use_bloom_filter;
+  /* The Bloom filter over the keys in the hash table, 0 if it is not used */
+  uchar *bloom_filter;
+
   /* The position of the last key entry in the hash table */
   uchar *last_key_entry;
 
@@ -849,6 +867,17 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
 
   uint get_size_of_key_offset() { return size_of_key_ofs; }
 
+  /* Get the index of the hash entry for a key value */
+  uint get_hash_idx(uchar *key) { return (this->*hash_func)(key, key_length); }
+
+  void prefetch_hash_entry(uint idx);
+  void prefetch_key_entry(uint idx);
+
+  /* Add a key to the Bloom filter */
+  void add_to_bloom_filter(uchar *key);
+  /* Check whether a key may be in the hash table by the Bloom filter */
+  bool bloom_filter_may_contain(uchar *key);
+
   /* 
     Get the position of the next_key_ptr field pointed to by 
     a linking reference stored at the position key_ref_ptr. 
@@ -971,6 +1000,7 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
 
   /* Search for a key in the hash table of the join buffer */
   bool key_search(uchar *key, uint key_len, uchar **key_ref_ptr);
+  bool key_search(uchar *key, uint key_len, uint idx, uchar **key_ref_ptr);
 
   /* Reallocate the join buffer of a hashed join cache */
   int realloc_buffer();
@@ -980,7 +1010,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_HASHED(JOIN *j, JOIN_TAB *tab) :JOIN_CACHE(j, tab) {}
+  JOIN_CACHE_HASHED(JOIN *j, JOIN_TAB *tab)
+    :JOIN_CACHE(j, tab), use_bloom_filter(FALSE), bloom_filter(0) {}
 
   /* 
     This constructor creates a linked hashed join cache. The cache is to be
@@ -989,7 +1020,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_HASHED(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-		    :JOIN_CACHE(j, tab, prev) {}
+		    :JOIN_CACHE(j, tab, prev), use_bloom_filter(FALSE),
+                     bloom_filter(0) {}
 
 public:
 
@@ -1012,6 +1044,9 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   virtual bool check_all_match_flags_for_key(uchar *key_chain_ptr);
 
   uint get_next_key(uchar **key); 
+
+  /* Free the join buffer and the Bloom filter of a hashed join cache */
+  void free();
   
   /* Get the head of the record chain attached to the current key entry */ 
   uchar *get_curr_key_chain()
@@ -1139,14 +1174,133 @@ class JOIN_CACHE_BNL :public JOIN_CACHE
 };
 
 
+class JOIN_CACHE_BNLH;
+
+/* Number of records of join_tab read ahead to probe a BNLH join buffer */
+#define JOIN_CACHE_PROBE_BATCH 16
+
+/*
+  The class JOIN_TAB_SCAN_BNLH is the iterator over join_tab used by a BNLH
+  join cache. Records of join_tab without blobs are read in batches of
+  JOIN_CACHE_PROBE_BATCH records: the join keys and the hash entries for
+  all records of a batch are calculated at once and the hash entries are
+  prefetched, so that the cache misses of the probes into the hash table
+  overlap. The records are then returned one by one in the order they have
+  been read. Read-ahead can be turned off with the optimizer switch
+  join_cache_read_ahead.
+  When the cache can spill to disk, the iterator additionally writes the
+  records read from join_tab into the spill files of the cache. When a spill
+  partition is set, it reads the records of join_tab back from the spill
+  file of that partition.
+*/
+
+class JOIN_TAB_SCAN_BNLH: public JOIN_TAB_SCAN
+{
+  /* The BNLH cache that is probed with the records of join_tab */
+  JOIN_CACHE_BNLH *bnlh_cache;
+
+  /* Images of the records of join_tab read ahead, 0 if not used */
+  uchar *batch_recs;
+  /* Join keys of the records read ahead */
+  uchar *batch_keys;
+  /* Hash entries for the join keys of the records read ahead */
+  uint *batch_hash_idx;
+  /* Number of records read ahead and the position of the next one */
+  uint batch_count;
+  uint batch_pos;
+  /* Length of the record of join_tab */
+  uint rec_length;
+  /* Error that has stopped reading ahead, -1 at the end of the scan */
+  int batch_error;
+
+  int fill_batch();
+
+public:
+
+  /* Partition to read join_tab records from, or -1 to scan join_tab */
+  int partition;
+
+  /* TRUE if the records read from join_tab are to be spilled */
+  bool spill_records;
+
+  /* Join key of the current record if it has been read ahead, 0 otherwise */
+  uchar *curr_key;
+  /* Hash entry for curr_key */
+  uint curr_hash_idx;
+
+  JOIN_TAB_SCAN_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE_BNLH *bnlh)
+    :JOIN_TAB_SCAN(j, tab), bnlh_cache(bnlh), batch_recs(0),
+     partition(-1), spill_records(FALSE), curr_key(0) {}
+
+  int init_batch(uint key_length);
+
+  int open();
+
+  int next();
+
+  void close();
+};
+
+
 /*
   The class JOIN_CACHE_BNLH is used when the BNLH join algorithm is
   employed to perform a join operation   
+
+  If join_cache_spill_partitions is not 0, a BNLH cache that is not linked
+  to other caches does not rescan join_tab for every refill of the join
+  buffer. Instead, once the buffer is full, the following partial join
+  records are hashed by their join key into the partitions and written to
+  spill files (the records of the tables whose fields are stored in the
+  buffer are written as a whole). The scan of join_tab then matches its 
+  records with the records in the buffer, and writes them to the spill
+  file of their partition. After this, each partition of the partial join
+  records is loaded into the buffer and joined with the records of join_tab
+  from the same partition (grace hash join). Spilling is used only for
+  inner joins of tables without blobs.
+
+  If the optimizer switch join_cache_bloom_filter is on, the cache builds
+  a Bloom filter over the join keys of the partial join records that are
+  put into the buffer or spilled. The scan of join_tab discards the records
+  whose join key is not in the filter before the condition pushed to
+  join_tab is evaluated for them and before they are read ahead or spilled.
 */
 
 class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 {
 
+private:
+
+  /* Number of spill partitions, 0 if the cache does not spill */
+  uint spill_partitions;
+  /* TRUE when new records are written to the spill files */
+  bool spilling;
+  /* TRUE if writing to a spill file has failed */
+  bool spill_error;
+  /* Spill files for the partial join records, one per partition */
+  IO_CACHE *build_files;
+  /* Spill files for the records of join_tab, one per partition */
+  IO_CACHE *probe_files;
+  /* Number of partial join records in each spill partition */
+  ha_rows *build_file_records;
+  /* Buffer for a spilled partial join record */
+  uchar *build_rec;
+  /* Length of a spilled partial join record */
+  uint build_rec_length;
+  /* The iterator over join_tab if it reads ahead or spilling is possible */
+  JOIN_TAB_SCAN_BNLH *bnlh_scan;
+
+  bool can_read_ahead();
+  bool can_spill();
+  bool start_spilling();
+  uint get_spill_partition(uchar *key);
+  void save_build_record(uchar *rec);
+  void restore_build_record(uchar *rec);
+  bool spill_build_record();
+  bool spill_probe_record(uchar *key);
+  bool read_probe_record(uint part, int *error);
+  enum_nested_loop_state join_spilled_partitions();
+  void close_spill_files();
+
 protected:
 
   /* 
@@ -1178,6 +1332,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   void read_next_candidate_for_match(uchar *rec_ptr);
 
+  enum_nested_loop_state join_matching_records(bool skip_last);
+
 public:
 
   /* 
@@ -1185,7 +1341,9 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), spill_partitions(0), spilling(FALSE),
+      build_files(0), probe_files(0), bnlh_scan(0) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1194,7 +1352,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), spill_partitions(0), spilling(FALSE),
+      build_files(0), probe_files(0), bnlh_scan(0) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain);
@@ -1203,6 +1362,13 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   bool is_key_access() { return TRUE; }
 
+  bool put_record();
+
+  bool cannot_match_join_tab_record();
+
+  void free();
+
+  friend class JOIN_TAB_SCAN_BNLH;
 };
 
 
@@ -563,6 +563,7 @@ typedef class st_select_lex_node SELECT_LEX_NODE;
 class THD;
 class select_result;
 class JOIN;
+class Join_plan_cache;
 class select_union;
 class Procedure;
 class Explain_query;
@@ -723,6 +724,11 @@ class st_select_lex: public st_select_lex_node
   Item *where, *having;                         /* WHERE & HAVING clauses */
   Item *prep_where; /* saved WHERE clause for prepared statement processing */
   Item *prep_having;/* saved HAVING clause for prepared statement processing */
+  /*
+    Conditions of the embedding query pushed into this SELECT of a
+    materialized derived table/view, for the current execution only
+  */
+  Item *cond_pushed_into_where, *cond_pushed_into_having;
   /* Saved values of the WHERE and HAVING clauses*/
   Item::cond_result cond_value, having_value;
   /* point on lex in which it was created, used in view subquery detection */
@@ -750,6 +756,8 @@ class st_select_lex: public st_select_lex_node
   List<Item_func_match> *ftfunc_list;
   List<Item_func_match> ftfunc_list_alloc;
   JOIN *join; /* after JOIN::prepare it is pointer to corresponding JOIN */
+  /* Join order kept between executions of a prepared statement */
+  Join_plan_cache *plan_cache;
   List<TABLE_LIST> top_join_list; /* join list of the top level          */
   List<TABLE_LIST> *join_list;    /* list for the currently parsed join  */
   TABLE_LIST *embedding;          /* table embedding to the above list   */
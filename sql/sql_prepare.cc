@@ -2569,6 +2569,7 @@ void reinit_stmt_before_use(THD *thd, LEX *lex)
       }
       else
         sl->having= NULL;
+      sl->cond_pushed_into_where= sl->cond_pushed_into_having= NULL;
       DBUG_ASSERT(sl->join == 0);
       ORDER *order;
       /* Fix GROUP list */
@@ -223,7 +223,12 @@
 #define OPTIMIZER_SWITCH_TABLE_ELIMINATION         (1ULL << 26)
 #define OPTIMIZER_SWITCH_EXTENDED_KEYS             (1ULL << 27)
 #define OPTIMIZER_SWITCH_EXISTS_TO_IN              (1ULL << 28)
-#define OPTIMIZER_SWITCH_USE_CONDITION_SELECTIVITY (1ULL << 29)
+#define OPTIMIZER_SWITCH_COND_PUSHDOWN_FOR_DERIVED (1ULL << 29)
+#define OPTIMIZER_SWITCH_HASH_AGGREGATION          (1ULL << 30)
+#define OPTIMIZER_SWITCH_ROWID_FILTER              (1ULL << 31)
+#define OPTIMIZER_SWITCH_JOIN_CACHE_BLOOM_FILTER   (1ULL << 32)
+#define OPTIMIZER_SWITCH_JOIN_CACHE_READ_AHEAD     (1ULL << 33)
+#define OPTIMIZER_SWITCH_USE_CONDITION_SELECTIVITY (1ULL << 34)
 
 #define OPTIMIZER_SWITCH_DEFAULT   (OPTIMIZER_SWITCH_INDEX_MERGE | \
                                     OPTIMIZER_SWITCH_INDEX_MERGE_UNION | \
@@ -243,11 +248,14 @@
                                     OPTIMIZER_SWITCH_JOIN_CACHE_INCREMENTAL | \
                                     OPTIMIZER_SWITCH_JOIN_CACHE_HASHED | \
                                     OPTIMIZER_SWITCH_JOIN_CACHE_BKA | \
+                                    OPTIMIZER_SWITCH_JOIN_CACHE_BLOOM_FILTER | \
                                     OPTIMIZER_SWITCH_SUBQUERY_CACHE | \
                                     OPTIMIZER_SWITCH_SEMIJOIN | \
                                     OPTIMIZER_SWITCH_FIRSTMATCH | \
                                     OPTIMIZER_SWITCH_LOOSE_SCAN | \
-                                    OPTIMIZER_SWITCH_EXISTS_TO_IN)
+                                    OPTIMIZER_SWITCH_EXISTS_TO_IN | \
+                                    OPTIMIZER_SWITCH_COND_PUSHDOWN_FOR_DERIVED | \
+                                    OPTIMIZER_SWITCH_HASH_AGGREGATION)
 /*
   Replication uses 8 bytes to store SQL_MODE in the binary log. The day you
   use strictly more than 64 bits by adding one more define above, you should
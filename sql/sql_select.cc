@@ -87,6 +87,9 @@ void best_access_path(JOIN *join, JOIN_TAB *s,
                              bool disable_jbuf, double record_count,
                              POSITION *pos, POSITION *loose_scan_pos);
 static void optimize_straight_join(JOIN *join, table_map join_tables);
+static bool join_plan_cache_enabled(JOIN *join);
+static bool choose_cached_plan(JOIN *join, table_map join_tables);
+static void save_join_plan(JOIN *join);
 static bool greedy_search(JOIN *join, table_map remaining_tables,
                           uint depth, uint prune_level,
                           uint use_cond_selectivity);
@@ -170,6 +173,8 @@ static enum_nested_loop_state
 end_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records);
 static enum_nested_loop_state
 end_unique_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records);
+static enum_nested_loop_state
+end_hash_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records);
 
 static int test_if_group_changed(List<Cached_item> &list);
 static int join_read_const_table(JOIN_TAB *tab, POSITION *pos);
@@ -1082,6 +1087,23 @@ JOIN::optimize_inner()
   set_allowed_join_cache_types();
   need_distinct= TRUE;
 
+  /*
+    Push conditions into the materialized derived tables/views before they
+    are optimized. Conditions pushed into this SELECT are pushed further.
+  */
+  if (thd->lex->sql_command == SQLCOM_SELECT &&
+      optimizer_flag(thd, OPTIMIZER_SWITCH_COND_PUSHDOWN_FOR_DERIVED))
+  {
+    for (TABLE_LIST *tbl= select_lex->get_table_list(); tbl;
+         tbl= tbl->next_local)
+    {
+      if (pushdown_cond_for_derived(thd, conds, tbl) ||
+          pushdown_cond_for_derived(thd, select_lex->cond_pushed_into_where,
+                                    tbl))
+        DBUG_RETURN(1);
+    }
+  }
+
   /* Run optimize phase for all derived tables/views used in this SELECT. */
   if (select_lex->handle_derived(thd->lex, DT_OPTIMIZE))
     DBUG_RETURN(1);
@@ -1193,6 +1215,27 @@ TODO: make view to decide if it is possible to write to WHERE directly or make S
     if (arena)
       thd->restore_active_arena(arena, &backup);
   }
+
+  /*
+    Add the conditions pushed from the embedding SELECT. This is done after
+    prep_where is saved as they are valid for the current execution only.
+  */
+  if (select_lex->cond_pushed_into_where)
+  {
+    conds= and_items(conds, select_lex->cond_pushed_into_where);
+    select_lex->cond_pushed_into_where= NULL;
+    if (!conds || (!conds->fixed && conds->fix_fields(thd, &conds)))
+      DBUG_RETURN(1);
+    conds->top_level_item();
+  }
+  if (select_lex->cond_pushed_into_having)
+  {
+    having= and_items(having, select_lex->cond_pushed_into_having);
+    select_lex->cond_pushed_into_having= NULL;
+    if (!having || (!having->fixed && having->fix_fields(thd, &having)))
+      DBUG_RETURN(1);
+    having->top_level_item();
+  }
   
   if (setup_jtbm_semi_joins(this, join_list, &conds))
     DBUG_RETURN(1);
@@ -4063,8 +4106,21 @@ make_join_statistics(JOIN *join, List<TABLE_LIST> &tables_list,
     /* Find an optimal join order of the non-constant tables. */
     if (join->const_tables != join->table_count)
     {
-      if (choose_plan(join, all_table_map & ~join->const_table_map))
-        goto error;
+      bool use_plan_cache= join_plan_cache_enabled(join);
+
+      if (use_plan_cache &&
+          choose_cached_plan(join, all_table_map & ~join->const_table_map))
+        join->thd->status_var.stmt_plan_cache_hits++;
+      else
+      {
+        if (choose_plan(join, all_table_map & ~join->const_table_map))
+          goto error;
+        if (use_plan_cache)
+        {
+          join->thd->status_var.stmt_plan_cache_misses++;
+          save_join_plan(join);
+        }
+      }
     }
     else
     {
@@ -6539,6 +6595,176 @@ choose_plan(JOIN *join, table_map join_tables)
 }
 
 
+/**
+  Check whether the join order of this SELECT may be taken from or stored
+  in the plan cache of a prepared statement.
+*/
+
+static bool join_plan_cache_enabled(JOIN *join)
+{
+  THD *thd= join->thd;
+  return thd->variables.prepared_stmt_plan_cache &&
+         thd->stmt_arena->type() == Query_arena::PREPARED_STATEMENT &&
+         !(join->select_options & SELECT_STRAIGHT_JOIN);
+}
+
+
+/**
+  Describe what the join order search depends on for one table.
+*/
+
+static void get_plan_table_class(JOIN_TAB *s,
+                                 Join_plan_cache::Table_class *cls)
+{
+  cls->table= s->table->pos_in_table_list;
+  cls->quick_type= s->quick ? s->quick->get_type() : -1;
+  cls->quick_index= s->quick ? s->quick->index : MAX_KEY;
+  cls->rows_class= my_bit_log2((ulong) MY_MIN(s->found_records,
+                                              (ha_rows) ULONG_MAX));
+}
+
+
+/**
+  Check whether the cached join order can be used for the current
+  execution.
+
+  @retval true   the inputs of the join order search are in the same
+                 plan stability class as when the order was cached
+  @retval false  the join order must be searched for
+*/
+
+bool Join_plan_cache::matches(JOIN *join) const
+{
+  THD *thd= join->thd;
+
+  if (table_count != join->table_count ||
+      const_tables != join->const_tables ||
+      const_table_map != join->const_table_map ||
+      optimizer_switch != thd->variables.optimizer_switch ||
+      search_depth != thd->variables.optimizer_search_depth ||
+      prune_level != thd->variables.optimizer_prune_level ||
+      use_cond_selectivity !=
+        thd->variables.optimizer_use_condition_selectivity)
+    return false;
+
+  for (uint i= 0; i < table_count; i++)
+  {
+    Table_class cls;
+    get_plan_table_class(join->join_tab + i, &cls);
+    if (cls.table != tables[i].table ||
+        cls.quick_type != tables[i].quick_type ||
+        cls.quick_index != tables[i].quick_index ||
+        cls.rows_class != tables[i].rows_class)
+      return false;
+  }
+
+  /* Every table must still follow the tables it depends on */
+  table_map found_tables= const_table_map;
+  for (uint i= 0; i < table_count - const_tables; i++)
+  {
+    JOIN_TAB *s= join->join_tab + order[i];
+    if (s->dependent & ~found_tables)
+      return false;
+    found_tables|= s->table->map;
+  }
+  return true;
+}
+
+
+/**
+  Remember the join order in join->best_positions together with the
+  inputs of the search that produced it.
+
+  @param mem_root  memory of the prepared statement
+
+  @retval false  ok
+  @retval true   out of memory, nothing is cached
+*/
+
+bool Join_plan_cache::store(MEM_ROOT *mem_root, JOIN *join)
+{
+  THD *thd= join->thd;
+
+  if (table_count != join->table_count)
+  {
+    /* The tables of a SELECT only change on the first executions */
+    table_count= 0;
+    if (!(tables= (Table_class*) alloc_root(mem_root, sizeof(Table_class) *
+                                                      join->table_count)) ||
+        !(order= (uint*) alloc_root(mem_root, sizeof(uint) *
+                                              join->table_count)))
+      return true;
+    table_count= join->table_count;
+  }
+
+  const_tables= join->const_tables;
+  const_table_map= join->const_table_map;
+  optimizer_switch= thd->variables.optimizer_switch;
+  search_depth= thd->variables.optimizer_search_depth;
+  prune_level= thd->variables.optimizer_prune_level;
+  use_cond_selectivity= thd->variables.optimizer_use_condition_selectivity;
+
+  for (uint i= 0; i < table_count; i++)
+    get_plan_table_class(join->join_tab + i, tables + i);
+  for (uint i= const_tables; i < table_count; i++)
+    order[i - const_tables]= (uint) (join->best_positions[i].table -
+                                     join->join_tab);
+  return false;
+}
+
+
+/**
+  Take the join order of the non-constant tables from the plan cache of
+  the prepared statement and compute its cost.
+
+  @retval TRUE   join->best_positions and join->best_read are set
+  @retval FALSE  no usable join order is cached, choose_plan() must be
+                 called
+*/
+
+static bool choose_cached_plan(JOIN *join, table_map join_tables)
+{
+  Join_plan_cache *cache= join->select_lex->plan_cache;
+  DBUG_ENTER("choose_cached_plan");
+
+  if (!cache || !cache->matches(join))
+    DBUG_RETURN(FALSE);
+
+  join->cur_embedding_map= 0;
+  join->cur_dups_producing_tables= 0;
+  reset_nj_counters(join, join->join_list);
+  join->cur_sj_inner_tables= 0;
+
+  for (uint i= join->const_tables; i < join->table_count; i++)
+    join->best_ref[i]= join->join_tab + cache->order[i - join->const_tables];
+
+  /* Choose the access methods for the cached order */
+  optimize_straight_join(join, join_tables);
+
+  if (join->thd->lex->is_single_level_stmt())
+    join->thd->status_var.last_query_cost= join->best_read;
+  DBUG_RETURN(TRUE);
+}
+
+
+/**
+  Store the join order chosen by choose_plan() in the plan cache of the
+  prepared statement.
+*/
+
+static void save_join_plan(JOIN *join)
+{
+  SELECT_LEX *select_lex= join->select_lex;
+  MEM_ROOT *mem_root= join->thd->stmt_arena->mem_root;
+
+  if (!select_lex->plan_cache &&
+      !(select_lex->plan_cache= new (mem_root) Join_plan_cache))
+    return;
+  /* Out of memory only means that the order is searched for next time */
+  select_lex->plan_cache->store(mem_root, join);
+}
+
+
 /*
   Compare two join tabs based on the subqueries they are from.
    - top-level join tabs go first
@@ -10984,6 +11210,84 @@ void JOIN_TAB::remove_redundant_bnl_scan_conds()
 }
 
 
+/**
+  Choose a rowid filter for a table that is read with ref access
+
+  @param tab  the table, after the join buffering for it has been chosen
+
+  @details
+  The range optimizer has estimated the rows in the ranges over every
+  index that the conditions on the table alone allow (TABLE::quick_keys).
+  A range over another index than the one of ref access can filter the
+  index entries of ref access before their rows are read.  Collecting the
+  rowids of the range costs an index-only scan and a sort.  It saves the
+  read of the row for the index entries that are not in the range, and
+  costs a binary search for every index entry.  The index with the biggest
+  gain is used if the gain is positive and its rowids take no more than
+  max_rowid_filter_size bytes.
+
+  The ranges are built again from the condition attached to the table,
+  so the filter only drops rows that the condition would drop.
+
+  @note
+  This is done after the join order is fixed and does not change it.
+*/
+
+static void choose_rowid_filter(JOIN_TAB *tab)
+{
+  TABLE *table= tab->table;
+  THD *thd= tab->join->thd;
+  handler *file= table->file;
+  uint best_key= MAX_KEY;
+  double best_gain= 0.0;
+  DBUG_ENTER("choose_rowid_filter");
+
+  if (!optimizer_flag(thd, OPTIMIZER_SWITCH_ROWID_FILTER) ||
+      tab->type != JT_REF || !tab->select_cond ||
+      !(file->ha_table_flags() & HA_DO_ROWID_FILTER_PUSHDOWN) ||
+      table->maybe_null || table->is_filled_at_execution() ||
+      (table->pos_in_table_list && table->pos_in_table_list->updating))
+    DBUG_VOID_RETURN;
+
+  /* Index entries read by ref access during the join */
+  double entries= tab->partial_join_cardinality;
+  double table_rows= rows2double(table->stat_records());
+
+  for (uint key= 0; key < table->s->keys; key++)
+  {
+    if (key == (uint) tab->ref.key || !table->quick_keys.is_set(key) ||
+        (table->key_info[key].flags & (HA_SPATIAL | HA_FULLTEXT)))
+      continue;
+    double rows= rows2double(table->quick_rows[key]);
+    if (rows >= table_rows ||
+        rows * file->ref_length > thd->variables.max_rowid_filter_size)
+      continue;
+    double cmp_cost= log(rows + 1) / (TIME_FOR_COMPARE_ROWID * M_LN2);
+    double build_cost= file->keyread_time(key, table->quick_n_ranges[key],
+                                          table->quick_rows[key]) +
+                       rows * cmp_cost;
+    double gain= entries * (1.0 - rows / table_rows - cmp_cost) - build_cost;
+    DBUG_PRINT("info", ("key: %u  rows: %g  gain: %g", key, rows, gain));
+    if (gain > best_gain)
+    {
+      best_gain= gain;
+      best_key= key;
+    }
+  }
+  if (best_key == MAX_KEY)
+    DBUG_VOID_RETURN;
+
+  QUICK_RANGE_SELECT *quick;
+  if ((quick= get_quick_select_for_rowid_filter(thd, table, best_key,
+                                                tab->select_cond,
+                                                tab->join->const_table_map)) &&
+      !(tab->rowid_filter=
+          new Rowid_filter(quick, thd->variables.max_rowid_filter_size)))
+    delete quick;
+  DBUG_VOID_RETURN;
+}
+
+
 /*
   Plan refinement stage: do various setup things for the executor
 
@@ -11133,7 +11437,12 @@ make_join_readinfo(JOIN *join, ulonglong options, uint no_jbuf_after)
 	  !table->no_keyread)
         table->enable_keyread();
       else if ((!jcl || jcl > 4) && !tab->ref.is_access_triggered())
+      {
+        /* The filter is not checked for the lookups of BKA */
+        if (!jcl)
+          choose_rowid_filter(tab);
         push_index_cond(tab, tab->ref.key);
+      }
       break;
     case JT_ALL:
     case JT_HASH:
@@ -11364,6 +11673,12 @@ void JOIN_TAB::cleanup()
   {
     table->disable_keyread();
     table->file->ha_index_or_rnd_end();
+    if (rowid_filter)
+    {
+      table->file->cancel_pushed_rowid_filter();
+      delete rowid_filter;
+      rowid_filter= 0;
+    }
     preread_init_done= FALSE;
     if (table->pos_in_table_list && 
         table->pos_in_table_list->jtbm_subselect)
@@ -15836,6 +16151,7 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
   ulong reclength, string_total_length;
   bool  using_unique_constraint= 0;
   bool  use_packed_rows= 0;
+  bool  heap_blobs;
   bool  not_all_columns= !(select_options & TMP_TABLE_ALL_COLUMNS);
   char  *tmpname,path[FN_REFLEN];
   uchar	*pos, *group_buff, *bitmaps;
@@ -16209,9 +16525,23 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
   share->fields= field_count;
   share->column_bitmap_size= bitmap_buffer_size(share->fields);
 
+  /*
+    MEMORY tables with dynamic rows can store blobs that are not part of
+    the group or distinct key.
+  */
+  heap_blobs= (blob_count && thd->variables.tmp_table_dynamic_rows &&
+               !using_unique_constraint &&
+               !(distinct && field_count != param->hidden_field_count));
+  for (ORDER *tmp= group; heap_blobs && tmp; tmp= tmp->next)
+  {
+    Field *field= (*tmp->item)->get_tmp_table_field();
+    if (!field || (field->flags & BLOB_FLAG))
+      heap_blobs= FALSE;
+  }
+
   /* If result table is small; use a heap */
   /* future: storage engine selection can be made dynamic? */
-  if (blob_count || using_unique_constraint
+  if ((blob_count && !heap_blobs) || using_unique_constraint
       || (thd->variables.big_tables && !(select_options & SELECT_SMALL_RESULT))
       || (select_options & TMP_TABLE_FORCE_MYISAM)
       || thd->variables.tmp_table_size == 0)
@@ -16266,6 +16596,9 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
     use_packed_rows= 1;
 
   share->reclength= reclength;
+  if (use_packed_rows && share->db_type() == heap_hton &&
+      thd->variables.tmp_table_dynamic_rows)
+    share->row_type= ROW_TYPE_DYNAMIC;
   {
     uint alloc_length=ALIGN_SIZE(reclength+MI_UNIQUE_HASH_LENGTH+1);
     share->rec_buff_length= alloc_length;
@@ -16381,7 +16714,8 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
   param->recinfo= recinfo;              	// Pointer to after last field
   store_record(table,s->default_values);        // Make empty default record
 
-  if (thd->variables.tmp_table_size == ~ (ulonglong) 0)		// No limit
+  if (thd->variables.tmp_table_size == ~ (ulonglong) 0 ||	// No limit
+      share->row_type == ROW_TYPE_DYNAMIC)     // Size is limited by engine
     share->max_rows= ~(ha_rows) 0;
   else
     share->max_rows= (ha_rows) (((share->db_type() == heap_hton) ?
@@ -17392,7 +17726,13 @@ Next_select_func setup_end_select_func(JOIN *join)
     if (table->group && tmp_tbl->sum_func_count && 
         !tmp_tbl->precomputed_group_by)
     {
-      if (table->s->keys)
+      if (table->s->keys && !table->s->blob_fields &&
+          optimizer_flag(join->thd, OPTIMIZER_SWITCH_HASH_AGGREGATION))
+      {
+        DBUG_PRINT("info",("Using end_hash_update"));
+        end_select=end_hash_update;
+      }
+      else if (table->s->keys)
       {
 	DBUG_PRINT("info",("Using end_update"));
 	end_select=end_update;
@@ -17486,6 +17826,9 @@ do_select(JOIN *join,List<Item> *fields,TABLE *table,Procedure *procedure)
   }
   /* Set up select_end */
   Next_select_func end_select= setup_end_select_func(join);
+  if (end_select == end_hash_update &&
+      join->hash_agg.init(table, &join->tmp_table_param))
+    DBUG_RETURN(-1);
   if (join->table_count)
   {
     join->join_tab[join->top_join_tab_count - 1].next_select= end_select;
@@ -17557,6 +17900,8 @@ do_select(JOIN *join,List<Item> *fields,TABLE *table,Procedure *procedure)
   }
 
   join->thd->limit_found_rows= join->send_records;
+  /* Free the groups that were not flushed because of an error */
+  join->hash_agg.cleanup();
 
   if (error == NESTED_LOOP_NO_MORE_ROWS || join->thd->killed == ABORT_QUERY)
     error= NESTED_LOOP_OK;
@@ -18594,6 +18939,42 @@ join_read_key_unlock_row(st_join_table *tab)
     tab->ref.use_count--;
 }
 
+/**
+  Push the rowid filter of a table into the engine and build it before the
+  first read of the table with ref access
+
+  @details
+  The filter is built only if the engine accepts it, so that the range is
+  not scanned for nothing.  A filter that turns out to be too big is taken
+  back from the engine.
+*/
+
+static int
+init_rowid_filter(JOIN_TAB *tab)
+{
+  Rowid_filter *filter= tab->rowid_filter;
+  handler *file= tab->table->file;
+  int error;
+
+  if (filter->is_built())
+    return 0;
+  if (file->rowid_filter_push(tab->ref.key, filter))
+  {
+    filter->set_not_usable();
+    return 0;
+  }
+  if ((error= filter->build()))
+  {
+    file->cancel_pushed_rowid_filter();
+    (void) report_error(tab->table, error);
+    return 1;
+  }
+  if (!filter->is_usable())
+    file->cancel_pushed_rowid_filter();
+  return 0;
+}
+
+
 /*
   ref access method implementation: "read_first" function
 
@@ -18622,6 +19003,8 @@ join_read_always_key(JOIN_TAB *tab)
   /* Initialize the index first */
   if (!table->file->inited)
   {
+    if (tab->rowid_filter && init_rowid_filter(tab))
+      return 1;
     if ((error= table->file->ha_index_init(tab->ref.key, tab->sorted)))
     {
       (void) report_error(table, error);
@@ -18660,11 +19043,15 @@ join_read_last_key(JOIN_TAB *tab)
   int error;
   TABLE *table= tab->table;
 
-  if (!table->file->inited &&
-      (error= table->file->ha_index_init(tab->ref.key, tab->sorted)))
+  if (!table->file->inited)
   {
-    (void) report_error(table, error);
-    return 1;
+    if (tab->rowid_filter && init_rowid_filter(tab))
+      return 1;
+    if ((error= table->file->ha_index_init(tab->ref.key, tab->sorted)))
+    {
+      (void) report_error(table, error);
+      return 1;
+    }
   }
 
   if (cp_buffer_from_ref(tab->join->thd, table, &tab->ref))
@@ -19285,22 +19672,14 @@ end_write(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
     Also applies HAVING, etc.
 */
 
-static enum_nested_loop_state
-end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
-	   bool end_of_records)
-{
-  TABLE *table=join->tmp_table;
-  ORDER   *group;
-  int	  error;
-  DBUG_ENTER("end_update");
-
-  if (end_of_records)
-    DBUG_RETURN(NESTED_LOOP_OK);
+/**
+  Make a key of the group index of a grouping temporary table from the
+  values of the current row
+*/
 
-  join->found_records++;
-  copy_fields(&join->tmp_table_param);		// Groups are copied twice.
-  /* Make a key of group index */
-  for (group=table->group ; group ; group=group->next)
+static void make_group_key(TABLE *table)
+{
+  for (ORDER *group=table->group ; group ; group=group->next)
   {
     Item *item= *group->item;
     if (group->fast_field_copier_setup != group->field)
@@ -19317,6 +19696,23 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
     if (item->maybe_null)
       group->buff[-1]= (char) group->field->is_null();
   }
+}
+
+
+static enum_nested_loop_state
+end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
+	   bool end_of_records)
+{
+  TABLE *table=join->tmp_table;
+  int	  error;
+  DBUG_ENTER("end_update");
+
+  if (end_of_records)
+    DBUG_RETURN(NESTED_LOOP_OK);
+
+  join->found_records++;
+  copy_fields(&join->tmp_table_param);		// Groups are copied twice.
+  make_group_key(table);
   if (!table->file->ha_index_read_map(table->record[1],
                                       join->tmp_table_param.group_buff,
                                       HA_WHOLE_KEY,
@@ -19363,6 +19759,67 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 }
 
 
+/**
+  @brief
+    Perform a GROUP BY operation over rows coming in arbitrary order,
+    keeping the groups in a hash table in memory.
+
+  @detail
+    Like end_update, but the rows of the groups are looked up and updated
+    in JOIN::hash_agg and written into the temporary table at the end.
+    When the groups do not fit in memory, some hash partitions are moved
+    into the temporary table on disk, and the rows that belong to them are
+    grouped there as by end_unique_update.
+*/
+
+static enum_nested_loop_state
+end_hash_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
+{
+  TABLE *table=join->tmp_table;
+  Hash_aggregation *hash_agg= &join->hash_agg;
+  uchar *rec;
+  ulong hash;
+  DBUG_ENTER("end_hash_update");
+
+  if (end_of_records)
+  {
+    if (hash_agg->flush())
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    DBUG_RETURN(NESTED_LOOP_OK);
+  }
+
+  join->found_records++;
+  copy_fields(&join->tmp_table_param);		// Groups are copied twice.
+  make_group_key(table);
+  hash= hash_agg->hash_key();
+  if (hash_agg->is_spilled(hash))
+    DBUG_RETURN(end_unique_update(join, join_tab, end_of_records));
+
+  if ((rec= hash_agg->find(hash)))
+  {						/* Update old group */
+    memcpy(table->record[0], rec, table->s->reclength);
+    update_tmptable_sum_func(join->sum_funcs,table);
+    memcpy(rec, table->record[0], table->s->reclength);
+  }
+  else
+  {
+    init_tmptable_sum_functions(join->sum_funcs);
+    if (copy_funcs(join->tmp_table_param.items_to_copy, join->thd))
+      DBUG_RETURN(NESTED_LOOP_ERROR);           /* purecov: inspected */
+    if (!hash_agg->add(hash) ||
+        (hash_agg->is_full() && hash_agg->spill()))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    join->send_records++;
+  }
+  if (join->thd->check_killed())
+  {
+    join->thd->send_kill_message();
+    DBUG_RETURN(NESTED_LOOP_KILLED);             /* purecov: inspected */
+  }
+  DBUG_RETURN(NESTED_LOOP_OK);
+}
+
+
 /** Like end_update, but this is done with unique constraints instead of keys.  */
 
 static enum_nested_loop_state
@@ -20794,6 +21251,8 @@ create_sort_index(THD *thd, JOIN *join, ORDER *order,
   JOIN_TAB *tab;
   int err= 0;
   bool quick_created= FALSE;
+  Explain_select *xpl_sel;
+  Filesort_tracker *fs_tracker= NULL;
   DBUG_ENTER("create_sort_index");
 
   if (join->table_count == join->const_tables)
@@ -20927,9 +21386,12 @@ create_sort_index(THD *thd, JOIN *join, ORDER *order,
 
   if (table->s->tmp_table)
     table->file->info(HA_STATUS_VARIABLE);	// Get record count
+  if (join->select_lex->select_number != INT_MAX && thd->lex->explain &&
+      (xpl_sel= thd->lex->explain->get_select(join->select_lex->select_number)))
+    fs_tracker= &xpl_sel->filesort_tracker;
   filesort_retval= filesort(thd, table, join->sortorder, length,
                             select, filesort_limit, 0,
-                            &examined_rows, &found_rows);
+                            &examined_rows, &found_rows, fs_tracker);
   table->sort.found_records= filesort_retval;
   tab->records= found_rows;                     // For SQL_CALC_ROWS
 
@@ -23685,6 +24147,13 @@ void JOIN_TAB::save_explain_data(Explain_table_access *eta, table_map prefix_tab
     else if (tab->cache_idx_cond)
       eta->push_extra(ET_USING_INDEX_CONDITION_BKA);
 
+    if (tab->rowid_filter && tab->type == JT_REF)
+    {
+      eta->push_extra(ET_USING_ROWID_FILTER);
+      eta->rowid_filter_key.append(
+        table->key_info[tab->rowid_filter->get_key()].name);
+    }
+
     if (quick_type == QUICK_SELECT_I::QS_TYPE_ROR_UNION || 
         quick_type == QUICK_SELECT_I::QS_TYPE_ROR_INTERSECT ||
         quick_type == QUICK_SELECT_I::QS_TYPE_INDEX_INTERSECT ||
@@ -210,6 +210,11 @@ typedef struct st_join_table {
   COND          *on_precond;    /**< part of on condition to check before
 				     accessing the first inner table           */  
   QUICK_SELECT_I *quick;
+  /*
+    Filter of the rowids in a range over another index that is checked by
+    the engine before it reads the rows of ref access, or NULL
+  */
+  Rowid_filter *rowid_filter;
   /* 
     The value of select_cond before we've attempted to do Index Condition
     Pushdown. We may need to restore everything back if we first choose one
@@ -568,6 +573,7 @@ typedef struct st_join_table {
 
 
 #include "sql_join_cache.h"
+#include "sql_hash_agg.h"
 
 enum_nested_loop_state sub_select_cache(JOIN *join, JOIN_TAB *join_tab, bool
                                         end_of_records);
@@ -881,6 +887,48 @@ class JOIN_TAB_RANGE: public Sql_alloc
 };
 
 
+/*
+  The join order chosen for a SELECT of a prepared statement, kept on the
+  statement arena between executions (see prepared_stmt_plan_cache).
+
+  A later execution skips the join order search and only costs the cached
+  order with optimize_straight_join() when the inputs of the search fall
+  in the same plan stability class: the same constant tables, the same
+  index for range access of every table, row estimates of the same power
+  of two and the same optimizer settings. Range analysis still runs on
+  every execution, because its result depends on the parameter values.
+  A change of table metadata makes the statement be reprepared, which
+  discards the SELECT_LEX together with its cache.
+*/
+
+class Join_plan_cache :public Sql_alloc
+{
+public:
+  /* What the join order search depends on, for one JOIN::join_tab entry */
+  struct Table_class
+  {
+    TABLE_LIST *table;
+    int quick_type;                   /* QUICK_SELECT_I::get_type() or -1 */
+    uint quick_index;                 /* QUICK_SELECT_I::index */
+    uint rows_class;                  /* bits in the row estimate */
+  };
+
+  Join_plan_cache() :table_count(0), tables(0), order(0) {}
+  bool matches(JOIN *join) const;
+  bool store(MEM_ROOT *mem_root, JOIN *join);
+
+  uint table_count;
+  uint const_tables;
+  table_map const_table_map;
+  ulonglong optimizer_switch;
+  ulong search_depth;
+  ulong prune_level;
+  ulong use_cond_selectivity;
+  Table_class *tables;                /* in the order of JOIN::join_tab */
+  uint *order;                        /* join_tab indexes in join order */
+};
+
+
 class JOIN :public Sql_alloc
 {
 private:
@@ -1197,6 +1245,7 @@ class JOIN :public Sql_alloc
   */
   JOIN *tmp_join;
   ROLLUP rollup;				///< Used with rollup
+  Hash_aggregation hash_agg;                    ///< Used by end_hash_update
   
   bool mixed_implicit_grouping;
   bool select_distinct;				///< Set if SELECT DISTINCT
@@ -1863,7 +1912,7 @@ Item_equal *find_item_equal(COND_EQUAL *cond_equal, Field *field,
 extern bool test_if_ref(Item *, 
                  Item_field *left_item,Item *right_item);
 
-inline bool optimizer_flag(THD *thd, uint flag)
+inline bool optimizer_flag(THD *thd, ulonglong flag)
 { 
   return (thd->variables.optimizer_switch & flag);
 }
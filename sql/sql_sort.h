@@ -27,6 +27,8 @@ typedef struct st_sort_field SORT_FIELD;
 
 class Field;
 struct TABLE;
+class Filesort_tracker;
+class Filesort_workers;
 
 /* Defines used by filesort and uniques */
 
@@ -84,6 +86,9 @@ class Sort_param {
   uchar *unique_buff;
   bool not_killable;
   char* tmp_buffer;
+  uint sort_threads;          // Max threads for sorting the buffer.
+  Filesort_workers *workers;  // Helper threads, or NULL.
+  Filesort_tracker *tracker;  // Where to report threads used, or NULL.
   // The fields below are used only by Unique class.
   qsort2_cmp compare;
   BUFFPEK_COMPARE_CONTEXT cmp_context;
@@ -2361,6 +2361,11 @@ export const char *optimizer_switch_names[]=
   "table_elimination",
   "extended_keys",
   "exists_to_in",
+  "condition_pushdown_for_derived",
+  "hash_aggregation",
+  "rowid_filter",
+  "join_cache_bloom_filter",
+  "join_cache_read_ahead",
   "default", NullS
 };
 static bool fix_optimizer_switch(sys_var *self, THD *thd,
@@ -2409,6 +2414,19 @@ static Sys_var_ulong Sys_preload_buff_size(
        SESSION_VAR(preload_buff_size), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(1024, 1024*1024*1024), DEFAULT(32768), BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_prepared_stmt_plan_cache(
+       "prepared_stmt_plan_cache",
+       "Reuse the join order chosen for a SELECT of a prepared statement "
+       "on later executions of the statement, as long as the constant "
+       "tables, the indexes used for range access, the magnitude of the "
+       "row estimates and the optimizer settings stay the same. Only the "
+       "join order search is skipped. Range analysis and constant table "
+       "detection still run on every execution, so statements that read "
+       "a single table or only constant tables, such as point lookups, do "
+       "not get faster",
+       SESSION_VAR(prepared_stmt_plan_cache), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_uint Sys_protocol_version(
        "protocol_version",
        "The version of the client/server protocol used by the MySQL server",
@@ -2736,6 +2754,18 @@ static Sys_var_ulonglong Sys_query_cache_size(
        NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(check_query_cache_size),
        ON_UPDATE(fix_query_cache_size));
 
+static Sys_var_uint Sys_query_cache_partitions(
+       "query_cache_partitions",
+       "Number of independent partitions of the query cache. Queries are "
+       "assigned to partitions by hashing the query text, each partition "
+       "has its own lock and an equal share of query_cache_size. Values "
+       "above 1 reduce lock contention with many concurrent clients. "
+       "Invalidation of a table locks every partition that has cached "
+       "queries on the table, so while it runs, hits on any table in "
+       "those partitions wait",
+       READ_ONLY GLOBAL_VAR(query_cache_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, QUERY_CACHE_MAX_PARTITIONS), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_query_cache_limit(
        "query_cache_limit",
        "Don't cache results that are bigger than this",
@@ -2959,6 +2989,14 @@ static Sys_var_ulong Sys_slow_launch_time(
        GLOBAL_VAR(slow_launch_time), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, LONG_TIMEOUT), DEFAULT(2), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_filesort_threads(
+       "filesort_threads",
+       "Maximum number of threads a single filesort may use to sort its "
+       "buffer. The buffer is split into chunks that are sorted and merged "
+       "in parallel; 1 disables parallel sorting",
+       SESSION_VAR(filesort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_FILESORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulonglong Sys_sort_buffer(
        "sort_buffer_size",
        "Each thread that needs to do a sort allocates a buffer of this size",
@@ -3279,6 +3317,14 @@ static Sys_var_uint Sys_threadpool_stall_limit(
   NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0), 
   ON_UPDATE(fix_threadpool_stall_limit)
 );
+static Sys_var_mybool Sys_threadpool_work_stealing(
+ "thread_pool_work_stealing",
+ "If enabled, idle worker threads take queued requests from other "
+ "thread groups that have no idle threads, instead of waiting for "
+ "work in their own group.",
+  GLOBAL_VAR(threadpool_work_stealing), CMD_LINE(OPT_ARG),
+  DEFAULT(FALSE)
+);
 #endif /* !WIN32 */
 static Sys_var_uint Sys_threadpool_max_threads(
   "thread_pool_max_threads",
@@ -3357,6 +3403,13 @@ static Sys_var_ulonglong Sys_tmp_table_size(
        VALID_RANGE(1024, (ulonglong)~(intptr)0), DEFAULT(16*1024*1024),
        BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_tmp_table_dynamic_rows(
+       "tmp_table_dynamic_rows",
+       "Use variable-length rows for in-memory internal temporary tables. "
+       "VARCHAR columns are stored with their actual length and tables with "
+       "BLOB columns that are not part of the key are not created on disk",
+       SESSION_VAR(tmp_table_dynamic_rows), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_mybool Sys_timed_mutexes(
        "timed_mutexes",
        "Specify whether to time mutexes. Deprecated, has no effect.",
@@ -5064,12 +5117,29 @@ static Sys_var_ulong Sys_join_cache_level(
        SESSION_VAR(join_cache_level), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, 8), DEFAULT(2), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_join_cache_spill_partitions(
+       "join_cache_spill_partitions",
+       "If not 0, a hashed join buffer that is not linked to other join "
+       "buffers writes the records that do not fit into it to that many "
+       "partitions on disk instead of rescanning the joined table for every "
+       "refill of the buffer",
+       SESSION_VAR(join_cache_spill_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 64), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_mrr_buffer_size(
        "mrr_buffer_size",
        "Size of buffer to use when using MRR with range access",
        SESSION_VAR(mrr_buff_size), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(IO_SIZE*2, INT_MAX32), DEFAULT(256*1024), BLOCK_SIZE(1));
 
+static Sys_var_ulonglong Sys_max_rowid_filter_size(
+       "max_rowid_filter_size",
+       "The maximum size of the sorted rowid set of a rowid filter. A range "
+       "with more rows is not used as a filter",
+       SESSION_VAR(max_rowid_filter_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1024, (ulonglong)~(intptr)0), DEFAULT(128*1024),
+       BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_rowid_merge_buff_size(
        "rowid_merge_buff_size",
        "The size of the buffers used [NOT] IN evaluation via partial matching",
@@ -5091,6 +5161,15 @@ static Sys_var_mybool Sys_binlog_annotate_row_events(
        SESSION_VAR(binlog_annotate_row_events), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
 
+static Sys_var_mybool Sys_binlog_write_set(
+       "binlog_write_set",
+       "Log hashes of the unique keys of the rows changed by a transaction "
+       "(its write-set) in the GTID event. A slave in optimistic or "
+       "aggressive parallel mode uses them to not run conflicting "
+       "transactions in parallel. Needs binlog_format=ROW",
+       SESSION_VAR(binlog_write_set), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 #ifdef HAVE_REPLICATION
 static Sys_var_mybool Sys_replicate_annotate_row_events(
        "replicate_annotate_row_events",
@@ -23,6 +23,7 @@ extern uint threadpool_max_size;
 extern uint threadpool_stall_limit;  /* time interval in 10 ms units for stall checks*/
 extern uint threadpool_max_threads;  /* Maximum threads in pool */
 extern uint threadpool_oversubscribe;  /* Maximum active threads in group */
+extern my_bool threadpool_work_stealing; /* Idle workers take events from busy groups */
 
 
 
@@ -69,3 +70,9 @@ extern void tp_scheduler(void);
 
 extern int show_threadpool_idle_threads(THD *thd, SHOW_VAR *var, char *buff,
                                         enum enum_var_type scope);
+
+#ifndef _WIN32
+/* Used in SHOW for threadpool_steals (per-group counters) */
+extern int show_threadpool_steals(THD *thd, SHOW_VAR *var, char *buff,
+                                  enum enum_var_type scope);
+#endif
@@ -100,6 +100,7 @@ struct worker_thread_t
   
   mysql_cond_t  cond;
   bool          woken;
+  bool          steal; /* woken by wake_thief() */
 };
 
 typedef I_P_List<worker_thread_t, I_P_List_adapter<worker_thread_t,
@@ -113,6 +114,11 @@ struct connection_t
 
   THD *thd;
   thread_group_t *thread_group;
+  /*
+    Group of the worker thread that handles the current event. Differs
+    from thread_group if the event was stolen by a worker of another group.
+  */
+  thread_group_t *worker_group;
   connection_t *next_in_queue;
   connection_t **prev_in_queue;
   ulonglong abs_wait_timeout;
@@ -144,6 +150,8 @@ struct thread_group_t
   int io_event_count;
   int queue_event_count;
   ulonglong last_thread_creation_time;
+  /* Number of events taken from other groups' queues by our workers */
+  ulonglong steal_count;
   int  shutdown_pipe[2];
   bool shutdown;
   bool stalled;
@@ -184,6 +192,8 @@ static void connection_abort(connection_t *connection);
 static void set_wait_timeout(connection_t *connection);
 static void set_next_timeout_check(ulonglong abstime);
 static void print_pool_blocked_message(bool);
+static connection_t *queue_steal(thread_group_t *thread_group);
+static bool wake_thief(thread_group_t *thread_group);
 
 /**
  Asynchronous network IO.
@@ -594,7 +604,12 @@ void check_stall(thread_group_t *thread_group)
   if (!thread_group->queue.is_empty() && !thread_group->queue_event_count)
   {
     thread_group->stalled= true;
-    wake_or_create_thread(thread_group);
+    /*
+      With work stealing, prefer to let an idle worker from another group
+      drain the queue, rather than to create yet another thread here.
+    */
+    if (!wake_thief(thread_group))
+      wake_or_create_thread(thread_group);
   }
   
   /* Reset queue event count */
@@ -710,6 +725,9 @@ static connection_t * listener(worker_thread_t *current_thread,
     */
     
     bool listener_picks_event= thread_group->queue.is_empty();
+    /* Queue every event, so that a test can make a group stall */
+    DBUG_EXECUTE_IF("threadpool_listener_queues_events",
+                    listener_picks_event= false;);
     
     /* 
       If listener_picks_event is set, listener thread will handle first event, 
@@ -1028,6 +1046,110 @@ static void queue_put(thread_group_t *thread_group, connection_t *connection)
 }
 
 
+/**
+  Take an event from the queue of another, busy group.
+
+  Used by a worker that has nothing to do in its own group, before it goes
+  to sleep. Only groups that have queued events but no idle worker to
+  handle them are considered, so we never take work from a group that can
+  serve it itself.
+
+  The caller holds the mutex of its own group, mutexes of other groups are
+  only try-locked, thus there is no lock order problem.
+
+  @return connection with pending event, or NULL if nothing was stolen
+*/
+
+static connection_t *queue_steal(thread_group_t *thread_group)
+{
+  DBUG_ENTER("queue_steal");
+  uint count= group_count;
+
+  if (!threadpool_work_stealing || count < 2)
+    DBUG_RETURN(NULL);
+
+  uint start= (uint)(thread_group - all_groups);
+  for (uint i= 1; i <= count; i++)
+  {
+    thread_group_t *victim= &all_groups[(start + i) % count];
+    if (victim == thread_group)
+      continue;
+
+    /* Dirty check first, to avoid touching mutexes of idle groups. */
+    if (victim->queue.is_empty() || !victim->waiting_threads.is_empty())
+      continue;
+
+    if (mysql_mutex_trylock(&victim->mutex) != 0)
+      continue;
+
+    connection_t *connection= NULL;
+    if (!victim->shutdown && victim->waiting_threads.is_empty())
+    {
+      connection= queue_get(victim);
+      if (connection)
+        victim->stalled= false;
+    }
+    mysql_mutex_unlock(&victim->mutex);
+
+    if (connection)
+    {
+      thread_group->steal_count++;
+      DBUG_RETURN(connection);
+    }
+  }
+  DBUG_RETURN(NULL);
+}
+
+
+/**
+  Wake an idle worker in some other group, so it can steal events
+  from the stalled group.
+
+  Called by the timer with thread_group's mutex held. Mutexes of other
+  groups are only try-locked.
+
+  @return true if a worker was woken
+*/
+
+static bool wake_thief(thread_group_t *thread_group)
+{
+  uint count= group_count;
+
+  /*
+    queue_steal() leaves the queue of a group with idle workers alone,
+    the group wakes one of its own.
+  */
+  if (!threadpool_work_stealing || count < 2 ||
+      !thread_group->waiting_threads.is_empty())
+    return false;
+
+  uint start= (uint)(thread_group - all_groups);
+  for (uint i= 1; i <= count; i++)
+  {
+    thread_group_t *group= &all_groups[(start + i) % count];
+    if (group == thread_group || group->waiting_threads.is_empty())
+      continue;
+
+    if (mysql_mutex_trylock(&group->mutex) != 0)
+      continue;
+
+    worker_thread_t *thread= NULL;
+    if (!group->shutdown && group->queue.is_empty())
+      thread= group->waiting_threads.front();
+    if (thread)
+    {
+      /* Steal before becoming the listener of its own group */
+      thread->steal= true;
+      wake_thread(group);
+    }
+    mysql_mutex_unlock(&group->mutex);
+    if (thread)
+      return true;
+  }
+  return false;
+}
+
+
 /* 
   Prevent too many threads executing at the same time,if the workload is 
   not CPU bound.
@@ -1080,6 +1202,14 @@ connection_t *get_event(worker_thread_t *current_thread,
       connection = queue_get(thread_group);
       if(connection)
         break;
+
+      if (current_thread->steal)
+      {
+        current_thread->steal= false;
+        connection= queue_steal(thread_group);
+        if (connection)
+          break;
+      }
     }
 
     /* If there is  currently no listener in the group, become one. */
@@ -1111,6 +1241,11 @@ connection_t *get_event(worker_thread_t *current_thread,
         connection = (connection_t *)native_event_get_userdata(&nev);
         break;
       }
+
+      /* Help out other groups that have more work than threads. */
+      connection= queue_steal(thread_group);
+      if (connection)
+        break;
     }
 
     /* And now, finally sleep */ 
@@ -1211,6 +1346,7 @@ connection_t *alloc_connection(THD *thd)
   if (connection)
   {
     connection->thd = thd;
+    connection->worker_group= NULL;
     connection->waiting= false;
     connection->logged_in= false;
     connection->bound_to_poll_descriptor= false;
@@ -1294,7 +1430,7 @@ void tp_wait_begin(THD *thd, int type)
   {
     DBUG_ASSERT(!connection->waiting);
     connection->waiting= true;
-    wait_begin(connection->thread_group);
+    wait_begin(connection->worker_group);
   }
   DBUG_VOID_RETURN;
 }
@@ -1314,7 +1450,7 @@ void tp_wait_end(THD *thd)
   {
     DBUG_ASSERT(connection->waiting);
     connection->waiting = false;
-    wait_end(connection->thread_group);
+    wait_end(connection->worker_group);
   }
   DBUG_VOID_RETURN;
 }
@@ -1482,6 +1618,7 @@ static void *worker_main(void *param)
   mysql_cond_init(key_worker_cond, &this_thread.cond, NULL);
   this_thread.thread_group= thread_group;
   this_thread.event_count=0;
+  this_thread.steal= false;
 
   /* Run event loop */
   for(;;)
@@ -1493,6 +1630,7 @@ static void *worker_main(void *param)
     if (!connection)
       break;
     this_thread.event_count++;
+    connection->worker_group= thread_group;
     handle_event(connection);
   }
 
@@ -1628,6 +1766,42 @@ int tp_get_idle_thread_count()
 }
 
 
+/**
+  SHOW STATUS callback for Threadpool_steals.
+
+  Returns an array with one counter per active thread group,
+  shown as Threadpool_steals_<group number>.
+*/
+
+int show_threadpool_steals(THD *thd, SHOW_VAR *var, char *buff,
+                           enum enum_var_type scope)
+{
+  uint count= threadpool_started ? group_count : 0;
+  SHOW_VAR *vars= (SHOW_VAR *) thd->alloc(sizeof(SHOW_VAR) * (count + 1));
+
+  var->type= SHOW_ARRAY;
+  var->value= (char *) vars;
+  if (!vars)
+  {
+    /* Out of memory: show nothing rather than fail SHOW STATUS */
+    var->value= buff;
+    ((SHOW_VAR *) buff)->name= 0;
+    return 0;
+  }
+
+  for (uint i= 0; i < count; i++)
+  {
+    char name[16];
+    my_snprintf(name, sizeof(name), "%u", i);
+    vars[i].name= thd->strdup(name);
+    vars[i].value= (char *) &all_groups[i].steal_count;
+    vars[i].type= SHOW_LONGLONG;
+  }
+  vars[count].name= 0;
+  return 0;
+}
+
+
 /* Report threadpool problems */
 
 /** 
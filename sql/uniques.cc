@@ -30,6 +30,16 @@
   deletes in disk order.
 */
 
+/*
+  When the elements are compared as byte strings and the caller does not
+  need them in sort order (COUNT(DISTINCT)), an open addressing hash set
+  can be used instead of the tree. When it uses more memory than allowed,
+  its elements are written to a set of files partitioned by their hash
+  values, and the set is cleared. To walk the unique elements, each
+  partition is loaded into the hash set in turn. A partition that does not
+  fit into memory is split further using the next bits of the hash values.
+*/
+
 #include <my_global.h>
 #include "sql_priv.h"
 #include "unireg.h"
@@ -75,12 +85,55 @@ int unique_intersect_write_to_ptrs(uchar* key, element_count count, Unique *uniq
 }
 
 
+#define UNIQUE_HASH_MIN_CAPACITY   256
+#define UNIQUE_HASH_PARTITION_BITS 4
+#define UNIQUE_HASH_PARTITIONS     (1 << UNIQUE_HASH_PARTITION_BITS)
+/* The last level of partitioning that still has unused hash value bits */
+#define UNIQUE_HASH_MAX_LEVEL      (64 / UNIQUE_HASH_PARTITION_BITS - 1)
+
+
+/* Hash function for the elements of a hashed Unique */
+
+static inline ulonglong unique_hash(const uchar *key, uint length)
+{
+  ulonglong nr= length;
+  for (; length >= 8; key+= 8, length-= 8)
+  {
+    nr^= uint8korr(key) * 0x87c37b91114253d5ULL;
+    nr= ((nr << 31) | (nr >> 33)) * 0x4cf5ad432745937fULL;
+  }
+  if (length)
+  {
+    ulonglong tail= 0;
+    memcpy(&tail, key, length);
+    nr^= tail * 0x87c37b91114253d5ULL;
+    nr= ((nr << 31) | (nr >> 33)) * 0x4cf5ad432745937fULL;
+  }
+  nr^= nr >> 33;
+  nr*= 0xff51afd7ed558ccdULL;
+  nr^= nr >> 33;
+  return nr;
+}
+
+
+/* Get the partition of a hash value at the given level of partitioning */
+
+static inline uint unique_hash_partition(ulonglong nr, uint level)
+{
+  return (uint) (nr >> (64 - UNIQUE_HASH_PARTITION_BITS * (level + 1))) &
+         (UNIQUE_HASH_PARTITIONS - 1);
+}
+
+
 Unique::Unique(qsort_cmp2 comp_func, void * comp_func_fixed_arg,
 	       uint size_arg, ulonglong max_in_memory_size_arg,
-               uint min_dupl_count_arg)
+               uint min_dupl_count_arg, bool hashed_arg)
   :max_in_memory_size(max_in_memory_size_arg),
    record_pointers(NULL),
    size(size_arg),
+   hashed(hashed_arg && !min_dupl_count_arg),
+   hash_codes(NULL), hash_keys(NULL), hash_capacity(0), hash_count(0),
+   hash_files(NULL), hash_read_buff(NULL),
    elements(0)
 {
   min_dupl_count= min_dupl_count_arg;
@@ -101,6 +154,15 @@ Unique::Unique(qsort_cmp2 comp_func, void * comp_func_fixed_arg,
                          ALIGN_SIZE(sizeof(TREE_ELEMENT)+size));
   (void) open_cached_file(&file, mysql_tmpdir,TEMP_PREFIX, DISK_BUFFER_SIZE,
 		   MYF(MY_WME));
+  if (hashed)
+  {
+    ulong max_slots= (ulong) (max_in_memory_size / (sizeof(uint32) + size));
+    for (hash_max_capacity= UNIQUE_HASH_MIN_CAPACITY;
+         hash_max_capacity * 2 <= max_slots;
+         hash_max_capacity*= 2) {}
+    /* If the following fails the next add will also fail */
+    hash_resize(UNIQUE_HASH_MIN_CAPACITY);
+  }
 }
 
 
@@ -364,6 +426,13 @@ Unique::~Unique()
   close_cached_file(&file);
   delete_tree(&tree);
   delete_dynamic(&file_ptrs);
+  if (hash_files)
+  {
+    hash_close_files(hash_files);
+    my_free(hash_files);
+  }
+  my_free(hash_codes);
+  my_free(hash_read_buff);
 }
 
 
@@ -395,6 +464,20 @@ bool Unique::flush()
 void
 Unique::reset()
 {
+  if (hashed)
+  {
+    hash_clear();
+    if (elements)
+    {
+      for (uint i= 0; i < UNIQUE_HASH_PARTITIONS; i++)
+      {
+        if (my_b_inited(&hash_files[i]))
+          reinit_io_cache(&hash_files[i], WRITE_CACHE, 0L, 0, 1);
+      }
+    }
+    elements= 0;
+    return;
+  }
   reset_tree(&tree);
   /*
     If elements != 0, some trees were stored in the file (see how
@@ -632,6 +715,20 @@ bool Unique::walk(TABLE *table, tree_walk_action action, void *walk_action_arg)
   int res= 0;
   uchar *merge_buffer;
 
+  if (hashed)
+  {
+    if (elements == 0)                     /* the whole set is in memory */
+      return hash_walk_set(action, walk_action_arg);
+    if (hash_flush() ||
+        (!hash_read_buff &&
+         !(hash_read_buff= (uchar*) my_malloc(size, MYF(MY_THREAD_SPECIFIC |
+                                                         MY_WME)))))
+      return 1;
+    for (uint i= 0; i < UNIQUE_HASH_PARTITIONS && !res; i++)
+      res= hash_walk_file(&hash_files[i], 0, action, walk_action_arg);
+    return res;
+  }
+
   if (elements == 0)                       /* the whole tree is in memory */
     return tree_walk(&tree, action, walk_action_arg, left_root_right);
 
@@ -786,3 +883,278 @@ bool Unique::get(TABLE *table)
   my_free(sort_buffer);  
   return rc;
 }
+
+
+/*
+  Add an element to the hash set of a hashed Unique
+
+  DESCRIPTION
+    If the hash set is full and cannot grow any more, its elements are
+    written to the partition files and the set is cleared first.
+
+  RETURN VALUE
+    0    OK
+    1    error
+*/
+
+bool Unique::hash_add(uchar *key)
+{
+  ulonglong nr= unique_hash(key, size);
+  int res= hash_insert(key, nr, FALSE);
+  if (res > 0)
+  {
+    if (hash_flush())
+      return 1;
+    res= hash_insert(key, nr, FALSE);
+  }
+  return res != 0;
+}
+
+
+/*
+  Insert an element into the hash set unless it is already there
+
+  SYNOPSIS
+    hash_insert()
+      key       the element
+      nr        hash value of the element
+      no_limit  TRUE <=> the set may grow beyond max_in_memory_size
+
+  RETURN VALUE
+    0    OK
+    1    the set is full
+    -1   out of memory
+*/
+
+int Unique::hash_insert(uchar *key, ulonglong nr, bool no_limit)
+{
+  if (hash_count >= hash_capacity / 4 * 3)
+  {
+    if (hash_capacity >= hash_max_capacity && !no_limit)
+      return 1;
+    if (hash_resize(MY_MAX(hash_capacity * 2, UNIQUE_HASH_MIN_CAPACITY)))
+      return -1;
+  }
+  uint32 code= (uint32) (nr >> 32) | 1;
+  ulong mask= hash_capacity - 1;
+  for (ulong idx= (ulong) nr & mask; ; idx= (idx + 1) & mask)
+  {
+    uchar *slot= hash_keys + idx * size;
+    if (!hash_codes[idx])
+    {
+      hash_codes[idx]= code;
+      memcpy(slot, key, size);
+      hash_count++;
+      return 0;
+    }
+    if (hash_codes[idx] == code && !memcmp(slot, key, size))
+      return 0;
+  }
+}
+
+
+/* Allocate the hash set with the given capacity and move the elements to it */
+
+bool Unique::hash_resize(ulong capacity)
+{
+  uint32 *old_codes= hash_codes;
+  uchar *old_keys= hash_keys;
+  ulong old_capacity= hash_capacity;
+
+  if (!(hash_codes= (uint32*) my_malloc(capacity * (sizeof(uint32) + size),
+                                        MYF(MY_THREAD_SPECIFIC | MY_WME |
+                                            MY_ZEROFILL))))
+  {
+    hash_codes= old_codes;
+    return 1;
+  }
+  hash_keys= (uchar*) (hash_codes + capacity);
+  hash_capacity= capacity;
+  hash_count= 0;
+  for (ulong i= 0; i < old_capacity; i++)
+  {
+    if (old_codes[i])
+    {
+      uchar *key= old_keys + i * size;
+      hash_insert(key, unique_hash(key, size), TRUE);
+    }
+  }
+  my_free(old_codes);
+  return 0;
+}
+
+
+/*
+  Remove all elements from the hash set
+
+  NOTES
+    A set that has grown large while holding few elements is shrunk, so that
+    clearing it for every group of a GROUP BY query stays cheap.
+*/
+
+void Unique::hash_clear()
+{
+  if (hash_capacity > UNIQUE_HASH_MIN_CAPACITY &&
+      hash_count < hash_capacity / 8)
+  {
+    my_free(hash_codes);
+    hash_codes= NULL;
+    hash_capacity= 0;
+    hash_count= 0;
+    if (!hash_resize(UNIQUE_HASH_MIN_CAPACITY))
+      return;
+  }
+  if (hash_codes)
+    bzero(hash_codes, hash_capacity * sizeof(uint32));
+  hash_count= 0;
+}
+
+
+/* Write an element to the partition file for its hash value */
+
+bool Unique::hash_write(IO_CACHE *files, uchar *key, ulonglong nr, uint level)
+{
+  IO_CACHE *file= &files[unique_hash_partition(nr, level)];
+  if (!my_b_inited(file) &&
+      open_cached_file(file, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
+                       MYF(MY_WME)))
+    return 1;
+  return my_b_write(file, key, size) != 0;
+}
+
+
+/* Write the elements of the hash set to the partition files, clear the set */
+
+bool Unique::hash_flush()
+{
+  if (!hash_files)
+  {
+    if (!(hash_files= (IO_CACHE*) my_malloc(UNIQUE_HASH_PARTITIONS *
+                                            sizeof(IO_CACHE),
+                                            MYF(MY_THREAD_SPECIFIC | MY_WME))))
+      return 1;
+    for (uint i= 0; i < UNIQUE_HASH_PARTITIONS; i++)
+      my_b_clear(&hash_files[i]);
+  }
+  elements+= hash_count;
+  for (ulong i= 0; i < hash_capacity; i++)
+  {
+    if (hash_codes[i])
+    {
+      uchar *key= hash_keys + i * size;
+      if (hash_write(hash_files, key, unique_hash(key, size), 0))
+        return 1;
+    }
+  }
+  hash_clear();
+  return 0;
+}
+
+
+/* Call action for each element of the hash set */
+
+int Unique::hash_walk_set(tree_walk_action action, void *walk_action_arg)
+{
+  int res;
+  for (ulong i= 0; i < hash_capacity; i++)
+  {
+    if (hash_codes[i] &&
+        (res= (*action)(hash_keys + i * size, 1, walk_action_arg)))
+      return res;
+  }
+  return 0;
+}
+
+
+/*
+  Call action for each unique element from a partition file
+
+  SYNOPSIS
+    hash_walk_file()
+      file      the partition file
+      level     the level of partitioning the file has been written at
+
+  DESCRIPTION
+    The elements of the file are loaded into the hash set. If they do
+    not fit, the file is split into partitions of the next level.
+*/
+
+int Unique::hash_walk_file(IO_CACHE *file, uint level,
+                           tree_walk_action action, void *walk_action_arg)
+{
+  if (!my_b_inited(file))
+    return 0;
+  if (reinit_io_cache(file, READ_CACHE, 0L, 0, 0))
+    return 1;
+  hash_clear();
+  while (my_b_tell(file) < file->end_of_file)
+  {
+    int res;
+    if (my_b_read(file, hash_read_buff, size))
+      return 1;
+    res= hash_insert(hash_read_buff, unique_hash(hash_read_buff, size),
+                     level == UNIQUE_HASH_MAX_LEVEL);
+    if (res > 0)
+      return hash_split_file(file, level, action, walk_action_arg);
+    if (res < 0)
+      return 1;
+  }
+  return hash_walk_set(action, walk_action_arg);
+}
+
+
+/*
+  Split a partition file whose elements do not fit into the hash set
+
+  DESCRIPTION
+    The elements already loaded into the hash set, the element in
+    hash_read_buff that did not fit and the rest of the file are written
+    to the partition files of the next level, which are walked then.
+*/
+
+int Unique::hash_split_file(IO_CACHE *file, uint level,
+                            tree_walk_action action, void *walk_action_arg)
+{
+  int res= 1;
+  IO_CACHE *files;
+
+  if (!(files= (IO_CACHE*) my_malloc(UNIQUE_HASH_PARTITIONS * sizeof(IO_CACHE),
+                                     MYF(MY_THREAD_SPECIFIC | MY_WME))))
+    return 1;
+  for (uint i= 0; i < UNIQUE_HASH_PARTITIONS; i++)
+    my_b_clear(&files[i]);
+
+  for (ulong i= 0; i < hash_capacity; i++)
+  {
+    if (hash_codes[i])
+    {
+      uchar *key= hash_keys + i * size;
+      if (hash_write(files, key, unique_hash(key, size), level + 1))
+        goto end;
+    }
+  }
+  for (;;)
+  {
+    if (hash_write(files, hash_read_buff,
+                   unique_hash(hash_read_buff, size), level + 1))
+      goto end;
+    if (my_b_tell(file) >= file->end_of_file)
+      break;
+    if (my_b_read(file, hash_read_buff, size))
+      goto end;
+  }
+  res= 0;
+  for (uint i= 0; i < UNIQUE_HASH_PARTITIONS && !res; i++)
+    res= hash_walk_file(&files[i], level + 1, action, walk_action_arg);
+end:
+  hash_close_files(files);
+  my_free(files);
+  return res;
+}
+
+
+void Unique::hash_close_files(IO_CACHE *files)
+{
+  for (uint i= 0; i < UNIQUE_HASH_PARTITIONS; i++)
+    close_cached_file(&files[i]);
+}
@@ -18,8 +18,8 @@
 
 #include "heapdef.h"
 
-static int check_one_key(HP_KEYDEF *keydef, uint keynr, ulong records,
-			 ulong blength, my_bool print_status);
+static int check_one_key(HP_INFO *info, HP_KEYDEF *keydef, uint keynr,
+                         ulong records, ulong blength, my_bool print_status);
 static int check_one_rb_key(HP_INFO *info, uint keynr, ulong records,
 			    my_bool print_status);
 
@@ -44,7 +44,7 @@ int heap_check_heap(HP_INFO *info, my_bool print_status)
 {
   int error;
   uint key;
-  ulong records=0, deleted=0, pos, next_block;
+  ulong records=0, deleted=0, continued=0, pos, next_block;
   HP_SHARE *share=info->s;
   HP_INFO save_info= *info;			/* Needed because scan_init */
   DBUG_ENTER("heap_check_heap");
@@ -54,7 +54,7 @@ int heap_check_heap(HP_INFO *info, my_bool print_status)
     if (share->keydef[key].algorithm == HA_KEY_ALG_BTREE)
       error|= check_one_rb_key(info, key, share->records, print_status);
     else
-      error|= check_one_key(share->keydef + key, key, share->records,
+      error|= check_one_key(info, share->keydef + key, key, share->records,
 			    share->blength, print_status);
   }
   /*
@@ -70,17 +70,19 @@ int heap_check_heap(HP_INFO *info, my_bool print_status)
     else
     {
       next_block+= share->block.records_in_block;
-      if (next_block >= share->records+share->deleted)
+      if (next_block >= hp_block_records(share))
       {
-	next_block= share->records+share->deleted;
+	next_block= hp_block_records(share);
 	if (pos >= next_block)
 	  break;				/* End of file */
       }
     }
     hp_find_record(info,pos);
 
-    if (!info->current_ptr[share->reclength])
+    if (!info->current_ptr[share->visible])
       deleted++;
+    else if (info->current_ptr[share->visible] == HP_CHUNK_CONTINUED)
+      continued++;
     else
       records++;
   }
@@ -92,13 +94,19 @@ int heap_check_heap(HP_INFO *info, my_bool print_status)
                         deleted, (ulong) share->deleted));
     error= 1;
   }
+  if (share->dynamic && records + continued != share->chunks)
+  {
+    DBUG_PRINT("error",("Found chunks: %lu (%lu)",
+                        records + continued, (ulong) share->chunks));
+    error= 1;
+  }
   *info= save_info;
   DBUG_RETURN(error);
 }
 
 
-static int check_one_key(HP_KEYDEF *keydef, uint keynr, ulong records,
-			 ulong blength, my_bool print_status)
+static int check_one_key(HP_INFO *info, HP_KEYDEF *keydef, uint keynr,
+                         ulong records, ulong blength, my_bool print_status)
 {
   int error;
   ulong i,found,max_links,seek,links;
@@ -111,7 +119,8 @@ static int check_one_key(HP_KEYDEF *keydef, uint keynr, ulong records,
   for (i=found=max_links=seek=0 ; i < records ; i++)
   {
     hash_info=hp_find_hash(&keydef->block,i);
-    if (hash_info->hash_of_key != hp_rec_hashnr(keydef, hash_info->ptr_to_rec))
+    if (hash_info->hash_of_key !=
+        hp_rec_hashnr(keydef, hp_key_record(info, hash_info->ptr_to_rec)))
     {
       DBUG_PRINT("error",
                  ("Found row with wrong hash_of_key at position %lu", i));
@@ -181,7 +190,8 @@ static int check_one_rb_key(HP_INFO *info, uint keynr, ulong records,
     do
     {
       memcpy(&recpos, key + (*keydef->get_key_length)(keydef,key), sizeof(uchar*));
-      key_length= hp_rb_make_key(keydef, info->recbuf, recpos, 0);
+      key_length= hp_rb_make_key(keydef, info->recbuf,
+                                 hp_key_record(info, recpos), 0);
       if (ha_key_cmp(keydef->seg, (uchar*) info->recbuf, (uchar*) key,
 		     key_length, SEARCH_FIND | SEARCH_SAME, not_used))
       {
@@ -23,6 +23,12 @@ int hp_rectest(register HP_INFO *info, register const uchar *old)
 {
   DBUG_ENTER("hp_rectest");
 
+  /*
+    A dynamic row can't be compared this way as the unused part of VARCHAR
+    columns and the blob pointers are not stored.
+  */
+  if (info->s->dynamic)
+    DBUG_RETURN(0);
   if (memcmp(info->current_ptr,old,(size_t) info->s->reclength))
   {
     DBUG_RETURN((my_errno=HA_ERR_RECORD_CHANGED)); /* Record have changed */
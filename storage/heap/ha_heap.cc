@@ -605,23 +605,78 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
                             HP_CREATE_INFO *hp_create_info)
 {
   uint key, parts, mem_per_row= 0, keys= table_arg->s->keys;
-  uint auto_key= 0, auto_key_type= 0;
+  uint auto_key= 0, auto_key_type= 0, columns= 0;
   ha_rows max_rows;
   HP_KEYDEF *keydef;
   HA_KEYSEG *seg;
+  HP_COLUMNDEF *columndef;
   TABLE_SHARE *share= table_arg->s;
   bool found_real_auto_increment= 0;
+  Field **field;
 
   bzero(hp_create_info, sizeof(*hp_create_info));
 
   for (key= parts= 0; key < keys; key++)
     parts+= table_arg->key_info[key].user_defined_key_parts;
 
+  /*
+    ROW_FORMAT=DYNAMIC stores VARCHAR and BLOB columns with their actual
+    length. Blobs are only allowed in internal temporary tables.
+  */
+  if (share->row_type == ROW_TYPE_DYNAMIC)
+  {
+    for (field= table_arg->field; *field; field++)
+      if ((*field)->real_type() == MYSQL_TYPE_VARCHAR ||
+          ((*field)->flags & BLOB_FLAG))
+        columns++;
+  }
+
   if (!(keydef= (HP_KEYDEF*) my_malloc(keys * sizeof(HP_KEYDEF) +
-				       parts * sizeof(HA_KEYSEG),
+				       parts * sizeof(HA_KEYSEG) +
+                                       columns * sizeof(HP_COLUMNDEF),
 				       MYF(MY_WME | MY_THREAD_SPECIFIC))))
     return my_errno;
   seg= reinterpret_cast<HA_KEYSEG*>(keydef + keys);
+  columndef= reinterpret_cast<HP_COLUMNDEF*>(seg + parts);
+  if (columns)
+  {
+    HP_COLUMNDEF *column= columndef;
+    uint min_length= share->reclength + HP_DYNAMIC_HEADER_LENGTH;
+    for (field= table_arg->field; *field; field++)
+    {
+      if ((*field)->real_type() == MYSQL_TYPE_VARCHAR)
+      {
+        column->type= FIELD_VARCHAR;
+        column->length_bytes= ((Field_varstring*) *field)->length_bytes;
+      }
+      else if ((*field)->flags & BLOB_FLAG)
+      {
+        column->type= FIELD_BLOB;
+        column->length_bytes= ((Field_blob*) *field)->pack_length_no_ptr();
+      }
+      else
+        continue;
+      column->offset= (uint) (*field)->offset(table_arg->record[0]);
+      column->length= (*field)->pack_length();
+      if ((*field)->null_ptr)
+      {
+        column->null_bit= (*field)->null_bit;
+        column->null_pos= (uint) ((*field)->null_ptr -
+                                  (uchar*) table_arg->record[0]);
+      }
+      else
+      {
+        column->null_bit= 0;
+        column->null_pos= 0;
+      }
+      min_length-= column->length - column->length_bytes;
+      column++;
+    }
+    /* Each row uses at least one chunk */
+    mem_per_row+= MY_ALIGN(min_length + sizeof(char*) + 1, sizeof(char*));
+  }
+  else
+    mem_per_row+= MY_ALIGN(share->reclength + 1, sizeof(char*));
   for (key= 0; key < keys; key++)
   {
     KEY *pos= table_arg->key_info+key;
@@ -705,7 +760,6 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
       }
     }
   }
-  mem_per_row+= MY_ALIGN(share->reclength + 1, sizeof(char*));
   if (table_arg->found_next_number_field)
   {
     keydef[share->next_number_index].flag|= HA_AUTO_KEY;
@@ -714,6 +768,14 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->auto_key= auto_key;
   hp_create_info->auto_key_type= auto_key_type;
   hp_create_info->max_table_size=current_thd->variables.max_heap_table_size;
+  /*
+    Internal temporary tables with fixed rows are limited to tmp_table_size
+    by TABLE_SHARE::max_rows. The number of dynamic rows that fit is not
+    known in advance, so limit the memory instead.
+  */
+  if (internal_table && columns)
+    set_if_smaller(hp_create_info->max_table_size,
+                   current_thd->variables.tmp_table_size);
   hp_create_info->with_auto_increment= found_real_auto_increment;
   hp_create_info->internal_table= internal_table;
 
@@ -726,6 +788,8 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->keys= share->keys;
   hp_create_info->reclength= share->reclength;
   hp_create_info->keydef= keydef;
+  hp_create_info->columndef= columndef;
+  hp_create_info->columns= columns;
   return 0;
 }
 
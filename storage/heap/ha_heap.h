@@ -43,8 +43,10 @@ class ha_heap: public handler
     return ((table_share->key_info[inx].algorithm == HA_KEY_ALG_BTREE) ?
             "BTREE" : "HASH");
   }
-  /* Rows also use a fixed-size format */
-  enum row_type get_row_type() const { return ROW_TYPE_FIXED; }
+  enum row_type get_row_type() const
+  {
+    return (file && file->s->dynamic) ? ROW_TYPE_DYNAMIC : ROW_TYPE_FIXED;
+  }
   ulonglong table_flags() const
   {
     return (HA_FAST_KEY_READ | HA_NO_BLOBS | HA_NULL_IN_KEY |
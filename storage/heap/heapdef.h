@@ -32,6 +32,23 @@ C_MODE_START
 #define HP_MIN_RECORDS_IN_BLOCK 16
 #define HP_MAX_RECORDS_IN_BLOCK 8192
 
+/*
+  Tables with dynamic rows store each row as a chain of fixed size chunks.
+  A chunk is chunk_length data bytes, a pointer to the next chunk of the
+  row and the status byte. The packed row starts with its total length.
+  HP_CHUNK_DATA_RESERVE is the space reserved in the first chunk for the
+  data of the VARCHAR and BLOB columns.
+*/
+
+#define HP_DYNAMIC_HEADER_LENGTH 4
+#define HP_CHUNK_DATA_RESERVE 64
+
+	/* Values of the status byte stored after each record */
+
+#define HP_ROW_DELETED 0
+#define HP_ROW_ACTIVE 1
+#define HP_CHUNK_CONTINUED 2		/* Not the first chunk of a row */
+
 	/* Some extern variables */
 
 extern LIST *heap_open_list,*heap_share_list;
@@ -44,6 +61,10 @@ if (!(info->update & HA_STATE_AKTIV))\
 	/* Find pos for record and update it in info->current_ptr */
 #define hp_find_record(info,pos) (info)->current_ptr= hp_find_block(&(info)->s->block,pos)
 
+	/* Number of used and deleted positions in the record block */
+#define hp_block_records(share) \
+  (((share)->dynamic ? (share)->chunks : (share)->records) + (share)->deleted)
+
 typedef struct st_hp_hash_info
 {
   struct st_hp_hash_info *next_key;
@@ -97,6 +118,15 @@ extern uint hp_rb_key_length(HP_KEYDEF *keydef, const uchar *key);
 extern uint hp_rb_null_key_length(HP_KEYDEF *keydef, const uchar *key);
 extern uint hp_rb_var_key_length(HP_KEYDEF *keydef, const uchar *key);
 extern my_bool hp_if_null_in_key(HP_KEYDEF *keyinfo, const uchar *record);
+extern uchar *hp_next_free_record_pos(HP_SHARE *info, my_bool check_limits);
+extern uint hp_pack_record(HP_INFO *info, const uchar *record);
+extern uchar *hp_alloc_chunks(HP_INFO *info, uint length);
+extern my_bool hp_extend_chunks(HP_INFO *info, uchar *pos, uint length,
+                                my_bool check_limits);
+extern void hp_store_chunks(HP_INFO *info, uchar *pos, uint length);
+extern void hp_free_chunks(HP_SHARE *info, uchar *pos);
+extern int hp_unpack_record(HP_INFO *info, uchar *record, const uchar *pos,
+                            my_bool with_blobs);
 extern int hp_close(register HP_INFO *info);
 extern void hp_clear(HP_SHARE *info);
 extern void hp_clear_keys(HP_SHARE *info);
@@ -105,6 +135,32 @@ extern uint hp_rb_pack_key(HP_KEYDEF *keydef, uchar *key, const uchar *old,
 
 extern mysql_mutex_t THR_LOCK_heap;
 
+	/* Copy the row stored at pos to record */
+
+static inline int hp_extract_record(HP_INFO *info, uchar *record,
+                                    const uchar *pos)
+{
+  if (!info->s->dynamic)
+  {
+    memcpy(record, pos, (size_t) info->s->reclength);
+    return 0;
+  }
+  return hp_unpack_record(info, record, pos, 1);
+}
+
+/*
+  Return the row stored at pos in record format, for comparing it with
+  a key. Blob columns are not unpacked as they can't be part of a key.
+*/
+
+static inline const uchar *hp_key_record(HP_INFO *info, const uchar *pos)
+{
+  if (!info->s->dynamic)
+    return pos;
+  (void) hp_unpack_record(info, info->cmp_record, pos, 0);
+  return info->cmp_record;
+}
+
 #ifdef HAVE_PSI_INTERFACE
 extern PSI_mutex_key hp_key_mutex_HP_SHARE_intern_lock;
 void init_heap_psi_keys();
@@ -25,12 +25,13 @@ static void init_block(HP_BLOCK *block,uint reclength,ulong min_records,
 int heap_create(const char *name, HP_CREATE_INFO *create_info,
                 HP_SHARE **res, my_bool *created_new_share)
 {
-  uint i, j, key_segs, max_length, length;
+  uint i, j, key_segs, max_length, length, chunk_length;
   HP_SHARE *share= 0;
   HA_KEYSEG *keyseg;
   HP_KEYDEF *keydef= create_info->keydef;
   uint reclength= create_info->reclength;
   uint keys= create_info->keys;
+  uint columns= create_info->columns;
   ulong min_records= create_info->min_records;
   ulong max_records= create_info->max_records;
   DBUG_ENTER("heap_create");
@@ -56,11 +57,34 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     HP_KEYDEF *keyinfo;
     DBUG_PRINT("info",("Initializing new table"));
     
-    /*
-      We have to store sometimes uchar* del_link in records,
-      so the record length should be at least sizeof(uchar*)
-    */
-    set_if_bigger(reclength, sizeof (uchar*));
+    if (columns)
+    {
+      /*
+        Dynamic rows: make a chunk big enough for the fixed part of the
+        row and some data of the VARCHAR and BLOB columns. Longer rows use
+        more chunks.
+      */
+      uint var_length= 0;
+      chunk_length= reclength + HP_DYNAMIC_HEADER_LENGTH;
+      for (i= 0; i < columns; i++)
+      {
+        HP_COLUMNDEF *column= create_info->columndef + i;
+        chunk_length-= column->length - column->length_bytes;
+        var_length+= (column->type == FIELD_BLOB ? HP_CHUNK_DATA_RESERVE :
+                      column->length - column->length_bytes);
+      }
+      chunk_length+= MY_MIN(var_length, HP_CHUNK_DATA_RESERVE);
+      chunk_length= MY_ALIGN(chunk_length, sizeof(uchar*));
+    }
+    else
+    {
+      /*
+        We have to store sometimes uchar* del_link in records,
+        so the record length should be at least sizeof(uchar*)
+      */
+      set_if_bigger(reclength, sizeof (uchar*));
+      chunk_length= reclength;
+    }
     
     for (i= key_segs= max_length= 0, keyinfo= keydef; i < keys; i++, keyinfo++)
     {
@@ -146,7 +170,8 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     }
     if (!(share= (HP_SHARE*) my_malloc((uint) sizeof(HP_SHARE)+
 				       keys*sizeof(HP_KEYDEF)+
-				       key_segs*sizeof(HA_KEYSEG),
+				       key_segs*sizeof(HA_KEYSEG)+
+                                       columns*sizeof(HP_COLUMNDEF),
 				       MYF(MY_ZEROFILL |
                                            (create_info->internal_table ?
                                             MY_THREAD_SPECIFIC : 0)))))
@@ -154,7 +179,23 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     share->keydef= (HP_KEYDEF*) (share + 1);
     share->key_stat_version= 1;
     keyseg= (HA_KEYSEG*) (share->keydef + keys);
-    init_block(&share->block, reclength + 1, min_records, max_records);
+    share->columndef= (HP_COLUMNDEF*) (keyseg + key_segs);
+    if (columns)
+    {
+      /* The chunk data is followed by a pointer to the next chunk */
+      share->visible= chunk_length + sizeof(uchar*);
+      share->chunk_length= chunk_length;
+      share->columns= columns;
+      share->dynamic= 1;
+      memcpy(share->columndef, create_info->columndef,
+             (size_t) (sizeof(share->columndef[0]) * columns));
+      for (i= 0; i < columns; i++)
+        if (share->columndef[i].type == FIELD_BLOB)
+          share->blobs= 1;
+    }
+    else
+      share->visible= reclength;
+    init_block(&share->block, share->visible + 1, min_records, max_records);
 	/* Fix keys */
     memcpy(share->keydef, keydef, (size_t) (sizeof(keydef[0]) * keys));
     for (i= 0, keyinfo= share->keydef; i < keys; i++, keyinfo++)
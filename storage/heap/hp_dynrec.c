@@ -0,0 +1,373 @@
+/* Copyright (c) 2015, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Functions to handle tables with dynamic rows.
+
+  A row is packed by storing VARCHAR and BLOB columns with their actual
+  length; all other parts of the record are copied as is. The packed row
+  is prefixed with its total length and stored in a chain of chunks
+  allocated from the record block. The first chunk of a row is marked
+  with HP_ROW_ACTIVE and is the row position used by the indexes, the
+  following ones are marked with HP_CHUNK_CONTINUED so that scans can skip
+  them. Free chunks are kept in the same delete link as fixed size rows.
+*/
+
+#include "heapdef.h"
+
+typedef struct st_hp_chunk_pos
+{
+  const uchar *chunk;
+  uint offset;
+} HP_CHUNK_POS;
+
+#define next_chunk(share, chunk) (*(uchar**) ((chunk) + (share)->chunk_length))
+
+static ulong hp_blob_length(uint length_bytes, const uchar *pos)
+{
+  switch (length_bytes) {
+  case 1:
+    return (ulong) *pos;
+  case 2:
+    return (ulong) uint2korr(pos);
+  case 3:
+    return (ulong) uint3korr(pos);
+  case 4:
+    return (ulong) uint4korr(pos);
+  default:
+    break;
+  }
+  return 0;
+}
+
+
+	/* Get length of the data of a VARCHAR or BLOB column */
+
+static ulong hp_column_data_length(HP_COLUMNDEF *column, const uchar *record)
+{
+  const uchar *pos= record + column->offset;
+
+  if (column->null_bit && (record[column->null_pos] & column->null_bit))
+    return 0;
+  if (column->type == FIELD_BLOB)
+    return hp_blob_length(column->length_bytes, pos);
+  return (column->length_bytes == 1 ? (ulong) *pos : (ulong) uint2korr(pos));
+}
+
+
+/*
+  Pack a record to info->rec_buff
+
+  RETURN
+    Length of the packed row
+    0  Out of memory
+*/
+
+uint hp_pack_record(HP_INFO *info, const uchar *record)
+{
+  HP_SHARE *share= info->s;
+  HP_COLUMNDEF *column, *end= share->columndef + share->columns;
+  ulong length= share->reclength + HP_DYNAMIC_HEADER_LENGTH;
+  uint offset;
+  uchar *to;
+  DBUG_ENTER("hp_pack_record");
+
+  for (column= share->columndef; column < end; column++)
+    length+= (hp_column_data_length(column, record) + column->length_bytes -
+              column->length);
+
+  if (length > info->rec_buff_length)
+  {
+    if (!(to= (uchar*) my_realloc(info->rec_buff, length,
+                                  MYF(MY_ALLOW_ZERO_PTR |
+                                      (share->internal ?
+                                       MY_THREAD_SPECIFIC : 0)))))
+    {
+      my_errno= HA_ERR_OUT_OF_MEM;
+      DBUG_RETURN(0);
+    }
+    info->rec_buff= to;
+    info->rec_buff_length= length;
+  }
+
+  to= info->rec_buff;
+  int4store(to, length);
+  to+= HP_DYNAMIC_HEADER_LENGTH;
+  for (offset= 0, column= share->columndef; column < end; column++)
+  {
+    const uchar *pos= record + column->offset;
+    ulong data_length= hp_column_data_length(column, record);
+
+    memcpy(to, record + offset, column->offset - offset);
+    to+= column->offset - offset;
+    if (data_length)
+      memcpy(to, pos, column->length_bytes);
+    else
+      bzero(to, column->length_bytes);
+    to+= column->length_bytes;
+    pos+= column->length_bytes;
+    if (column->type == FIELD_BLOB)
+      memcpy(&pos, pos, sizeof(char*));
+    memcpy(to, pos, data_length);
+    to+= data_length;
+    offset= column->offset + column->length;
+  }
+  memcpy(to, record + offset, share->reclength - offset);
+  DBUG_ASSERT((ulong) (to + share->reclength - offset - info->rec_buff) ==
+              length);
+  DBUG_RETURN((uint) length);
+}
+
+
+/*
+  Allocate chunks for a new row
+
+  RETURN
+    First chunk of the row
+    0  Table is full or out of memory
+*/
+
+uchar *hp_alloc_chunks(HP_INFO *info, uint length)
+{
+  HP_SHARE *share= info->s;
+  uchar *first;
+  DBUG_ENTER("hp_alloc_chunks");
+
+  if (!(first= hp_next_free_record_pos(share, 1)))
+    DBUG_RETURN(0);
+  share->chunks++;
+  first[share->visible]= HP_CHUNK_CONTINUED;
+  next_chunk(share, first)= 0;
+  if (length > share->chunk_length &&
+      hp_extend_chunks(info, first, length, 1))
+  {
+    hp_free_chunks(share, first);
+    DBUG_RETURN(0);
+  }
+  DBUG_RETURN(first);
+}
+
+
+/*
+  Make sure that the chain of chunks starting at pos can hold a packed row
+  of the given length.
+
+  NOTES
+    heap_update() calls this without check_limits: the caller of an update
+    of an internal temporary table can't convert it to disk, and the row
+    can't grow more than the length of its VARCHAR and BLOB columns.
+    On failure the chunks allocated so far are left in the chain. They
+    are released when the row is stored or deleted.
+
+  RETURN
+    0  ok
+    1  Table is full or out of memory
+*/
+
+my_bool hp_extend_chunks(HP_INFO *info, uchar *pos, uint length,
+                         my_bool check_limits)
+{
+  HP_SHARE *share= info->s;
+  uchar *chunk;
+  DBUG_ENTER("hp_extend_chunks");
+
+  for (;;)
+  {
+    if (length <= share->chunk_length)
+      DBUG_RETURN(0);
+    length-= share->chunk_length;
+    if (!next_chunk(share, pos))
+      break;
+    pos= next_chunk(share, pos);
+  }
+  for (;;)
+  {
+    if (!(chunk= hp_next_free_record_pos(share, check_limits)))
+      DBUG_RETURN(1);
+    share->chunks++;
+    chunk[share->visible]= HP_CHUNK_CONTINUED;
+    next_chunk(share, chunk)= 0;
+    next_chunk(share, pos)= chunk;
+    pos= chunk;
+    if (length <= share->chunk_length)
+      DBUG_RETURN(0);
+    length-= share->chunk_length;
+  }
+}
+
+
+/*
+  Copy the packed row in info->rec_buff to the chain of chunks starting at
+  pos and free the chunks that are not needed anymore.
+  The chain must have been allocated with hp_alloc_chunks() or
+  hp_extend_chunks() for at least the given length.
+*/
+
+void hp_store_chunks(HP_INFO *info, uchar *pos, uint length)
+{
+  HP_SHARE *share= info->s;
+  const uchar *from= info->rec_buff;
+  uchar *chunk= pos, *next;
+  DBUG_ENTER("hp_store_chunks");
+
+  for (;;)
+  {
+    uint part= MY_MIN(length, share->chunk_length);
+    memcpy(chunk, from, part);
+    if (!(length-= part))
+      break;
+    from+= part;
+    chunk= next_chunk(share, chunk);
+    DBUG_ASSERT(chunk);
+  }
+  if ((next= next_chunk(share, chunk)))
+  {
+    next_chunk(share, chunk)= 0;
+    hp_free_chunks(share, next);
+  }
+  pos[share->visible]= HP_ROW_ACTIVE;
+  DBUG_VOID_RETURN;
+}
+
+
+	/* Put all chunks in the chain starting at pos to the delete link */
+
+void hp_free_chunks(HP_SHARE *share, uchar *pos)
+{
+  uchar *next;
+  DBUG_ENTER("hp_free_chunks");
+
+  for (; pos; pos= next)
+  {
+    next= next_chunk(share, pos);
+    *((uchar**) pos)= share->del_link;
+    share->del_link= pos;
+    pos[share->visible]= HP_ROW_DELETED;
+    share->deleted++;
+    share->chunks--;
+  }
+  DBUG_VOID_RETURN;
+}
+
+
+/*
+  Copy bytes from a chain of chunks.
+  If 'to' is 0 the bytes are skipped.
+*/
+
+static void hp_read_chunks(HP_SHARE *share, HP_CHUNK_POS *pos, uchar *to,
+                           ulong length)
+{
+  while (length)
+  {
+    uint part= (uint) MY_MIN(length, share->chunk_length - pos->offset);
+    if (to)
+    {
+      memcpy(to, pos->chunk + pos->offset, part);
+      to+= part;
+    }
+    length-= part;
+    if ((pos->offset+= part) == share->chunk_length)
+    {
+      pos->chunk= next_chunk(share, pos->chunk);
+      pos->offset= 0;
+    }
+  }
+}
+
+
+/*
+  Unpack the row stored in the chain of chunks starting at pos
+
+  SYNOPSIS
+    hp_unpack_record()
+    info		Heap handler
+    record		Store row here
+    pos			First chunk of the row
+    with_blobs		If not set, blob columns are not read. This is used
+                        when only the key columns of the row are needed.
+
+  NOTES
+    Blob data is copied to info->blob_buff, which is valid until the next
+    row is read with this handler.
+
+  RETURN
+    0  ok
+    #  error number
+*/
+
+int hp_unpack_record(HP_INFO *info, uchar *record, const uchar *pos,
+                     my_bool with_blobs)
+{
+  HP_SHARE *share= info->s;
+  HP_COLUMNDEF *column, *end= share->columndef + share->columns;
+  HP_CHUNK_POS chunk_pos;
+  uchar header[HP_DYNAMIC_HEADER_LENGTH], *blob_pos= 0;
+  uint offset;
+
+  chunk_pos.chunk= pos;
+  chunk_pos.offset= 0;
+  hp_read_chunks(share, &chunk_pos, header, HP_DYNAMIC_HEADER_LENGTH);
+  if (with_blobs && share->blobs)
+  {
+    size_t length= (size_t) uint4korr(header);
+    if (length > info->blob_buff_length)
+    {
+      if (!(blob_pos= (uchar*) my_realloc(info->blob_buff, length,
+                                          MYF(MY_ALLOW_ZERO_PTR |
+                                              (share->internal ?
+                                               MY_THREAD_SPECIFIC : 0)))))
+        return my_errno= HA_ERR_OUT_OF_MEM;
+      info->blob_buff= blob_pos;
+      info->blob_buff_length= length;
+    }
+    blob_pos= info->blob_buff;
+  }
+
+  for (offset= 0, column= share->columndef; column < end; column++)
+  {
+    uchar *to= record + column->offset;
+    ulong data_length;
+
+    hp_read_chunks(share, &chunk_pos, record + offset,
+                   column->offset - offset);
+    hp_read_chunks(share, &chunk_pos, to, column->length_bytes);
+    to+= column->length_bytes;
+    if (column->type == FIELD_BLOB)
+    {
+      data_length= hp_blob_length(column->length_bytes,
+                                  record + column->offset);
+      if (blob_pos)
+      {
+        hp_read_chunks(share, &chunk_pos, blob_pos, data_length);
+        memcpy(to, &blob_pos, sizeof(char*));
+        blob_pos+= data_length;
+      }
+      else
+        hp_read_chunks(share, &chunk_pos, 0, data_length);
+    }
+    else
+    {
+      data_length= (column->length_bytes == 1 ?
+                    (ulong) record[column->offset] :
+                    (ulong) uint2korr(record + column->offset));
+      hp_read_chunks(share, &chunk_pos, to, data_length);
+    }
+    offset= column->offset + column->length;
+  }
+  hp_read_chunks(share, &chunk_pos, record + offset,
+                 share->reclength - offset);
+  return 0;
+}
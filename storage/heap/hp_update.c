@@ -24,6 +24,7 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
   uchar *pos;
   my_bool auto_key_changed= 0, key_changed= 0;
   HP_SHARE *share= info->s;
+  uint UNINIT_VAR(length);
   DBUG_ENTER("heap_update");
 
   test_active(info);
@@ -31,6 +32,14 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
 
   if (info->opt_flag & READ_CHECK_USED && hp_rectest(info,old))
     DBUG_RETURN(my_errno);				/* Record changed */
+  /*
+    Allocate the chunks for a dynamic row before the keys are changed.
+    The row keeps its first chunk, which is the position in the indexes.
+  */
+  if (share->dynamic &&
+      (!(length= hp_pack_record(info, heap_new)) ||
+       hp_extend_chunks(info, pos, length, 0)))
+    DBUG_RETURN(my_errno);
   if (--(share->records) < share->blength >> 1) share->blength>>= 1;
   share->changed=1;
 
@@ -47,7 +56,10 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
     }
   }
 
-  memcpy(pos,heap_new,(size_t) share->reclength);
+  if (share->dynamic)
+    hp_store_chunks(info, pos, length);
+  else
+    memcpy(pos,heap_new,(size_t) share->reclength);
   if (++(share->records) == share->blength) share->blength+= share->blength;
 
 #if !defined(DBUG_OFF) && defined(EXTRA_HEAP_DEBUG)
@@ -26,7 +26,6 @@
 #define HIGHFIND 4
 #define HIGHUSED 8
 
-static uchar *next_free_record_pos(HP_SHARE *info);
 static HASH_INFO *hp_find_free_hash(HP_SHARE *info, HP_BLOCK *block,
 				     ulong records);
 
@@ -35,6 +34,7 @@ int heap_write(HP_INFO *info, const uchar *record)
   HP_KEYDEF *keydef, *end;
   uchar *pos;
   HP_SHARE *share=info->s;
+  uint UNINIT_VAR(length);
   DBUG_ENTER("heap_write");
 #ifndef DBUG_OFF
   if (info->mode & O_RDONLY)
@@ -42,7 +42,13 @@ int heap_write(HP_INFO *info, const uchar *record)
     DBUG_RETURN(my_errno=EACCES);
   }
 #endif
-  if (!(pos=next_free_record_pos(share)))
+  if (share->dynamic)
+  {
+    if (!(length= hp_pack_record(info, record)) ||
+        !(pos= hp_alloc_chunks(info, length)))
+      DBUG_RETURN(my_errno);
+  }
+  else if (!(pos=hp_next_free_record_pos(share, 1)))
     DBUG_RETURN(my_errno);
   share->changed=1;
 
@@ -53,8 +59,13 @@ int heap_write(HP_INFO *info, const uchar *record)
       goto err;
   }
 
-  memcpy(pos,record,(size_t) share->reclength);
-  pos[share->reclength]=1;		/* Mark record as not deleted */
+  if (share->dynamic)
+    hp_store_chunks(info, pos, length);
+  else
+  {
+    memcpy(pos,record,(size_t) share->reclength);
+    pos[share->visible]=1;		/* Mark record as not deleted */
+  }
   if (++share->records == share->blength)
     share->blength+= share->blength;
   info->s->key_version++;
@@ -89,11 +100,15 @@ int heap_write(HP_INFO *info, const uchar *record)
     keydef--;
   } 
 
-  share->deleted++;
-  *((uchar**) pos)=share->del_link;
-  share->del_link=pos;
-  pos[share->reclength]=0;			/* Record deleted */
-
+  if (share->dynamic)
+    hp_free_chunks(share, pos);
+  else
+  {
+    share->deleted++;
+    *((uchar**) pos)=share->del_link;
+    share->del_link=pos;
+    pos[share->visible]=0;			/* Record deleted */
+  }
   DBUG_RETURN(my_errno);
 } /* heap_write */
 
@@ -130,14 +145,22 @@ int hp_rb_write_key(HP_INFO *info, HP_KEYDEF *keyinfo, const uchar *record,
   return 0;
 }
 
-	/* Find where to place new record */
+/*
+  Find where to place new record or chunk of a dynamic row
+
+  SYNOPSIS
+    hp_next_free_record_pos()
+    info		Heap table share
+    check_limits	Fail with HA_ERR_RECORD_FILE_FULL if the table has
+                        reached max_records or max_table_size
+*/
 
-static uchar *next_free_record_pos(HP_SHARE *info)
+uchar *hp_next_free_record_pos(HP_SHARE *info, my_bool check_limits)
 {
   int block_pos;
   uchar *pos;
   size_t length;
-  DBUG_ENTER("next_free_record_pos");
+  DBUG_ENTER("hp_next_free_record_pos");
 
   if (info->del_link)
   {
@@ -147,10 +170,11 @@ static uchar *next_free_record_pos(HP_SHARE *info)
     DBUG_PRINT("exit",("Used old position: 0x%lx",(long) pos));
     DBUG_RETURN(pos);
   }
-  if (!(block_pos=(info->records % info->block.records_in_block)))
+  if (!(block_pos=(hp_block_records(info) % info->block.records_in_block)))
   {
-    if ((info->records > info->max_records && info->max_records) ||
-        (info->data_length + info->index_length >= info->max_table_size))
+    if (check_limits &&
+        ((info->records > info->max_records && info->max_records) ||
+         (info->data_length + info->index_length >= info->max_table_size)))
     {
       DBUG_PRINT("error",
                  ("record file full. records: %lu  max_records: %lu  "
@@ -386,7 +410,8 @@ int hp_write_key(HP_INFO *info, HP_KEYDEF *keyinfo,
       do
       {
 	if (pos->hash_of_key == hash_of_key &&
-            ! hp_rec_key_cmp(keyinfo, record, pos->ptr_to_rec, 1))
+            ! hp_rec_key_cmp(keyinfo, record,
+                             hp_key_record(info, pos->ptr_to_rec), 1))
 	{
 	  DBUG_RETURN(my_errno=HA_ERR_FOUND_DUPP_KEY);
 	}
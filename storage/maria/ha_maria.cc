@@ -979,7 +979,7 @@ int_table_flags(HA_NULL_IN_KEY | HA_CAN_FULLTEXT | HA_CAN_SQL_HANDLER |
                 HA_DUPLICATE_POS | HA_CAN_INDEX_BLOBS | HA_AUTO_PART_KEY |
                 HA_FILE_BASED | HA_CAN_GEOMETRY | CANNOT_ROLLBACK_FLAG |
                 HA_CAN_BIT_FIELD | HA_CAN_RTREEKEYS | HA_CAN_REPAIR |
-                HA_CAN_VIRTUAL_COLUMNS |
+                HA_CAN_VIRTUAL_COLUMNS | HA_DO_ROWID_FILTER_PUSHDOWN |
                 HA_HAS_RECORDS | HA_STATS_RECORDS_IS_EXACT),
 can_enable_indexes(1), bulk_insert_single_undo(BULK_INSERT_NONE)
 {}
@@ -2407,7 +2407,7 @@ int ha_maria::index_next_same(uchar * buf,
 int ha_maria::index_init(uint idx, bool sorted)
 { 
   active_index=idx;
-  if (pushed_idx_cond_keyno == idx)
+  if (pushed_idx_cond_keyno == idx || pushed_rowid_filter_keyno == idx)
     ma_set_index_cond_func(file, handler_index_cond_check, this);
   return 0; 
 }
@@ -3921,6 +3921,21 @@ Item *ha_maria::idx_cond_push(uint keyno_arg, Item* idx_cond_arg)
   return NULL;
 }
 
+
+/* Rowid filter pushdown implementation */
+
+bool ha_maria::rowid_filter_push(uint keyno_arg, Rowid_filter *filter)
+{
+  /* The filter is checked by the ICP callback of the index condition */
+  if (pushed_idx_cond_keyno != MAX_KEY && pushed_idx_cond_keyno != keyno_arg)
+    return TRUE;
+  pushed_rowid_filter_keyno= keyno_arg;
+  pushed_rowid_filter= filter;
+  if (active_index == pushed_rowid_filter_keyno)
+    ma_set_index_cond_func(file, handler_index_cond_check, this);
+  return FALSE;
+}
+
 struct st_mysql_storage_engine maria_storage_engine=
 { MYSQL_HANDLERTON_INTERFACE_VERSION };
 
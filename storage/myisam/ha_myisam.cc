@@ -668,6 +668,7 @@ ha_myisam::ha_myisam(handlerton *hton, TABLE_SHARE *table_arg)
   int_table_flags(HA_NULL_IN_KEY | HA_CAN_FULLTEXT | HA_CAN_SQL_HANDLER |
                   HA_BINLOG_ROW_CAPABLE | HA_BINLOG_STMT_CAPABLE |
                   HA_CAN_VIRTUAL_COLUMNS | HA_CAN_EXPORT |
+                  HA_DO_ROWID_FILTER_PUSHDOWN |
                   HA_DUPLICATE_POS | HA_CAN_INDEX_BLOBS | HA_AUTO_PART_KEY |
                   HA_FILE_BASED | HA_CAN_GEOMETRY | HA_NO_TRANSACTIONS |
                   HA_CAN_INSERT_DELAYED | HA_CAN_BIT_FIELD | HA_CAN_RTREEKEYS |
@@ -1706,7 +1707,7 @@ int ha_myisam::delete_row(const uchar *buf)
 int ha_myisam::index_init(uint idx, bool sorted)
 { 
   active_index=idx;
-  if (pushed_idx_cond_keyno == idx)
+  if (pushed_idx_cond_keyno == idx || pushed_rowid_filter_keyno == idx)
     mi_set_index_cond_func(file, handler_index_cond_check, this);
   return 0; 
 }
@@ -2347,6 +2348,21 @@ Item *ha_myisam::idx_cond_push(uint keyno_arg, Item* idx_cond_arg)
   return NULL;
 }
 
+
+/* Rowid filter pushdown implementation */
+
+bool ha_myisam::rowid_filter_push(uint keyno_arg, Rowid_filter *filter)
+{
+  /* The filter is checked by the ICP callback of the index condition */
+  if (pushed_idx_cond_keyno != MAX_KEY && pushed_idx_cond_keyno != keyno_arg)
+    return TRUE;
+  pushed_rowid_filter_keyno= keyno_arg;
+  pushed_rowid_filter= filter;
+  if (active_index == pushed_rowid_filter_keyno)
+    mi_set_index_cond_func(file, handler_index_cond_check, this);
+  return FALSE;
+}
+
 struct st_mysql_storage_engine myisam_storage_engine=
 { MYSQL_HANDLERTON_INTERFACE_VERSION };
 
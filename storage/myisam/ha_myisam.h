@@ -168,6 +168,7 @@ class ha_myisam: public handler
 
   /* Index condition pushdown implementation */
   Item *idx_cond_push(uint keyno, Item* idx_cond);
+  bool rowid_filter_push(uint keyno, Rowid_filter *filter);
 private:
   DsMrr_impl ds_mrr;
   friend ICP_RESULT index_cond_func_myisam(void *arg);
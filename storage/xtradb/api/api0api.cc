@@ -416,6 +416,17 @@ ib_read_tuple(
 			dfield = dtuple_get_nth_field(dtuple, i);
 		}
 
+		if (rec_offs_nth_default(offsets, i)) {
+			const dict_col_t*	col
+				= dict_index_get_nth_col(index, i);
+
+			/* The column was added instantly after
+			the record was inserted. */
+			dfield_set_data(dfield, col->def_val,
+					col->def_val_len);
+			continue;
+		}
+
 		data = rec_get_nth_field(copy, offsets, i, &len);
 
 		/* Fetch and copy any externally stored column. */
@@ -122,6 +122,158 @@ buf_dblwr_sync_datafiles()
 	fil_flush_file_spaces(FIL_TABLESPACE);
 }
 
+/****************************************************************//**
+Builds the name of the doublewrite file of a buffer pool instance for
+innodb_parallel_doublewrite. */
+static
+void
+buf_dblwr_shard_file_name(
+/*======================*/
+	char*	name,	/*!< out: file name */
+	ulint	len,	/*!< in: size of name */
+	ulint	i)	/*!< in: buffer pool instance number */
+{
+	ut_snprintf(name, len, "%s%c%s%lu", srv_data_home,
+		    SRV_PATH_SEPARATOR, BUF_DBLWR_FILE_NAME, (ulong) i);
+}
+
+/****************************************************************//**
+Creates the doublewrite buffers of the batch flushes of each buffer pool
+instance for innodb_parallel_doublewrite. Each of them is written to its
+own file, so that the batch flushes of the buffer pool instances do not
+wait for each other. */
+static
+void
+buf_dblwr_init_shards(void)
+/*=======================*/
+{
+	char	name[OS_FILE_MAX_PATH];
+
+	buf_dblwr->n_shards = srv_buf_pool_instances;
+	buf_dblwr->shards = static_cast<buf_dblwr_t*>(
+		mem_zalloc(buf_dblwr->n_shards * sizeof(buf_dblwr_t)));
+
+	for (ulint i = 0; i < buf_dblwr->n_shards; i++) {
+		buf_dblwr_t*	shard = &buf_dblwr->shards[i];
+		ibool		exists;
+		os_file_type_t	type;
+		ibool		success;
+
+		mutex_create(buf_dblwr_mutex_key,
+			     &shard->mutex, SYNC_DOUBLEWRITE);
+
+		shard->b_event = os_event_create();
+
+		shard->write_buf_unaligned = static_cast<byte*>(
+			ut_malloc((1 + srv_doublewrite_batch_size)
+				  * UNIV_PAGE_SIZE));
+
+		shard->write_buf = static_cast<byte*>(
+			ut_align(shard->write_buf_unaligned,
+				 UNIV_PAGE_SIZE));
+
+		shard->buf_block_arr = static_cast<buf_page_t**>(
+			mem_zalloc(srv_doublewrite_batch_size
+				   * sizeof(void*)));
+
+		buf_dblwr_shard_file_name(name, sizeof(name), i);
+		shard->file_name = mem_strdup(name);
+
+		if (!os_file_status(name, &exists, &type)) {
+			exists = FALSE;
+		}
+
+		shard->file = os_file_create(
+			innodb_file_data_key, name,
+			exists ? OS_FILE_OPEN : OS_FILE_CREATE,
+			OS_FILE_NORMAL, OS_DATA_FILE, &success, FALSE);
+
+		if (!success) {
+			ib_logf(IB_LOG_LEVEL_FATAL,
+				"Cannot open the doublewrite file %s", name);
+		}
+
+		if (!exists
+		    && !os_file_set_size(name, shard->file,
+					 srv_doublewrite_batch_size
+					 * UNIV_PAGE_SIZE)) {
+			ib_logf(IB_LOG_LEVEL_FATAL,
+				"Cannot extend the doublewrite file %s", name);
+		}
+	}
+}
+
+/****************************************************************//**
+Reads the pages of the doublewrite files of innodb_parallel_doublewrite
+that exist, whether or not the option is set now, for the crash recovery.
+The pages are kept in the recv_sys->dblwr buffers, which are freed when
+the recovery is over. */
+static
+void
+buf_dblwr_load_shard_files(void)
+/*============================*/
+{
+	recv_dblwr_t&	recv_dblwr = recv_sys->dblwr;
+
+	for (ulint i = 0; i < MAX_BUFFER_POOLS; i++) {
+		char		name[OS_FILE_MAX_PATH];
+		ibool		exists;
+		os_file_type_t	type;
+		ibool		success;
+		os_file_t	file;
+		os_offset_t	size;
+		ulint		n_pages;
+
+		buf_dblwr_shard_file_name(name, sizeof(name), i);
+
+		if (!os_file_status(name, &exists, &type) || !exists) {
+			continue;
+		}
+
+		file = os_file_create_simple_no_error_handling(
+			innodb_file_data_key, name, OS_FILE_OPEN,
+			OS_FILE_READ_ONLY, &success, FALSE);
+
+		if (!success) {
+			ib_logf(IB_LOG_LEVEL_WARN,
+				"Cannot open the doublewrite file %s", name);
+			continue;
+		}
+
+		size = os_file_get_size(file);
+
+		/* The batch size is less than the size of the
+		doublewrite buffer in the system tablespace. */
+		n_pages = size == (os_offset_t) -1
+			? 0
+			: (ulint) ut_min(size / UNIV_PAGE_SIZE,
+					 (os_offset_t)
+					 (TRX_SYS_DOUBLEWRITE_BLOCKS
+					  * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE));
+
+		if (n_pages > 0) {
+			byte*	unaligned_buf = static_cast<byte*>(
+				ut_malloc((1 + n_pages) * UNIV_PAGE_SIZE));
+			byte*	buf = static_cast<byte*>(
+				ut_align(unaligned_buf, UNIV_PAGE_SIZE));
+
+			if (os_file_read(file, buf, 0,
+					 n_pages * UNIV_PAGE_SIZE, FALSE)) {
+				recv_dblwr.bufs.push_back(unaligned_buf);
+
+				for (ulint j = 0; j < n_pages; j++) {
+					recv_dblwr.add(buf
+						       + j * UNIV_PAGE_SIZE);
+				}
+			} else {
+				ut_free(unaligned_buf);
+			}
+		}
+
+		os_file_close(file);
+	}
+}
+
 /****************************************************************//**
 Creates or initialializes the doublewrite buffer at a database start. */
 static
@@ -171,6 +323,11 @@ buf_dblwr_init(
 
 	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
 		mem_zalloc(buf_size * sizeof(void*)));
+
+	if (srv_use_doublewrite_buf && srv_parallel_doublewrite
+	    && !srv_read_only_mode) {
+		buf_dblwr_init_shards();
+	}
 }
 
 /****************************************************************//**
@@ -474,6 +631,10 @@ buf_dblwr_init_or_load_pages(
 		os_file_flush(file);
 	}
 
+	if (load_corrupt_pages) {
+		buf_dblwr_load_shard_files();
+	}
+
 leave_func:
 	ut_free(unaligned_read_buf);
 }
@@ -508,6 +669,11 @@ buf_dblwr_process()
 			/* Maybe we have dropped the single-table tablespace
 			and this page once belonged to it: do nothing */
 
+		} else if (recv_dblwr.find_page(space_id, page_no) != page) {
+			/* A newer copy of the page is in the doublewrite
+			buffer, or in another doublewrite file of
+			innodb_parallel_doublewrite: only restore that one */
+
 		} else if (!fil_check_adress_in_tablespace(space_id,
 							   page_no)) {
 			ib_logf(IB_LOG_LEVEL_WARN,
@@ -647,6 +813,44 @@ buf_dblwr_process()
 		fil_io(OS_FILE_WRITE, true, TRX_SYS_SPACE, 0,
 			buf_dblwr->block2, 0, bytes, buf, NULL, NULL, 0, false);
 
+		/* Clear the doublewrite files of innodb_parallel_doublewrite
+		and remove the ones that are not used any more */
+		for (ulint i = 0; i < MAX_BUFFER_POOLS; i++) {
+			if (i < buf_dblwr->n_shards) {
+				buf_dblwr_t*	shard = &buf_dblwr->shards[i];
+				ibool		success = TRUE;
+
+				for (ulint j = 0;
+				     j < srv_doublewrite_batch_size;
+				     j += TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+					ulint	n = ut_min(
+						TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
+						srv_doublewrite_batch_size
+						- j);
+
+					success = success
+						&& os_file_write(
+							shard->file_name,
+							shard->file, buf,
+							j * UNIV_PAGE_SIZE,
+							n * UNIV_PAGE_SIZE);
+				}
+
+				if (!success || !os_file_flush(shard->file)) {
+					ib_logf(IB_LOG_LEVEL_FATAL,
+						"Cannot clear the doublewrite"
+						" file %s", shard->file_name);
+				}
+			} else if (!srv_read_only_mode) {
+				char	name[OS_FILE_MAX_PATH];
+
+				buf_dblwr_shard_file_name(
+					name, sizeof(name), i);
+				os_file_delete_if_exists(
+					innodb_file_data_key, name);
+			}
+		}
+
 		ut_free(unaligned_buf);
         }
 }
@@ -674,11 +878,50 @@ buf_dblwr_free(void)
 	mem_free(buf_dblwr->in_use);
 	buf_dblwr->in_use = NULL;
 
+	for (ulint i = 0; i < buf_dblwr->n_shards; i++) {
+		buf_dblwr_t*	shard = &buf_dblwr->shards[i];
+
+		ut_ad(shard->b_reserved == 0);
+
+		os_file_close(shard->file);
+		mem_free(shard->file_name);
+		os_event_free(shard->b_event);
+		ut_free(shard->write_buf_unaligned);
+		mem_free(shard->buf_block_arr);
+		mutex_free(&shard->mutex);
+	}
+
+	if (buf_dblwr->shards != NULL) {
+		mem_free(buf_dblwr->shards);
+	}
+
 	mutex_free(&buf_dblwr->mutex);
 	mem_free(buf_dblwr);
 	buf_dblwr = NULL;
 }
 
+/********************************************************************//**
+Returns the doublewrite buffer used by the batch flushes of a page.
+@return buf_dblwr, or its shard of the buffer pool instance of the page
+if innodb_parallel_doublewrite is set */
+UNIV_INLINE
+buf_dblwr_t*
+buf_dblwr_get_batch(
+/*================*/
+	const buf_page_t*	bpage)	/*!< in: page to write */
+{
+	ulint	i;
+
+	if (buf_dblwr->shards == NULL) {
+		return(buf_dblwr);
+	}
+
+	i = buf_pool_from_bpage(bpage)->instance_no;
+	ut_ad(i < buf_dblwr->n_shards);
+
+	return(&buf_dblwr->shards[i]);
+}
+
 /********************************************************************//**
 Updates the doublewrite buffer when an IO request is completed. */
 UNIV_INTERN
@@ -688,35 +931,41 @@ buf_dblwr_update(
 	const buf_page_t*	bpage,	/*!< in: buffer block descriptor */
 	buf_flush_t		flush_type)/*!< in: flush type */
 {
-	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL
+	    || bpage->no_doublewrite) {
 		return;
 	}
 
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
-		mutex_enter(&buf_dblwr->mutex);
+		{
+			buf_dblwr_t*	dblwr = buf_dblwr_get_batch(bpage);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+			mutex_enter(&dblwr->mutex);
 
-		buf_dblwr->b_reserved--;
+			ut_ad(dblwr->batch_running);
+			ut_ad(dblwr->b_reserved > 0);
+			ut_ad(dblwr->b_reserved <= dblwr->first_free);
 
-		if (buf_dblwr->b_reserved == 0) {
-			mutex_exit(&buf_dblwr->mutex);
-			/* This will finish the batch. Sync data files
-			to the disk. */
-			fil_flush_file_spaces(FIL_TABLESPACE);
-			mutex_enter(&buf_dblwr->mutex);
+			dblwr->b_reserved--;
 
-			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
-		}
+			if (dblwr->b_reserved == 0) {
+				mutex_exit(&dblwr->mutex);
+				/* This will finish the batch. Sync data
+				files to the disk. */
+				fil_flush_file_spaces(FIL_TABLESPACE);
+				mutex_enter(&dblwr->mutex);
 
-		mutex_exit(&buf_dblwr->mutex);
+				/* We can now reuse the doublewrite memory
+				buffer: */
+				dblwr->first_free = 0;
+				dblwr->batch_running = false;
+				os_event_set(dblwr->b_event);
+			}
+
+			mutex_exit(&dblwr->mutex);
+		}
 		break;
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
@@ -886,73 +1135,70 @@ buf_dblwr_write_block_to_datafile(
 }
 
 /********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
-UNIV_INTERN
+Flushes possible buffered writes from a doublewrite memory buffer to disk,
+see buf_dblwr_flush_buffered_writes(). */
+static
 void
-buf_dblwr_flush_buffered_writes(void)
-/*=================================*/
+buf_dblwr_flush_batch(
+/*==================*/
+	buf_dblwr_t*	dblwr)	/*!< in/out: buf_dblwr or a shard of it */
 {
 	byte*		write_buf;
 	ulint		first_free;
 	ulint		len;
 
-	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
-		/* Sync the writes to the disk. */
-		buf_dblwr_sync_datafiles();
-		return;
-	}
-
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&dblwr->mutex);
 
 	/* Write first to doublewrite buffer blocks. We use synchronous
 	aio and thus know that file write has been completed when the
 	control returns. */
 
-	if (buf_dblwr->first_free == 0) {
+	if (dblwr->first_free == 0) {
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&dblwr->mutex);
+
+		/* Pages of unlogged temporary tables are posted without
+		the doublewrite buffer, but with OS_AIO_SIMULATED_WAKE_LATER,
+		so wake the simulated aio threads for them. */
+		os_aio_simulated_wake_handler_threads();
 
 		return;
 	}
 
-	if (buf_dblwr->batch_running) {
+	if (dblwr->batch_running) {
 		/* Another thread is running the batch right now. Wait
 		for it to finish. */
-		ib_int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		ib_int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(dblwr->b_event, sig_count);
 		goto try_again;
 	}
 
-	ut_a(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
+	ut_a(!dblwr->batch_running);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
 
 	/* Disallow anyone else to post to doublewrite buffer or to
 	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
+	dblwr->batch_running = true;
+	first_free = dblwr->first_free;
 
 	/* Now safe to release the mutex. Note that though no other
 	thread is allowed to post to the doublewrite batch flushing
 	but any threads working on single page flushes are allowed
 	to proceed. */
-	mutex_exit(&buf_dblwr->mutex);
+	mutex_exit(&dblwr->mutex);
 
-	write_buf = buf_dblwr->write_buf;
+	write_buf = dblwr->write_buf;
 
 	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
+	     i < dblwr->first_free;
 	     len2 += UNIV_PAGE_SIZE, i++) {
 
 		const buf_block_t*	block;
 
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
+		block = (buf_block_t*) dblwr->buf_block_arr[i];
 
 		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
 		    || block->page.zip.data) {
@@ -970,15 +1216,31 @@ buf_dblwr_flush_buffered_writes(void)
 		buf_dblwr_check_page_lsn(write_buf + len2);
 	}
 
+	if (dblwr->file_name != NULL) {
+		/* Write out the doublewrite file of the shard */
+		if (!os_file_write(dblwr->file_name, dblwr->file, write_buf,
+				   0, first_free * UNIV_PAGE_SIZE)
+		    || !os_file_flush(dblwr->file)) {
+			ib_logf(IB_LOG_LEVEL_FATAL,
+				"Cannot write to the doublewrite file %s",
+				dblwr->file_name);
+		}
+
+		srv_stats.dblwr_pages_written.add(first_free);
+		srv_stats.dblwr_writes.inc();
+
+		goto write_datafiles;
+	}
+
 	/* Write out the first block of the doublewrite buffer */
 	len = ut_min(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-		     buf_dblwr->first_free) * UNIV_PAGE_SIZE;
+		     dblwr->first_free) * UNIV_PAGE_SIZE;
 
 	fil_io(OS_FILE_WRITE,
 		true,
 		TRX_SYS_SPACE,
 		0,
-		buf_dblwr->block1,
+		dblwr->block1,
 		0,
 		len,
 		(void*)
@@ -988,23 +1250,23 @@ buf_dblwr_flush_buffered_writes(void)
 		0,
 		false);
 
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+	if (dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
 		/* No unwritten pages in the second block. */
 		goto flush;
 	}
 
 	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
+	len = (dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
 	       * UNIV_PAGE_SIZE;
 
-	write_buf = buf_dblwr->write_buf
+	write_buf = dblwr->write_buf
 		    + TRX_SYS_DOUBLEWRITE_BLOCK_SIZE * UNIV_PAGE_SIZE;
 
 	fil_io(OS_FILE_WRITE,
 		true,
 		TRX_SYS_SPACE,
 		0,
-		buf_dblwr->block2,
+		dblwr->block2,
 		0,
 		len,
 		(void*) write_buf,
@@ -1015,31 +1277,32 @@ buf_dblwr_flush_buffered_writes(void)
 
 flush:
 	/* increment the doublewrite flushed pages counter */
-	srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
+	srv_stats.dblwr_pages_written.add(dblwr->first_free);
 	srv_stats.dblwr_writes.inc();
 
 	/* Now flush the doublewrite buffer data to disk */
 	fil_flush(TRX_SYS_SPACE);
 
+write_datafiles:
 	/* We know that the writes have been flushed to disk now
 	and in recovery we will find them in the doublewrite buffer
 	blocks. Next do the writes to the intended positions. */
 
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
+	/* Up to this point first_free and dblwr->first_free are
+	same because we have set the dblwr->batch_running flag
 	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
+	can't safely access dblwr->first_free in the loop below.
 	This is so because it is possible that after we are done with
 	the last iteration and before we terminate the loop, the batch
 	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
+	a new batch setting dblwr->first_free to a higher value.
+	If this happens and we are using dblwr->first_free in the
 	loop termination condition then we'll end up dispatching
 	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
+	ut_ad(first_free == dblwr->first_free);
 	for (ulint i = 0; i < first_free; i++) {
 		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+			dblwr->buf_block_arr[i], false);
 	}
 
 	/* Wake possible simulated aio thread to actually post the
@@ -1049,6 +1312,40 @@ buf_dblwr_flush_buffered_writes(void)
 	os_aio_simulated_wake_handler_threads();
 }
 
+/********************************************************************//**
+Flushes possible buffered writes from the doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. It is very
+important to call this function after a batch of writes has been posted,
+and also when we may have to wait for a page latch! Otherwise a deadlock
+of threads can occur. */
+UNIV_INTERN
+void
+buf_dblwr_flush_buffered_writes(
+/*============================*/
+	const buf_pool_t*	buf_pool)/*!< in: buffer pool instance
+					whose writes to flush when
+					innodb_parallel_doublewrite is set,
+					or NULL for all of them */
+{
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		return;
+	}
+
+	if (buf_dblwr->shards == NULL) {
+		buf_dblwr_flush_batch(buf_dblwr);
+	} else if (buf_pool != NULL) {
+		ut_ad(buf_pool->instance_no < buf_dblwr->n_shards);
+		buf_dblwr_flush_batch(
+			&buf_dblwr->shards[buf_pool->instance_no]);
+	} else {
+		for (ulint i = 0; i < buf_dblwr->n_shards; i++) {
+			buf_dblwr_flush_batch(&buf_dblwr->shards[i]);
+		}
+	}
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1059,17 +1356,18 @@ buf_dblwr_add_to_batch(
 /*====================*/
 	buf_page_t*	bpage)	/*!< in: buffer block to write */
 {
-	ulint	zip_size;
+	buf_dblwr_t*	dblwr = buf_dblwr_get_batch(bpage);
+	ulint		zip_size;
 
 	ut_a(buf_page_in_file(bpage));
 	ut_ad(!mutex_own(&buf_pool_from_bpage(bpage)->LRU_list_mutex));
 
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&dblwr->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	ut_a(dblwr->first_free <= srv_doublewrite_batch_size);
 
-	if (buf_dblwr->batch_running) {
+	if (dblwr->batch_running) {
 
 		/* This not nearly as bad as it looks. There is only
 		page_cleaner thread which does background flushing
@@ -1077,17 +1375,17 @@ buf_dblwr_add_to_batch(
 		point. The only exception is when a user thread is
 		forced to do a flush batch because of a sync
 		checkpoint. */
-		ib_int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		ib_int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(dblwr->b_event, sig_count);
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&(dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_batch(dblwr);
 
 		goto try_again;
 	}
@@ -1098,40 +1396,40 @@ buf_dblwr_add_to_batch(
 	if (zip_size) {
 		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
 		/* Copy the compressed page and clear the rest. */
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
+		memcpy(dblwr->write_buf
+		       + UNIV_PAGE_SIZE * dblwr->first_free,
                        frame, zip_size);
-		memset(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free
+		memset(dblwr->write_buf
+		       + UNIV_PAGE_SIZE * dblwr->first_free
 		       + zip_size, 0, UNIV_PAGE_SIZE - zip_size);
 	} else {
 		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
 		UNIV_MEM_ASSERT_RW(((buf_block_t*) bpage)->frame,
 				   UNIV_PAGE_SIZE);
 
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
+		memcpy(dblwr->write_buf
+		       + UNIV_PAGE_SIZE * dblwr->first_free,
 		       frame, UNIV_PAGE_SIZE);
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	dblwr->buf_block_arr[dblwr->first_free] = bpage;
 
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
+	dblwr->first_free++;
+	dblwr->b_reserved++;
 
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	ut_ad(!dblwr->batch_running);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
+	ut_ad(dblwr->b_reserved <= srv_doublewrite_batch_size);
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&(dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_batch(dblwr);
 
 		return;
 	}
 
-	mutex_exit(&(buf_dblwr->mutex));
+	mutex_exit(&(dblwr->mutex));
 }
 
 /********************************************************************//**
@@ -30,15 +30,19 @@ Created April 08, 2011 Vasil Dimov
 
 #include "buf0buf.h" /* srv_buf_pool_instances */
 #include "buf0dump.h"
+#include "buf0rea.h" /* buf_read_pages_async() */
 #include "db0err.h"
 #include "dict0dict.h" /* dict_operation_lock */
+#include "fil0fil.h" /* fil_page_get_type() */
 #include "os0file.h" /* OS_FILE_MAX_PATH */
 #include "os0sync.h" /* os_event* */
 #include "os0thread.h" /* os_thread_* */
+#include "page0page.h" /* page_is_leaf() */
 #include "srv0srv.h" /* srv_fast_shutdown, srv_buf_dump* */
 #include "srv0start.h" /* srv_shutdown_state */
 #include "sync0rw.h" /* rw_lock_s_lock() */
 #include "ut0byte.h" /* ut_ull_create() */
+#include "ut0rnd.h" /* ut_fold_ulint_pair() */
 #include "ut0sort.h" /* UT_SORT_FUNCTION_BODY */
 
 enum status_severity {
@@ -68,6 +72,37 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/* A page of a buffer pool dump with its recency. The dump file has one
+"space,page,age" line per page, the age being the position of the page
+from the head of its LRU list (0 for the most recently used pages, and
+for the non-leaf B-tree pages, which are always wanted). Dumps of older
+versions only have "space,page" lines, listed from the LRU tail. */
+struct buf_dump_page_t {
+	buf_dump_t	id;	/*!< BUF_DUMP_CREATE(space, page) */
+	ulint		age;	/*!< age of the page in the dump; while
+				loading, the wave the page is read in */
+};
+
+/* A load reads the pages in waves of decreasing recency: wave 0 holds
+the pages dumped with age 0, and the rest of the pages are divided
+between the other waves by their age. Within a wave the pages are read
+in space,page order so that adjacent pages can be read together. */
+#define BUF_LOAD_N_WAVES	8
+
+/* Maximum number of adjacent pages read in one batch by a load thread.
+The pages are divided between the load threads by areas of this size. */
+#define BUF_LOAD_AREA		64
+
+/* Number of pages read so far by the load threads */
+static ulint	buf_load_n_pages_read;
+
+/* Number of load threads that have not exited yet */
+static ulint	buf_load_n_threads_active;
+
+#ifdef UNIV_PFS_THREAD
+UNIV_INTERN mysql_pfs_key_t	buf_load_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -167,6 +202,29 @@ buf_load_status(
 	va_end(ap);
 }
 
+/*****************************************************************//**
+Checks if a page in the LRU list is a non-leaf B-tree page. The frame is
+looked at without latching the block, which is fine for the hint that
+is stored in the dump.
+@return true if the page is a non-leaf index page */
+static
+bool
+buf_dump_is_node_ptr_page(
+/*======================*/
+	const buf_page_t*	bpage)	/*!< in: page in the LRU list */
+{
+	const byte*	frame;
+
+	if (buf_page_get_state(bpage) != BUF_BLOCK_FILE_PAGE) {
+		return(false);
+	}
+
+	frame = reinterpret_cast<const buf_block_t*>(bpage)->frame;
+
+	return(fil_page_get_type(frame) == FIL_PAGE_INDEX
+	       && !page_is_leaf(frame));
+}
+
 /*****************************************************************//**
 Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -212,7 +270,7 @@ buf_dump(
 	for (i = 0; i < srv_buf_pool_instances && !SHOULD_QUIT(); i++) {
 		buf_pool_t*		buf_pool;
 		const buf_page_t*	bpage;
-		buf_dump_t*		dump;
+		buf_dump_page_t*	dump;
 		ulint			n_pages;
 		ulint			j;
 
@@ -230,7 +288,7 @@ buf_dump(
 			continue;
 		}
 
-		dump = static_cast<buf_dump_t*>(
+		dump = static_cast<buf_dump_page_t*>(
 			ut_malloc(n_pages * sizeof(*dump))) ;
 
 		if (dump == NULL) {
@@ -244,14 +302,17 @@ buf_dump(
 			return;
 		}
 
-		for (bpage = UT_LIST_GET_LAST(buf_pool->LRU), j = 0;
+		for (bpage = UT_LIST_GET_FIRST(buf_pool->LRU), j = 0;
 		     bpage != NULL;
-		     bpage = UT_LIST_GET_PREV(LRU, bpage), j++) {
+		     bpage = UT_LIST_GET_NEXT(LRU, bpage), j++) {
 
 			ut_a(buf_page_in_file(bpage));
 
-			dump[j] = BUF_DUMP_CREATE(buf_page_get_space(bpage),
-						  buf_page_get_page_no(bpage));
+			dump[j].id = BUF_DUMP_CREATE(
+				buf_page_get_space(bpage),
+				buf_page_get_page_no(bpage));
+			dump[j].age = buf_dump_is_node_ptr_page(bpage)
+				? 0 : j;
 		}
 
 		ut_a(j == n_pages);
@@ -259,9 +320,10 @@ buf_dump(
 		mutex_exit(&buf_pool->LRU_list_mutex);
 
 		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
-				      BUF_DUMP_SPACE(dump[j]),
-				      BUF_DUMP_PAGE(dump[j]));
+			ret = fprintf(f, ULINTPF "," ULINTPF "," ULINTPF "\n",
+				      BUF_DUMP_SPACE(dump[j].id),
+				      BUF_DUMP_PAGE(dump[j].id),
+				      dump[j].age);
 			if (ret < 0) {
 				ut_free(dump);
 				fclose(f);
@@ -325,20 +387,23 @@ buf_dump(
 }
 
 /*****************************************************************//**
-Compare two buffer pool dump entries, used to sort the dump on
-space_no,page_no before loading in order to increase the chance for
-sequential IO.
+Compare two buffer pool dump entries on wave (or age), space_no, page_no.
+This orders the dump by recency before the waves are assigned, and by
+wave and then space_no,page_no before loading in order to increase the
+chance for sequential IO.
 @return -1/0/1 if entry 1 is smaller/equal/bigger than entry 2 */
 static
 lint
 buf_dump_cmp(
 /*=========*/
-	const buf_dump_t	d1,	/*!< in: buffer pool dump entry 1 */
-	const buf_dump_t	d2)	/*!< in: buffer pool dump entry 2 */
+	const buf_dump_page_t&	d1,	/*!< in: buffer pool dump entry 1 */
+	const buf_dump_page_t&	d2)	/*!< in: buffer pool dump entry 2 */
 {
-	if (d1 < d2) {
+	if (d1.age != d2.age) {
+		return(d1.age < d2.age ? -1 : 1);
+	} else if (d1.id < d2.id) {
 		return(-1);
-	} else if (d1 == d2) {
+	} else if (d1.id == d2.id) {
 		return(0);
 	} else {
 		return(1);
@@ -346,26 +411,143 @@ buf_dump_cmp(
 }
 
 /*****************************************************************//**
-Sort a buffer pool dump on space_no, page_no. */
+Sort a buffer pool dump on age, space_no, page_no. */
 static
 void
 buf_dump_sort(
 /*==========*/
-	buf_dump_t*	dump,	/*!< in/out: buffer pool dump to sort */
-	buf_dump_t*	tmp,	/*!< in/out: temp storage */
-	ulint		low,	/*!< in: lowest index (inclusive) */
-	ulint		high)	/*!< in: highest index (non-inclusive) */
+	buf_dump_page_t*	dump,	/*!< in/out: buffer pool dump to sort */
+	buf_dump_page_t*	tmp,	/*!< in/out: temp storage */
+	ulint			low,	/*!< in: lowest index (inclusive) */
+	ulint			high)	/*!< in: highest index
+					(non-inclusive) */
 {
 	UT_SORT_FUNCTION_BODY(buf_dump_sort, dump, tmp, low, high,
 			      buf_dump_cmp);
 }
 
+/*****************************************************************//**
+Reads the next line of a buffer pool dump file.
+@return number of fields read: 3 for "space,page,age", 2 for the
+"space,page" lines of older dumps, 0 at the end of the file or -1 if
+the line could not be read or parsed */
+static
+int
+buf_load_read_line(
+/*===============*/
+	FILE*	f,		/*!< in: dump file */
+	ulint*	space_id,	/*!< out: space id */
+	ulint*	page_no,	/*!< out: page number */
+	ulint*	age)		/*!< out: age of the page */
+{
+	char	line[80];
+	int	n;
+
+	if (fgets(line, sizeof(line), f) == NULL) {
+		return(ferror(f) ? -1 : 0);
+	}
+
+	n = sscanf(line, ULINTPF "," ULINTPF "," ULINTPF,
+		   space_id, page_no, age);
+
+	return(n >= 2 ? n : -1);
+}
+
+/*****************************************************************//**
+Returns the load thread that reads a page: the pages are divided between
+the threads by areas of BUF_LOAD_AREA pages, so that the pages of one
+area can be merged into one read and that a big tablespace is read by
+all the threads.
+@return load thread number */
+static inline
+ulint
+buf_load_thread_no(
+/*===============*/
+	buf_dump_t	id,		/*!< in: BUF_DUMP_CREATE(space, page) */
+	ulint		n_threads)	/*!< in: number of load threads */
+{
+	return(ut_fold_ulint_pair(BUF_DUMP_SPACE(id),
+				  BUF_DUMP_PAGE(id) / BUF_LOAD_AREA)
+	       % n_threads);
+}
+
+/** Arguments of buf_load_thread() */
+struct buf_load_arg_t {
+	const buf_dump_page_t*	dump;	/*!< dump sorted by wave, space,
+					page */
+	ulint			dump_n;	/*!< number of pages in dump */
+	ulint			thread_no;/*!< number of this thread */
+	ulint			n_threads;/*!< number of load threads */
+};
+
+/*****************************************************************//**
+Thread reading its share of the pages of a buffer pool load, see
+buf_load_thread_no(). The runs of adjacent pages of a wave are read with
+one buf_read_pages_async() call each.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_load_thread)(
+/*============================*/
+	void*	arg)	/*!< in: buf_load_arg_t */
+{
+	const buf_load_arg_t*	load_arg
+		= static_cast<const buf_load_arg_t*>(arg);
+	const buf_dump_page_t*	dump = load_arg->dump;
+	ulint			i = 0;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_load_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	while (i < load_arg->dump_n
+	       && !buf_load_abort_flag && !SHUTTING_DOWN()) {
+
+		ulint	j;
+		ulint	n_pages;
+
+		if (buf_load_thread_no(dump[i].id, load_arg->n_threads)
+		    != load_arg->thread_no) {
+			i++;
+			continue;
+		}
+
+		/* Collect the pages following dump[i] in its wave and
+		area */
+		for (j = i + 1, n_pages = 1;
+		     j < load_arg->dump_n
+		     && dump[j].age == dump[i].age
+		     && dump[j].id == dump[i].id + n_pages
+		     && BUF_DUMP_PAGE(dump[j].id) % BUF_LOAD_AREA != 0;
+		     j++, n_pages++) {
+		}
+
+		buf_read_pages_async(BUF_DUMP_SPACE(dump[i].id),
+				     BUF_DUMP_PAGE(dump[i].id), n_pages);
+
+		os_atomic_increment_ulint(&buf_load_n_pages_read, n_pages);
+
+		i = j;
+	}
+
+	os_atomic_decrement_ulint(&buf_load_n_threads_active, 1);
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
 innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
 The dump filename can be specified by (relative to srv_data_home):
-SET GLOBAL innodb_buffer_pool_filename='filename'; */
+SET GLOBAL innodb_buffer_pool_filename='filename';
+The pages are read by innodb_buffer_pool_load_threads buf_load_thread()s,
+the most recently used pages first. */
 static
 void
 buf_load()
@@ -374,14 +556,20 @@ buf_load()
 	char		full_filename[OS_FILE_MAX_PATH];
 	char		now[32];
 	FILE*		f;
-	buf_dump_t*	dump;
-	buf_dump_t*	dump_tmp;
+	buf_dump_page_t*	dump;
+	buf_dump_page_t*	dump_tmp;
+	buf_load_arg_t*	load_args;
 	ulint		dump_n;
 	ulint		total_buffer_pools_pages;
+	ulint		n_threads;
+	ulint		start_time;
+	ulint		elapsed;
 	ulint		i;
 	ulint		space_id;
 	ulint		page_no;
-	int		fscanf_ret;
+	ulint		age;
+	ibool		has_age = TRUE;
+	int		ret;
 
 	/* Ignore any leftovers from before */
 	buf_load_abort_flag = FALSE;
@@ -403,16 +591,15 @@ buf_load()
 	/* else */
 
 	/* First scan the file to estimate how many entries are in it.
-	This file is tiny (approx 500KB per 1GB buffer pool), reading it
+	This file is tiny (approx 700KB per 1GB buffer pool), reading it
 	two times is fine. */
 	dump_n = 0;
-	while (fscanf(f, ULINTPF "," ULINTPF, &space_id, &page_no) == 2
+	while ((ret = buf_load_read_line(f, &space_id, &page_no, &age)) > 0
 	       && !SHUTTING_DOWN()) {
 		dump_n++;
 	}
 
-	if (!SHUTTING_DOWN() && !feof(f)) {
-		/* fscanf() returned != 2 */
+	if (!SHUTTING_DOWN() && ret < 0) {
 		const char*	what;
 		if (ferror(f)) {
 			what = "reading";
@@ -435,7 +622,8 @@ buf_load()
 		dump_n = total_buffer_pools_pages;
 	}
 
-	dump = static_cast<buf_dump_t*>(ut_malloc(dump_n * sizeof(*dump)));
+	dump = static_cast<buf_dump_page_t*>(
+		ut_malloc(dump_n * sizeof(*dump)));
 
 	if (dump == NULL) {
 		fclose(f);
@@ -446,7 +634,7 @@ buf_load()
 		return;
 	}
 
-	dump_tmp = static_cast<buf_dump_t*>(
+	dump_tmp = static_cast<buf_dump_page_t*>(
 		ut_malloc(dump_n * sizeof(*dump_tmp)));
 
 	if (dump_tmp == NULL) {
@@ -462,11 +650,10 @@ buf_load()
 	rewind(f);
 
 	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-		fscanf_ret = fscanf(f, ULINTPF "," ULINTPF,
-				    &space_id, &page_no);
+		ret = buf_load_read_line(f, &space_id, &page_no, &age);
 
-		if (fscanf_ret != 2) {
-			if (feof(f)) {
+		if (ret <= 0) {
+			if (ret == 0) {
 				break;
 			}
 			/* else */
@@ -496,7 +683,12 @@ buf_load()
 			return;
 		}
 
-		dump[i] = BUF_DUMP_CREATE(space_id, page_no);
+		if (ret == 2) {
+			has_age = FALSE;
+		}
+
+		dump[i].id = BUF_DUMP_CREATE(space_id, page_no);
+		dump[i].age = age;
 	}
 
 	/* Set dump_n to the actual number of initialized elements,
@@ -508,6 +700,7 @@ buf_load()
 
 	if (dump_n == 0) {
 		ut_free(dump);
+		ut_free(dump_tmp);
 		ut_sprintf_timestamp(now);
 		buf_load_status(STATUS_NOTICE,
 				"Buffer pool(s) load completed at %s "
@@ -515,39 +708,78 @@ buf_load()
 		return;
 	}
 
+	if (!has_age) {
+		/* An older dump lists the pages from the LRU tail */
+		for (i = 0; i < dump_n; i++) {
+			dump[i].age = dump_n - 1 - i;
+		}
+	}
+
 	if (!SHUTTING_DOWN()) {
+		/* Sort the pages by age, assign them to the waves and
+		sort the waves by space_no,page_no */
+		buf_dump_sort(dump, dump_tmp, 0, dump_n);
+
+		for (i = 0; i < dump_n; i++) {
+			dump[i].age = dump[i].age == 0
+				? 0
+				: 1 + i * (BUF_LOAD_N_WAVES - 1) / dump_n;
+		}
+
 		buf_dump_sort(dump, dump_tmp, 0, dump_n);
 	}
 
 	ut_free(dump_tmp);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	n_threads = ut_min(srv_buf_load_threads, dump_n);
 
-		buf_read_page_async(BUF_DUMP_SPACE(dump[i]),
-				    BUF_DUMP_PAGE(dump[i]));
+	load_args = static_cast<buf_load_arg_t*>(
+		ut_malloc(n_threads * sizeof(*load_args)));
 
-		if (i % 64 == 63) {
-			os_aio_simulated_wake_handler_threads();
-		}
+	buf_load_n_pages_read = 0;
+	buf_load_n_threads_active = n_threads;
+	start_time = ut_time_ms();
 
-		if (i % 128 == 0) {
-			buf_load_status(STATUS_INFO,
-					"Loaded " ULINTPF "/" ULINTPF " pages",
-					i + 1, dump_n);
-		}
+	for (i = 0; i < n_threads; i++) {
+		load_args[i].dump = dump;
+		load_args[i].dump_n = dump_n;
+		load_args[i].thread_no = i;
+		load_args[i].n_threads = n_threads;
+		os_thread_create(buf_load_thread, &load_args[i], NULL);
+	}
 
-		if (buf_load_abort_flag) {
-			buf_load_abort_flag = FALSE;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_NOTICE,
-				"Buffer pool(s) load aborted on request");
-			return;
-		}
+	/* Wait for the load threads, which quit on shutdown or on
+	buf_load_abort() */
+	while (os_atomic_increment_ulint(&buf_load_n_threads_active, 0)) {
+
+		buf_load_status(STATUS_INFO,
+				"Loaded " ULINTPF "/" ULINTPF " pages",
+				os_atomic_increment_ulint(
+					&buf_load_n_pages_read, 0),
+				dump_n);
+
+		os_thread_sleep(100000);
 	}
 
+	ut_free(load_args);
 	ut_free(dump);
 
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = FALSE;
+		buf_load_status(
+			STATUS_NOTICE,
+			"Buffer pool(s) load aborted on request");
+		return;
+	}
+
+	elapsed = ut_time_ms() - start_time;
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Buffer pool(s) load read " ULINTPF " pages with " ULINTPF
+		" threads in " ULINTPF ".%03lu seconds",
+		buf_load_n_pages_read, n_threads,
+		elapsed / 1000, (ulong) (elapsed % 1000));
+
 	ut_sprintf_timestamp(now);
 
 	buf_load_status(STATUS_NOTICE,
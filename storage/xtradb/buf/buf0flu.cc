@@ -881,6 +881,10 @@ buf_flush_write_block_low(
 	page_t*	frame		= NULL;
 	ulint space_id          = buf_page_get_space(bpage);
 	atomic_writes_t awrites = fil_space_get_atomic_writes(space_id);
+	/* Nothing of an unlogged temporary table is recovered after a
+	crash, so its pages need not be in the redo log before they are
+	written, and a torn page does not matter. */
+	const bool	unlogged = fil_space_is_unlogged(space_id);
 
 #ifdef UNIV_DEBUG
 	buf_pool_t*	buf_pool = buf_pool_from_bpage(bpage);
@@ -918,7 +922,10 @@ buf_flush_write_block_low(
 	}
 #else
 	/* Force the log to the disk before writing the modified block */
-	log_write_up_to(bpage->newest_modification, LOG_WAIT_ALL_GROUPS, TRUE);
+	if (!unlogged) {
+		log_write_up_to(bpage->newest_modification,
+				LOG_WAIT_ALL_GROUPS, TRUE);
+	}
 #endif
 	switch (buf_page_get_state(bpage)) {
 	case BUF_BLOCK_POOL_WATCH:
@@ -953,7 +960,9 @@ buf_flush_write_block_low(
 
 	frame = buf_page_encrypt_before_write(bpage, frame);
 
-	if (!srv_use_doublewrite_buf || !buf_dblwr) {
+	bpage->no_doublewrite = unlogged;
+
+	if (!srv_use_doublewrite_buf || !buf_dblwr || unlogged) {
 		fil_io(OS_FILE_WRITE | OS_AIO_SIMULATED_WAKE_LATER,
 			sync,
 			buf_page_get_space(bpage),
@@ -1103,8 +1112,9 @@ buf_flush_page(
 		    && !rw_lock_s_lock_gen_nowait(rw_lock, BUF_IO_WRITE)) {
 			/* avoiding deadlock possibility involves doublewrite
 			buffer, should flush it, because it might hold the
-			another block->lock. */
-			buf_dblwr_flush_buffered_writes();
+			another block->lock. This thread may have posted
+			writes of other buffer pool instances, too. */
+			buf_dblwr_flush_buffered_writes(NULL);
 
 			rw_lock_s_lock_gen(rw_lock, BUF_IO_WRITE);
                 }
@@ -1844,11 +1854,14 @@ Gather the aggregated stats for both flush list and LRU list flushing */
 void
 buf_flush_common(
 /*=============*/
+	const buf_pool_t*	buf_pool,	/*!< in: buffer pool instance
+						that was flushed, or NULL if
+						all of them were */
 	buf_flush_t	flush_type,	/*!< in: type of flush */
 	ulint		page_count)	/*!< in: number of pages flushed */
 {
 	if (page_count) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool);
 	}
 
 	ut_a(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
@@ -2005,7 +2018,7 @@ buf_flush_LRU(
 
 	buf_flush_end(buf_pool, BUF_FLUSH_LRU);
 
-	buf_flush_common(BUF_FLUSH_LRU, n->flushed);
+	buf_flush_common(buf_pool, BUF_FLUSH_LRU, n->flushed);
 
 	return(true);
 }
@@ -2131,7 +2144,7 @@ buf_flush_list(
 			}
 		}
 
-		buf_flush_common(BUF_FLUSH_LIST, flush_common_batch);
+		buf_flush_common(NULL, BUF_FLUSH_LIST, flush_common_batch);
 	}
 
 	/* If we haven't flushed all the instances due to timeout or a repeat
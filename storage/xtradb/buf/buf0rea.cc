@@ -524,6 +524,57 @@ buf_read_page_async(
 	return(count > 0);
 }
 
+/********************************************************************//**
+High-level function which reads a range of pages asynchronously from a file
+to the buffer buf_pool, skipping the pages that are already there. The
+requests are queued before the i/o handler threads are woken up, so that
+they can be merged into bigger reads.
+@return number of page read requests issued */
+UNIV_INTERN
+ulint
+buf_read_pages_async(
+/*=================*/
+	ulint	space,	/*!< in: space id */
+	ulint	offset,	/*!< in: first page number */
+	ulint	n_pages)/*!< in: number of pages */
+{
+	ulint		zip_size;
+	ib_int64_t	tablespace_version;
+	ulint		count = 0;
+	dberr_t		err;
+
+	zip_size = fil_space_get_zip_size(space);
+
+	if (zip_size == ULINT_UNDEFINED) {
+		return(0);
+	}
+
+	tablespace_version = fil_space_get_version(space);
+
+	os_aio_simulated_put_read_threads_to_sleep();
+
+	for (ulint i = offset; i < offset + n_pages; i++) {
+		count += buf_read_page_low(
+			&err, false, BUF_READ_ANY_PAGE
+			| OS_AIO_SIMULATED_WAKE_LATER
+			| BUF_READ_IGNORE_NONEXISTENT_PAGES,
+			space, zip_size, FALSE, tablespace_version, i, NULL);
+
+		if (err == DB_TABLESPACE_DELETED) {
+			break;
+		}
+	}
+
+	os_aio_simulated_wake_handler_threads();
+
+	srv_stats.buf_pool_reads.add(count);
+
+	/* As in buf_read_page_async(), these deliberate reads are not
+	counted in the LRU policy heuristics. */
+
+	return(count);
+}
+
 /********************************************************************//**
 Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
@@ -319,6 +319,7 @@ dict_build_table_def_step(
 		}
 
 		mtr_start(&mtr);
+		dict_disable_redo_if_unlogged(table, &mtr);
 
 		fsp_header_init(table->space, FIL_IBD_FILE_INITIAL_SIZE, &mtr);
 
@@ -1790,6 +1791,116 @@ dict_create_or_check_sys_tablespace(void)
 	return(err);
 }
 
+/****************************************************************//**
+Creates the SYS_COLUMNS_ADDED system table, which holds the default
+values of columns that were added by ALTER TABLE without rebuilding
+the table, at server bootstrap or server start if it is not found or
+is not of the right form. A missing table is only created if the
+global innodb_instant_add_column is ON.
+@return	DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+dict_create_or_check_sys_columns_added(void)
+/*========================================*/
+{
+	trx_t*		trx;
+	my_bool		srv_file_per_table_backup;
+	dberr_t		err;
+	dberr_t		sys_columns_added_err;
+
+	ut_a(srv_get_active_thread_type() == SRV_NONE);
+
+	/* Note: The master thread has not been started at this point. */
+
+	sys_columns_added_err = dict_check_if_system_table_exists(
+		"SYS_COLUMNS_ADDED", DICT_NUM_FIELDS__SYS_COLUMNS_ADDED + 1, 1);
+
+	if (sys_columns_added_err == DB_SUCCESS) {
+		return(DB_SUCCESS);
+	}
+
+	if (sys_columns_added_err == DB_TABLE_NOT_FOUND
+	    && !thd_instant_add_column(NULL)) {
+		/* Creating the table changes the format of the system
+		tablespace for good. Only do it when the server is
+		started with innodb_instant_add_column=ON. */
+		return(DB_SUCCESS);
+	}
+
+	trx = trx_allocate_for_mysql();
+
+	trx_set_dict_operation(trx, TRX_DICT_OP_TABLE);
+
+	trx->op_info = "creating added columns sys table";
+
+	row_mysql_lock_data_dictionary(trx);
+
+	if (sys_columns_added_err == DB_CORRUPTION) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"Dropping incompletely created "
+			"SYS_COLUMNS_ADDED table.");
+		row_drop_table_for_mysql("SYS_COLUMNS_ADDED", trx, TRUE);
+	}
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Creating added columns system table.");
+
+	/* We always want SYSTEM tables to be created inside the system
+	tablespace. */
+	srv_file_per_table_backup = srv_file_per_table;
+	srv_file_per_table = 0;
+
+	err = que_eval_sql(
+		NULL,
+		"PROCEDURE CREATE_SYS_COLUMNS_ADDED_PROC () IS\n"
+		"BEGIN\n"
+		"CREATE TABLE SYS_COLUMNS_ADDED(\n"
+		" TABLE_ID BINARY(8), POS INT, DEF_VAL BLOB);\n"
+		"CREATE UNIQUE CLUSTERED INDEX SYS_COLUMNS_ADDED_ID_POS"
+		" ON SYS_COLUMNS_ADDED (TABLE_ID, POS);\n"
+		"END;\n",
+		FALSE, trx);
+
+	if (err != DB_SUCCESS) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"Creation of SYS_COLUMNS_ADDED "
+			"has failed with error %lu.  Tablespace is full. "
+			"Dropping incompletely created table.",
+			(ulong) err);
+
+		ut_a(err == DB_OUT_OF_FILE_SPACE
+		     || err == DB_TOO_MANY_CONCURRENT_TRXS);
+
+		row_drop_table_for_mysql("SYS_COLUMNS_ADDED", trx, TRUE);
+
+		if (err == DB_OUT_OF_FILE_SPACE) {
+			err = DB_MUST_GET_MORE_FILE_SPACE;
+		}
+	}
+
+	trx_commit_for_mysql(trx);
+
+	row_mysql_unlock_data_dictionary(trx);
+
+	trx_free_for_mysql(trx);
+
+	srv_file_per_table = srv_file_per_table_backup;
+
+	if (err == DB_SUCCESS) {
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Added columns system table created.");
+	}
+
+	/* Note: The master thread has not been started at this point. */
+	/* Confirm and move to the non-LRU part of the table LRU list. */
+
+	sys_columns_added_err = dict_check_if_system_table_exists(
+		"SYS_COLUMNS_ADDED", DICT_NUM_FIELDS__SYS_COLUMNS_ADDED + 1, 1);
+	ut_a(sys_columns_added_err == DB_SUCCESS);
+
+	return(err);
+}
+
 /********************************************************************//**
 Add a single tablespace definition to the data dictionary tables in the
 database.
@@ -1154,6 +1154,132 @@ dict_table_add_system_columns(
 }
 
 #ifndef UNIV_HOTBACKUP
+/**********************************************************************//**
+Adds columns to a table in the dictionary cache after ALTER TABLE added
+them to the data dictionary without rebuilding the table. The columns
+are placed after the existing user columns and appended to the clustered
+index. Records that were inserted before the first such ALTER TABLE lack
+the columns; see dict_index_t::n_core_fields. */
+UNIV_INTERN
+void
+dict_table_add_instant_cols(
+/*========================*/
+	dict_table_t*		table,	/*!< in/out: table */
+	const dict_table_t*	add)	/*!< in: table object holding the
+					added columns and their default
+					values */
+{
+	const ulint	n_add	= add->n_def;
+	const ulint	n_user	= dict_table_get_n_user_cols(table);
+	const ulint	n_cols	= table->n_cols + n_add;
+	dict_index_t*	clust	= dict_table_get_first_index(table);
+	dict_col_t*	old_cols = table->cols;
+	dict_col_t*	cols;
+	dict_field_t*	fields;
+	const char*	sys_names;
+	const char*	end;
+	ulint		add_names_len;
+	char*		col_names;
+	ulint		i;
+
+	ut_ad(mutex_own(&dict_sys->mutex));
+	ut_ad(table->n_def == table->n_cols);
+	ut_ad(n_add > 0);
+	ut_ad(n_cols <= REC_MAX_N_FIELDS);
+	ut_ad(!dict_table_is_comp(table) == !dict_table_is_comp(add));
+
+	/* Place the added columns between the user columns and
+	the system columns. */
+	cols = static_cast<dict_col_t*>(
+		mem_heap_alloc(table->heap, n_cols * sizeof *cols));
+	memcpy(cols, old_cols, n_user * sizeof *cols);
+	memcpy(cols + n_user, add->cols, n_add * sizeof *cols);
+	memcpy(cols + n_user + n_add, old_cols + n_user,
+	       DATA_N_SYS_COLS * sizeof *cols);
+
+	for (i = n_user; i < n_cols; i++) {
+		cols[i].ind = (unsigned) i;
+	}
+
+	for (i = n_user; i < n_user + n_add; i++) {
+		if (cols[i].def_val != NULL) {
+			cols[i].def_val = static_cast<const byte*>(
+				mem_heap_dup(table->heap, cols[i].def_val,
+					     cols[i].def_val_len));
+		}
+	}
+
+	/* The column names are in the same order as the columns. */
+	sys_names = table->col_names;
+
+	for (i = 0; i < n_user; i++) {
+		sys_names += strlen(sys_names) + 1;
+	}
+
+	end = sys_names;
+
+	for (i = 0; i < DATA_N_SYS_COLS; i++) {
+		end += strlen(end) + 1;
+	}
+
+	add_names_len = 0;
+
+	for (i = 0; i < n_add; i++) {
+		add_names_len += strlen(add->col_names + add_names_len) + 1;
+	}
+
+	col_names = static_cast<char*>(
+		mem_heap_alloc(table->heap,
+			       (end - table->col_names) + add_names_len));
+	memcpy(col_names, table->col_names, sys_names - table->col_names);
+	memcpy(col_names + (sys_names - table->col_names),
+	       add->col_names, add_names_len);
+	memcpy(col_names + (sys_names - table->col_names) + add_names_len,
+	       sys_names, end - sys_names);
+
+	table->cols = cols;
+	table->col_names = col_names;
+	table->n_def = table->n_cols = (unsigned) n_cols;
+
+	/* Point the fields of all indexes to the new columns. */
+	for (dict_index_t* index = clust;
+	     index != NULL;
+	     index = dict_table_get_next_index(index)) {
+
+		for (i = 0; i < index->n_def; i++) {
+			dict_field_t*	field = dict_index_get_nth_field(
+				index, i);
+			ulint		col_no = field->col - old_cols;
+
+			if (col_no >= n_user) {
+				col_no += n_add;
+			}
+
+			field->col = &cols[col_no];
+			field->name = dict_table_get_col_name(table, col_no);
+		}
+	}
+
+	/* Append the added columns to the clustered index. */
+	if (!dict_index_is_instant(clust)) {
+		clust->n_core_fields = clust->n_fields;
+		clust->n_core_null_bytes = UT_BITS_IN_BYTES(
+			clust->n_nullable);
+	}
+
+	fields = static_cast<dict_field_t*>(
+		mem_heap_alloc(clust->heap,
+			       (clust->n_def + n_add) * sizeof *fields));
+	memcpy(fields, clust->fields, clust->n_def * sizeof *fields);
+	clust->fields = fields;
+
+	for (i = n_user; i < n_user + n_add; i++) {
+		dict_index_add_col(clust, table, &cols[i], 0);
+	}
+
+	clust->n_fields = clust->n_def;
+}
+
 /**********************************************************************//**
 Adds a table object to the dictionary cache. */
 UNIV_INTERN
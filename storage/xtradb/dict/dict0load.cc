@@ -1444,6 +1444,117 @@ dict_load_columns(
 	mtr_commit(&mtr);
 }
 
+/********************************************************************//**
+Loads the default values of the columns that were added to a table by
+ALTER TABLE without rebuilding it, and notes in the clustered index how
+many fields the records that were inserted before the first such ALTER
+TABLE contain. */
+static
+void
+dict_load_columns_added(
+/*====================*/
+	dict_table_t*	table,	/*!< in/out: table */
+	mem_heap_t*	heap)	/*!< in/out: memory heap
+				for temporary storage */
+{
+	dict_table_t*	sys_columns_added;
+	dict_index_t*	sys_index;
+	dict_index_t*	clust_index;
+	btr_pcur_t	pcur;
+	dtuple_t*	tuple;
+	dfield_t*	dfield;
+	byte*		buf;
+	ulint		n_added	= 0;
+	mtr_t		mtr;
+
+	ut_ad(mutex_own(&(dict_sys->mutex)));
+
+	clust_index = dict_table_get_first_index(table);
+	sys_columns_added = dict_table_get_low("SYS_COLUMNS_ADDED");
+
+	if (clust_index == NULL
+	    || sys_columns_added == NULL
+	    || sys_columns_added == table) {
+		/* The table is corrupted, or the system table
+		does not exist yet, or we are loading it. */
+		return;
+	}
+
+	sys_index = UT_LIST_GET_FIRST(sys_columns_added->indexes);
+	ut_ad(!dict_table_is_comp(sys_columns_added));
+
+	ut_ad(name_of_col_is(sys_columns_added, sys_index,
+			     DICT_FLD__SYS_COLUMNS_ADDED__DEF_VAL,
+			     "DEF_VAL"));
+
+	mtr_start(&mtr);
+
+	tuple = dtuple_create(heap, 1);
+	dfield = dtuple_get_nth_field(tuple, 0);
+
+	buf = static_cast<byte*>(mem_heap_alloc(heap, 8));
+	mach_write_to_8(buf, table->id);
+
+	dfield_set_data(dfield, buf, 8);
+	dict_index_copy_types(tuple, sys_index, 1);
+
+	btr_pcur_open_on_user_rec(sys_index, tuple, PAGE_CUR_GE,
+				  BTR_SEARCH_LEAF, &pcur, &mtr);
+
+	for (; btr_pcur_is_on_user_rec(&pcur);
+	     btr_pcur_move_to_next_user_rec(&pcur, &mtr)) {
+		const rec_t*	rec = btr_pcur_get_rec(&pcur);
+		const byte*	field;
+		ulint		len;
+		ulint		pos;
+		dict_col_t*	col;
+
+		field = rec_get_nth_field_old(
+			rec, DICT_FLD__SYS_COLUMNS_ADDED__TABLE_ID, &len);
+
+		if (len != 8 || mach_read_from_8(field) != table->id) {
+			break;
+		}
+
+		if (rec_get_deleted_flag(rec, 0)) {
+			continue;
+		}
+
+		field = rec_get_nth_field_old(
+			rec, DICT_FLD__SYS_COLUMNS_ADDED__POS, &len);
+		ut_a(len == 4);
+		pos = mach_read_from_4(field);
+		ut_a(pos < dict_table_get_n_user_cols(table));
+
+		field = rec_get_nth_field_old(
+			rec, DICT_FLD__SYS_COLUMNS_ADDED__DEF_VAL, &len);
+		/* ALTER TABLE refuses default values that could be
+		stored externally. */
+		ut_a(rec_get_1byte_offs_flag(rec)
+		     || !rec_2_is_field_extern(
+			     rec, DICT_FLD__SYS_COLUMNS_ADDED__DEF_VAL));
+
+		col = dict_table_get_nth_col(table, pos);
+		col->def_val = len == UNIV_SQL_NULL
+			? NULL
+			: static_cast<const byte*>(
+				mem_heap_dup(table->heap, field, len));
+		col->def_val_len = len;
+		n_added++;
+	}
+
+	btr_pcur_close(&pcur);
+	mtr_commit(&mtr);
+
+	if (n_added) {
+		ut_a(n_added < clust_index->n_fields);
+		clust_index->n_core_fields = clust_index->n_fields - n_added;
+		clust_index->n_core_null_bytes = UT_BITS_IN_BYTES(
+			dict_index_get_n_nullable(
+				clust_index, clust_index->n_core_fields));
+	}
+}
+
 /** Error message for a delete-marked record in dict_load_field_low() */
 static const char* dict_load_field_del = "delete-marked record in SYS_FIELDS";
 
@@ -2474,6 +2585,8 @@ dict_load_table(
 		}
 	}
 
+	dict_load_columns_added(table, heap);
+
 	/* Initialize table foreign_child value. Its value could be
 	changed when dict_load_foreigns() is called below */
 	table->fk_max_recusive_level = 0;
@@ -75,6 +75,9 @@ UNIV_INTERN os_event_t fil_crypt_throttle_sleep_event;
 /** Mutex for key rotation threads */
 UNIV_INTERN ib_mutex_t fil_crypt_threads_mutex;
 
+/** Whether fil_crypt_threads_init() has been called */
+static bool fil_crypt_threads_inited = false;
+
 #ifdef UNIV_PFS_MUTEX
 UNIV_INTERN mysql_pfs_key_t fil_crypt_threads_mutex_key;
 #endif
@@ -2289,6 +2292,7 @@ fil_crypt_threads_init()
 	fil_crypt_threads_event = os_event_create();
 	mutex_create(fil_crypt_threads_mutex_key,
 		     &fil_crypt_threads_mutex, SYNC_NO_ORDER_CHECK);
+	fil_crypt_threads_inited = true;
 
 	uint cnt = srv_n_fil_crypt_threads;
 	srv_n_fil_crypt_threads = 0;
@@ -2321,6 +2325,12 @@ void
 fil_space_crypt_mark_space_closing(
 	ulint space)
 {
+	if (!fil_crypt_threads_inited) {
+		/* Temporary tables are dropped at startup before the
+		key rotation threads are started. */
+		return;
+	}
+
 	mutex_enter(&fil_crypt_threads_mutex);
 	fil_space_crypt_t* crypt_data = fil_space_get_crypt_data(space);
 
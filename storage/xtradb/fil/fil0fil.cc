@@ -1599,6 +1599,35 @@ fil_space_get_flags(
 	return(flags);
 }
 
+/*******************************************************************//**
+Checks if the space is the tablespace of an unlogged temporary table.
+@return	true if the space is unlogged, false if not or if not found */
+UNIV_INTERN
+bool
+fil_space_is_unlogged(
+/*==================*/
+	ulint	id)	/*!< in: space id */
+{
+	fil_space_t*	space;
+	bool		unlogged;
+
+	ut_ad(fil_system);
+
+	if (!id) {
+		return(false);
+	}
+
+	mutex_enter(&fil_system->mutex);
+
+	space = fil_space_get_by_id(id);
+
+	unlogged = space != NULL && space->unlogged;
+
+	mutex_exit(&fil_system->mutex);
+
+	return(unlogged);
+}
+
 /*******************************************************************//**
 Returns the compressed page size of the space, or 0 if the space
 is not compressed. The tablespace must be cached in the memory cache.
@@ -3395,6 +3424,8 @@ fil_create_new_single_table_tablespace(
 	ibool		success;
 	/* TRUE if a table is created with CREATE TEMPORARY TABLE */
 	bool		is_temp = !!(flags2 & DICT_TF2_TEMPORARY);
+	/* TRUE if nothing of the table is written to the redo log */
+	bool		unlogged = is_temp && (flags2 & DICT_TF2_UNLOGGED);
 	bool		has_data_dir = FSP_FLAGS_HAS_DATA_DIR(flags);
 	ulint		atomic_writes = FSP_FLAGS_GET_ATOMIC_WRITES(flags);
 
@@ -3558,8 +3589,14 @@ fil_create_new_single_table_tablespace(
 		goto error_exit_1;
 	}
 
+	if (unlogged) {
+		mutex_enter(&fil_system->mutex);
+		fil_space_get_by_id(space_id)->unlogged = true;
+		mutex_exit(&fil_system->mutex);
+	}
+
 #ifndef UNIV_HOTBACKUP
-	{
+	if (!unlogged) {
 		mtr_t		mtr;
 		ulint		mlog_file_flag = 0;
 
@@ -330,6 +330,21 @@ static TYPELIB innodb_foreground_preflush_typelib = {
 	NULL
 };
 
+/** Possible values for system variable "innodb_deadlock_detect_mode".  */
+static const char* innodb_deadlock_detect_mode_names[] = {
+	"EAGER",
+	"BACKGROUND",
+	NullS
+};
+
+/** Enumeration for innodb_deadlock_detect_mode.  */
+static TYPELIB innodb_deadlock_detect_mode_typelib = {
+	array_elements(innodb_deadlock_detect_mode_names) - 1,
+	"innodb_deadlock_detect_mode_typelib",
+	innodb_deadlock_detect_mode_names,
+	NULL
+};
+
 /** Possible values for system variable "innodb_empty_free_list_algorithm".  */
 static const char* innodb_empty_free_list_algorithm_names[] = {
 	"LEGACY",
@@ -458,7 +473,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&buf_dblwr_mutex_key, "buf_dblwr_mutex", 0},
 	{&trx_undo_mutex_key, "trx_undo_mutex", 0},
 	{&srv_sys_mutex_key, "srv_sys_mutex", 0},
-	{&lock_sys_mutex_key, "lock_mutex", 0},
+	{&lock_sys_rec_mutex_key, "lock_rec_mutex", 0},
 	{&lock_sys_wait_mutex_key, "lock_wait_mutex", 0},
 	{&trx_mutex_key, "trx_mutex", 0},
 	{&srv_sys_tasks_mutex_key, "srv_threads_mutex", 0},
@@ -499,6 +514,7 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	{&checkpoint_lock_key, "checkpoint_lock", 0},
 	{&fts_cache_rw_lock_key, "fts_cache_rw_lock", 0},
 	{&fts_cache_init_rw_lock_key, "fts_cache_init_rw_lock", 0},
+	{&lock_sys_latch_key, "lock_sys_latch", 0},
 	{&trx_i_s_cache_lock_key, "trx_i_s_cache_lock", 0},
 	{&trx_purge_latch_key, "trx_purge_latch", 0},
 	{&index_tree_rw_lock_key, "index_tree_rw_lock", 0},
@@ -523,6 +539,9 @@ static PSI_thread_info	all_innodb_threads[] = {
 	{&buf_page_cleaner_thread_key, "page_cleaner_thread", 0},
 	{&buf_lru_manager_thread_key, "lru_manager_thread", 0},
 	{&recv_writer_thread_key, "recv_writer_thread", 0},
+	{&recv_apply_thread_key, "recv_apply_thread", 0},
+	{&buf_load_thread_key, "buf_load_thread", 0},
+	{&row_merge_thread_key, "row_merge_thread", 0},
 	{&srv_log_tracking_thread_key, "srv_redo_log_follow_thread", 0}
 };
 # endif /* UNIV_PFS_THREAD */
@@ -739,6 +758,16 @@ static MYSQL_THDVAR_BOOL(strict_mode, PLUGIN_VAR_OPCMDARG,
   "Use strict mode when evaluating create options.",
   NULL, NULL, FALSE);
 
+static MYSQL_THDVAR_BOOL(instant_add_column, PLUGIN_VAR_OPCMDARG,
+  "Let ALTER TABLE that only adds columns last add them without rebuilding"
+  " the table. This is a one-way change of the file format: such tables,"
+  " their redo log and the SYS_COLUMNS_ADDED table that is created when the"
+  " server starts with this option ON cannot be used by servers that do"
+  " not support it, and such a table cannot be exported with FLUSH"
+  " TABLES...FOR EXPORT until it is rebuilt. Tables are only altered this"
+  " way if SYS_COLUMNS_ADDED exists. Disabled by default.",
+  NULL, NULL, FALSE);
+
 static MYSQL_THDVAR_BOOL(ft_enable_stopword, PLUGIN_VAR_OPCMDARG,
   "Create FTS index with stopword.",
   NULL, NULL,
@@ -855,6 +884,10 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &export_vars.innodb_dblwr_writes,		  SHOW_LONG},
   {"deadlocks",
   (char*) &export_vars.innodb_deadlocks,		  SHOW_LONG},
+  {"deadlock_detect_time",
+  (char*) &export_vars.innodb_deadlock_detect_time,	  SHOW_LONGLONG},
+  {"deadlock_graph_size",
+  (char*) &export_vars.innodb_deadlock_graph_size,	  SHOW_LONG},
   {"have_atomic_builtins",
   (char*) &export_vars.innodb_have_atomic_builtins,	  SHOW_BOOL},
   {"history_list_length",
@@ -941,6 +974,10 @@ static SHOW_VAR innodb_status_variables[]= {
 #endif /* UNIV_DEBUG */
   {"read_views_memory",
   (char*) &export_vars.innodb_read_views_memory,	  SHOW_LONG},
+  {"read_views_recopied",
+  (char*) &export_vars.innodb_read_views_recopied,	  SHOW_LONG},
+  {"read_views_reused",
+  (char*) &export_vars.innodb_read_views_reused,	  SHOW_LONG},
   {"row_lock_current_waits",
   (char*) &export_vars.innodb_row_lock_current_waits,	  SHOW_LONG},
   {"row_lock_time",
@@ -1748,6 +1785,20 @@ thd_supports_xa(
 	return(THDVAR(thd, support_xa));
 }
 
+/******************************************************************//**
+Returns true if ALTER TABLE may add columns without rebuilding the table,
+global value of innodb_instant_add_column if thd is NULL.
+@return	true if columns can be added instantly */
+UNIV_INTERN
+bool
+thd_instant_add_column(
+/*===================*/
+	THD*	thd)	/*!< in: thread handle, or NULL to query
+			the global innodb_instant_add_column */
+{
+	return(THDVAR(thd, instant_add_column));
+}
+
 /******************************************************************//**
 Returns the lock wait timeout for the current connection.
 @return	the lock wait timeout, in seconds */
@@ -11764,6 +11815,10 @@ innobase_table_flags(
 
 	if (create_info->options & HA_LEX_CREATE_TMP_TABLE) {
 		*flags2 |= DICT_TF2_TEMPORARY;
+
+		if (use_tablespace && srv_unlogged_temp_tables) {
+			*flags2 |= DICT_TF2_UNLOGGED;
+		}
 	}
 
 	if (use_tablespace) {
@@ -11994,6 +12049,13 @@ ha_innobase::create(
 
 	/* Create the table definition in InnoDB */
 
+	/* An unlogged temporary table is always created in a tablespace
+	of its own, because nothing of its changes is in the redo log. */
+	if ((create_info->options & HA_LEX_CREATE_TMP_TABLE)
+	    && srv_unlogged_temp_tables) {
+		use_tablespace = true;
+	}
+
 	/* Validate table options not handled by the SQL-parser */
 	if(check_table_options(thd, form, create_info, use_tablespace,
 			       file_format)) {
@@ -19139,6 +19201,14 @@ static MYSQL_SYSVAR_BOOL(doublewrite, innobase_use_doublewrite,
   "Disable with --skip-innodb-doublewrite.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(parallel_doublewrite, srv_parallel_doublewrite,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use a doublewrite buffer and file (ib_doublewrite<N> in the data home"
+  " directory) for the batch flushes of each buffer pool instance, so that"
+  " they do not wait for each other. Single page flushes keep using the"
+  " doublewrite buffer of the system tablespace. Disabled by default.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_BOOL(use_atomic_writes, innobase_use_atomic_writes,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Prevent partial page writes, via atomic writes (beta). "
@@ -19217,6 +19287,15 @@ static MYSQL_SYSVAR_ULONG(purge_threads, srv_n_purge_threads,
   1,			/* Minimum value */
   SRV_MAX_N_PURGE_THREADS, 0);		/* Maximum value */
 
+static MYSQL_SYSVAR_ULONG(recovery_threads, srv_n_recovery_threads,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying redo log records in crash recovery. The pages"
+  " are divided between the threads by their hash. Default is 4.",
+  NULL, NULL,
+  4,			/* Default setting */
+  1,			/* Minimum value */
+  64, 0);		/* Maximum value */
+
 static MYSQL_SYSVAR_ULONG(sync_array_size, srv_sync_array_size,
   PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
   "Size of the mutex/lock wait array.",
@@ -19236,6 +19315,14 @@ static MYSQL_SYSVAR_BOOL(file_per_table, srv_file_per_table,
   "Stores each InnoDB table to an .ibd file in the database dir.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(unlogged_temp_tables, srv_unlogged_temp_tables,
+  PLUGIN_VAR_NOCMDARG,
+  "Store each InnoDB temporary table to an .ibd file in the temporary"
+  " directory, and do not write its changes to the redo log nor to the"
+  " doublewrite buffer. Such tables are removed after a crash anyway."
+  " Disabled by default.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_STR(file_format, innobase_file_format_name,
   PLUGIN_VAR_RQCMDARG,
   "File format to use for new tables in .ibd files.",
@@ -19660,6 +19747,15 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_load_at_startup, srv_buffer_pool_load_at_st
   "Load the buffer pool from a file named @@innodb_buffer_pool_filename",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_threads, srv_buf_load_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads reading the pages of a buffer pool load. The"
+  " pages are divided between the threads by areas of 64 pages. Default is 4.",
+  NULL, NULL,
+  4,			/* Default setting */
+  1,			/* Minimum value */
+  64, 0);		/* Maximum value */
+
 static MYSQL_SYSVAR_BOOL(defragment, srv_defragment,
   PLUGIN_VAR_RQCMDARG,
   "Enable/disable InnoDB defragmentation (default FALSE). When set to FALSE, all existing "
@@ -19807,6 +19903,16 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(index_build_threads, srv_index_build_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that read the clustered index, sort the index entries"
+  " and load them into the new indexes when creating indexes. Default is 1"
+  " (no parallel threads).",
+  NULL, NULL,
+  1,			/* Default setting */
+  1,			/* Minimum value */
+  64, 0);		/* Maximum value */
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -20160,6 +20266,15 @@ static MYSQL_SYSVAR_BOOL(print_all_deadlocks, srv_print_all_deadlocks,
   "Print all deadlocks to MySQL error log (off by default)",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_ENUM(deadlock_detect_mode, srv_deadlock_detect_mode,
+  PLUGIN_VAR_OPCMDARG,
+  "When to look for deadlocks. Allowed values: "
+  "EAGER: (default) whenever a transaction starts to wait for a lock; "
+  "BACKGROUND: in the lock wait timeout thread, which keeps a wait-for "
+  "graph of the waiting transactions.",
+  NULL, NULL, LOCK_DEADLOCK_DETECT_EAGER,
+  &innodb_deadlock_detect_mode_typelib);
+
 static MYSQL_SYSVAR_ULONG(compression_failure_threshold_pct,
   zip_failure_threshold_pct, PLUGIN_VAR_OPCMDARG,
   "If the compression failure rate of a table is greater than this number"
@@ -20440,6 +20555,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_load_now),
   MYSQL_SYSVAR(buffer_pool_load_abort),
   MYSQL_SYSVAR(buffer_pool_load_at_startup),
+  MYSQL_SYSVAR(buffer_pool_load_threads),
   MYSQL_SYSVAR(defragment),
   MYSQL_SYSVAR(defragment_n_pages),
   MYSQL_SYSVAR(defragment_stats_accuracy),
@@ -20458,6 +20574,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(parallel_doublewrite),
   MYSQL_SYSVAR(api_enable_binlog),
   MYSQL_SYSVAR(api_enable_mdl),
   MYSQL_SYSVAR(api_disable_rowlock),
@@ -20468,6 +20585,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(read_io_threads),
   MYSQL_SYSVAR(write_io_threads),
   MYSQL_SYSVAR(file_per_table),
+  MYSQL_SYSVAR(unlogged_temp_tables),
   MYSQL_SYSVAR(file_format),
   MYSQL_SYSVAR(file_format_check),
   MYSQL_SYSVAR(file_format_max),
@@ -20487,6 +20605,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(ft_min_token_size),
   MYSQL_SYSVAR(ft_num_word_optimize),
   MYSQL_SYSVAR(ft_sort_pll_degree),
+  MYSQL_SYSVAR(instant_add_column),
   MYSQL_SYSVAR(large_prefix),
   MYSQL_SYSVAR(force_load_corrupted),
   MYSQL_SYSVAR(locks_unsafe_for_binlog),
@@ -20536,6 +20655,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(support_xa),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(index_build_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -20575,6 +20695,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(monitor_reset),
   MYSQL_SYSVAR(monitor_reset_all),
   MYSQL_SYSVAR(purge_threads),
+  MYSQL_SYSVAR(recovery_threads),
   MYSQL_SYSVAR(purge_batch_size),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(purge_run_now),
@@ -20611,6 +20732,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(foreground_preflush),
   MYSQL_SYSVAR(empty_free_list_algorithm),
   MYSQL_SYSVAR(print_all_deadlocks),
+  MYSQL_SYSVAR(deadlock_detect_mode),
   MYSQL_SYSVAR(cmp_per_index_enabled),
   MYSQL_SYSVAR(undo_logs),
   MYSQL_SYSVAR(rollback_segments),
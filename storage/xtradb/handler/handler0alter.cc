@@ -220,6 +220,95 @@ innobase_need_rebuild(
 	return(!!(ha_alter_info->handler_flags & INNOBASE_ALTER_REBUILD));
 }
 
+/*******************************************************************//**
+Determine if ALTER TABLE can add the columns instantly, by only
+changing the data dictionary. Existing records will not be converted;
+the values of the added columns are the defaults stored in
+SYS_COLUMNS_ADDED until the records are updated.
+@param thd		the connection, for innodb_instant_add_column
+@param ha_alter_info	the DDL operation
+@param altered_table	MySQL table that is being altered
+@param old_table	MySQL table as it is before the ALTER operation
+@param user_table	InnoDB table as it is before the ALTER operation
+@return whether the columns can be added instantly */
+static __attribute__((nonnull, warn_unused_result))
+bool
+innobase_instant_add_column(
+/*========================*/
+	THD*				thd,
+	const Alter_inplace_info*	ha_alter_info,
+	const TABLE*			altered_table,
+	const TABLE*			old_table,
+	const dict_table_t*		user_table)
+{
+	if ((ha_alter_info->handler_flags & ~INNOBASE_INPLACE_IGNORE)
+	    != Alter_inplace_info::ADD_COLUMN
+	    || !thd_instant_add_column(thd)) {
+		return(false);
+	}
+
+	/* The default values of the added columns are stored in
+	SYS_COLUMNS_ADDED, which is only created by a server that was
+	started with innodb_instant_add_column=ON. */
+	mutex_enter(&dict_sys->mutex);
+	bool	have_sys_columns_added
+		= dict_table_get_low("SYS_COLUMNS_ADDED") != NULL;
+	mutex_exit(&dict_sys->mutex);
+
+	if (!have_sys_columns_added) {
+		return(false);
+	}
+
+	if (dict_table_is_discarded(user_table)
+	    || user_table->ibd_file_missing
+	    || dict_table_zip_size(user_table)
+	    || user_table->fts
+	    || DICT_TF2_FLAG_IS_SET(user_table, DICT_TF2_FTS_HAS_DOC_ID)) {
+		return(false);
+	}
+
+	if (old_table->s->stored_fields != old_table->s->fields
+	    || altered_table->s->stored_fields != altered_table->s->fields
+	    || altered_table->s->fields <= old_table->s->fields) {
+		/* Virtual columns are not supported. */
+		return(false);
+	}
+
+	/* The existing columns must keep their positions, and
+	the columns must be added last. */
+	List_iterator_fast<Create_field> cf_it(
+		ha_alter_info->alter_info->create_list);
+	uint	i = 0;
+
+	while (const Create_field* cf = cf_it++) {
+		if (i < old_table->s->fields) {
+			if (cf->field != old_table->field[i]) {
+				return(false);
+			}
+		} else {
+			const Field*	field = altered_table->field[i];
+
+			if (cf->field
+			    || (field->flags & AUTO_INCREMENT_FLAG)) {
+				return(false);
+			}
+
+			/* Refuse defaults that could not be stored
+			in a SYS_COLUMNS_ADDED record without
+			externally storing them. */
+			if (!(field->flags & BLOB_FLAG)
+			    && field->pack_length()
+			    > DICT_MAX_FIXED_COL_LEN) {
+				return(false);
+			}
+		}
+
+		i++;
+	}
+
+	return(i == altered_table->s->fields);
+}
+
 /** Check if InnoDB supports a particular alter table in-place
 @param altered_table	TABLE object for new version of table.
 @param ha_alter_info	Structure describing changes to be done
@@ -313,7 +402,10 @@ ha_innobase::check_if_supported_inplace_alter(
 		DBUG_RETURN(HA_ALTER_INPLACE_NOT_SUPPORTED);
 	}
 
-	if (!(ha_alter_info->handler_flags & ~INNOBASE_INPLACE_IGNORE)) {
+	if (!(ha_alter_info->handler_flags & ~INNOBASE_INPLACE_IGNORE)
+	    || innobase_instant_add_column(user_thd, ha_alter_info,
+					   altered_table, table,
+					   prebuilt->table)) {
 		DBUG_RETURN(HA_ALTER_INPLACE_NO_LOCK);
 	}
 
@@ -1217,7 +1309,7 @@ innobase_rec_to_mysql(
 			continue;
 		}
 
-		ifield = rec_get_nth_field(rec, offsets, ipos, &ilen);
+		ifield = rec_get_nth_cfield(rec, index, offsets, ipos, &ilen);
 
 		/* Assign the NULL flag */
 		if (ilen == UNIV_SQL_NULL) {
@@ -2079,6 +2171,8 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 	ulonglong	max_autoinc;
 	/** temporary table name to use for old table when renaming tables */
 	const char*	tmp_name;
+	/** columns that are being added instantly, or NULL */
+	dict_table_t*	instant_table;
 
 	ha_innobase_inplace_ctx(row_prebuilt_t*& prebuilt_arg,
 				dict_index_t** drop_arg,
@@ -2109,7 +2203,8 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 		sequence(prebuilt->trx->mysql_thd,
 			 autoinc_col_min_value_arg, autoinc_col_max_value_arg),
 		max_autoinc (0),
-		tmp_name (0)
+		tmp_name (0),
+		instant_table (0)
 	{
 #ifdef UNIV_DEBUG
 		for (ulint i = 0; i < num_to_add_index; i++) {
@@ -2125,6 +2220,9 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 
 	~ha_innobase_inplace_ctx()
 	{
+		if (instant_table) {
+			dict_mem_table_free(instant_table);
+		}
 		mem_heap_free(heap);
 	}
 
@@ -2132,6 +2230,10 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 	@return whether the table will be rebuilt */
 	bool need_rebuild () const { return(old_table != new_table); }
 
+	/** Determine if columns are being added instantly.
+	@return whether columns are being added without rebuilding */
+	bool is_instant () const { return(instant_table != NULL); }
+
 private:
 	// Disable copying
 	ha_innobase_inplace_ctx(const ha_innobase_inplace_ctx&);
@@ -2628,6 +2730,149 @@ innobase_get_col_names(
 	DBUG_RETURN(cols);
 }
 
+/*******************************************************************//**
+Add a column to an InnoDB table definition that is being created.
+@param table	InnoDB table definition
+@param heap	memory heap for the column name
+@param field	MySQL column
+@retval true	if the column is not valid (my_error() was called)
+@retval false	on success */
+static __attribute__((nonnull, warn_unused_result))
+bool
+innobase_table_add_col(
+/*===================*/
+	dict_table_t*	table,
+	mem_heap_t*	heap,
+	const Field*	field)
+{
+	ulint		is_unsigned;
+	ulint		field_type
+		= (ulint) field->type();
+	ulint		col_type
+		= get_innobase_type_from_mysql_type(
+			&is_unsigned, field);
+	ulint		charset_no;
+	ulint		col_len;
+
+	/* we assume in dtype_form_prtype() that this
+	fits in two bytes */
+	ut_a(field_type <= MAX_CHAR_COLL_NUM);
+
+	if (!field->real_maybe_null()) {
+		field_type |= DATA_NOT_NULL;
+	}
+
+	if (field->binary()) {
+		field_type |= DATA_BINARY_TYPE;
+	}
+
+	if (is_unsigned) {
+		field_type |= DATA_UNSIGNED;
+	}
+
+	if (dtype_is_string_type(col_type)) {
+		charset_no = (ulint) field->charset()->number;
+
+		if (charset_no > MAX_CHAR_COLL_NUM) {
+			my_error(ER_WRONG_KEY_COLUMN, MYF(0),
+				 field->field_name);
+			return(true);
+		}
+	} else {
+		charset_no = 0;
+	}
+
+	col_len = field->pack_length();
+
+	/* The MySQL pack length contains 1 or 2 bytes
+	length field for a true VARCHAR. Let us
+	subtract that, so that the InnoDB column
+	length in the InnoDB data dictionary is the
+	real maximum byte length of the actual data. */
+
+	if (field->type() == MYSQL_TYPE_VARCHAR) {
+		uint32	length_bytes
+			= static_cast<const Field_varstring*>(
+				field)->length_bytes;
+
+		col_len -= length_bytes;
+
+		if (length_bytes == 2) {
+			field_type |= DATA_LONG_TRUE_VARCHAR;
+		}
+	}
+
+	if (dict_col_name_is_reserved(field->field_name)) {
+		my_error(ER_WRONG_COLUMN_NAME, MYF(0),
+			 field->field_name);
+		return(true);
+	}
+
+	dict_mem_table_add_col(
+		table, heap,
+		field->field_name,
+		col_type,
+		dtype_form_prtype(field_type, charset_no),
+		col_len);
+
+	return(false);
+}
+
+/*******************************************************************//**
+Create the definitions of the columns that are being added instantly,
+see innobase_instant_add_column().
+@param altered_table	MySQL table that is being altered
+@param old_table	MySQL table as it is before the ALTER operation
+@param user_table	InnoDB table as it is before the ALTER operation
+@param heap		memory heap for the default values
+@return the added columns, or NULL on error (my_error() was called) */
+static __attribute__((nonnull, warn_unused_result))
+dict_table_t*
+innobase_instant_table_create(
+/*==========================*/
+	const TABLE*		altered_table,
+	const TABLE*		old_table,
+	const dict_table_t*	user_table,
+	mem_heap_t*		heap)
+{
+	const ulint	n_add	= altered_table->s->fields
+		- old_table->s->fields;
+	dict_table_t*	table	= dict_mem_table_create(
+		user_table->name, user_table->space, n_add,
+		user_table->flags, user_table->flags2, false);
+
+	for (uint i = old_table->s->fields;
+	     i < altered_table->s->fields; i++) {
+		const Field*	field = altered_table->field[i];
+		dfield_t	dfield;
+
+		if (innobase_table_add_col(table, heap, field)) {
+			dict_mem_table_free(table);
+			return(NULL);
+		}
+
+		dict_col_t*	col = dict_table_get_nth_col(
+			table, i - old_table->s->fields);
+
+		dict_col_copy_type(col, dfield_get_type(&dfield));
+		innobase_build_col_map_add(
+			heap, &dfield, field, dict_table_is_comp(user_table));
+
+		if (dfield_is_null(&dfield)) {
+			col->def_val = NULL;
+			col->def_val_len = UNIV_SQL_NULL;
+		} else {
+			col->def_val = static_cast<const byte*>(
+				mem_heap_dup(table->heap,
+					     dfield_get_data(&dfield),
+					     dfield_get_len(&dfield)));
+			col->def_val_len = dfield_get_len(&dfield);
+		}
+	}
+
+	return(table);
+}
+
 /** Update internal structures with concurrent writes blocked,
 while preparing ALTER TABLE.
 
@@ -2851,78 +3096,12 @@ prepare_inplace_alter_table_dict(
                         while (!((field= altered_table->field[sql_idx])->
                                  stored_in_db))
                           sql_idx++;
-			ulint		is_unsigned;
-			ulint		field_type
-				= (ulint) field->type();
-			ulint		col_type
-				= get_innobase_type_from_mysql_type(
-					&is_unsigned, field);
-			ulint		charset_no;
-			ulint		col_len;
-
-			/* we assume in dtype_form_prtype() that this
-			fits in two bytes */
-			ut_a(field_type <= MAX_CHAR_COLL_NUM);
-
-			if (!field->real_maybe_null()) {
-				field_type |= DATA_NOT_NULL;
-			}
 
-			if (field->binary()) {
-				field_type |= DATA_BINARY_TYPE;
-			}
-
-			if (is_unsigned) {
-				field_type |= DATA_UNSIGNED;
-			}
-
-			if (dtype_is_string_type(col_type)) {
-				charset_no = (ulint) field->charset()->number;
-
-				if (charset_no > MAX_CHAR_COLL_NUM) {
-					dict_mem_table_free(
-						ctx->new_table);
-					my_error(ER_WRONG_KEY_COLUMN, MYF(0),
-						 field->field_name);
-					goto new_clustered_failed;
-				}
-			} else {
-				charset_no = 0;
-			}
-
-			col_len = field->pack_length();
-
-			/* The MySQL pack length contains 1 or 2 bytes
-			length field for a true VARCHAR. Let us
-			subtract that, so that the InnoDB column
-			length in the InnoDB data dictionary is the
-			real maximum byte length of the actual data. */
-
-			if (field->type() == MYSQL_TYPE_VARCHAR) {
-				uint32	length_bytes
-					= static_cast<const Field_varstring*>(
-						field)->length_bytes;
-
-				col_len -= length_bytes;
-
-				if (length_bytes == 2) {
-					field_type |= DATA_LONG_TRUE_VARCHAR;
-				}
-			}
-
-			if (dict_col_name_is_reserved(field->field_name)) {
+			if (innobase_table_add_col(
+				    ctx->new_table, ctx->heap, field)) {
 				dict_mem_table_free(ctx->new_table);
-				my_error(ER_WRONG_COLUMN_NAME, MYF(0),
-					 field->field_name);
 				goto new_clustered_failed;
 			}
-
-			dict_mem_table_add_col(
-				ctx->new_table, ctx->heap,
-				field->field_name,
-				col_type,
-				dtype_form_prtype(field_type, charset_no),
-				col_len);
 		}
 
 		if (add_fts_doc_id) {
@@ -3851,6 +4030,35 @@ ha_innobase::prepare_inplace_alter_table(
 		}
 	}
 
+	if (innobase_instant_add_column(user_thd, ha_alter_info,
+					altered_table, table, indexed_table)) {
+		dict_table_t*	instant_table;
+
+		if (!heap) {
+			heap = mem_heap_create(1024);
+		}
+
+		instant_table = innobase_instant_table_create(
+			altered_table, table, indexed_table, heap);
+
+		if (!instant_table) {
+			goto err_exit;
+		}
+
+		ha_innobase_inplace_ctx*	ctx
+			= new ha_innobase_inplace_ctx(
+				prebuilt,
+				drop_index, n_drop_index,
+				drop_fk, n_drop_fk,
+				add_fk, n_add_fk,
+				ha_alter_info->online,
+				heap, indexed_table,
+				col_names, ULINT_UNDEFINED, 0, 0);
+		ctx->instant_table = instant_table;
+		ha_alter_info->handler_ctx = ctx;
+		goto func_exit;
+	}
+
 	if (!(ha_alter_info->handler_flags & INNOBASE_ALTER_DATA)
 	    || (ha_alter_info->handler_flags
 		== Alter_inplace_info::CHANGE_CREATE_OPTION
@@ -4037,6 +4245,12 @@ ha_innobase::inplace_alter_table(
 		(ha_alter_info->handler_ctx);
 
 	DBUG_ASSERT(ctx);
+
+	if (ctx->is_instant()) {
+		/* Only the data dictionary will be changed. */
+		goto ok_exit;
+	}
+
 	DBUG_ASSERT(ctx->trx);
 	DBUG_ASSERT(ctx->prebuilt == prebuilt);
 
@@ -4629,6 +4843,114 @@ innobase_rename_columns_try(
 	return(false);
 }
 
+/** Add columns instantly in the data dictionary tables.
+@param ctx		In-place ALTER TABLE context
+@param trx		data dictionary transaction
+@param table_name	Table name in MySQL
+@retval true		Failure
+@retval false		Success */
+static __attribute__((nonnull, warn_unused_result))
+bool
+innobase_instant_add_cols_try(
+/*==========================*/
+	const ha_innobase_inplace_ctx*	ctx,
+	trx_t*				trx,
+	const char*			table_name)
+{
+	const dict_table_t*	user_table	= ctx->old_table;
+	const dict_table_t*	add		= ctx->instant_table;
+	const ulint		n_user
+		= dict_table_get_n_user_cols(user_table);
+	pars_info_t*		info;
+	dberr_t			error;
+
+	DBUG_ENTER("innobase_instant_add_cols_try");
+
+	DBUG_ASSERT(ctx->is_instant());
+	DBUG_ASSERT(!ctx->need_rebuild());
+	DBUG_ASSERT(trx_get_dict_operation(trx) == TRX_DICT_OP_INDEX);
+	ut_ad(trx->dict_operation_lock_mode == RW_X_LATCH);
+	ut_ad(mutex_own(&dict_sys->mutex));
+
+	trx->op_info = "adding columns to SYS_COLUMNS";
+
+	for (ulint i = 0; i < add->n_def; i++) {
+		const dict_col_t*	col = dict_table_get_nth_col(add, i);
+
+		info = pars_info_create();
+
+		pars_info_add_ull_literal(info, "id", user_table->id);
+		pars_info_add_int4_literal(info, "pos", n_user + i);
+		pars_info_add_str_literal(
+			info, "name", dict_table_get_col_name(add, i));
+		pars_info_add_int4_literal(info, "mtype", col->mtype);
+		pars_info_add_int4_literal(info, "prtype", col->prtype);
+		pars_info_add_int4_literal(info, "len", col->len);
+
+		if (col->def_val_len != UNIV_SQL_NULL) {
+			pars_info_add_literal(
+				info, "def", col->def_val, col->def_val_len,
+				DATA_BLOB, 0);
+		}
+
+		error = que_eval_sql(
+			info,
+			col->def_val_len == UNIV_SQL_NULL
+			? "PROCEDURE ADD_SYS_COLUMNS_PROC () IS\n"
+			"BEGIN\n"
+			"INSERT INTO SYS_COLUMNS VALUES"
+			"(:id,:pos,:name,:mtype,:prtype,:len,0);\n"
+			"INSERT INTO SYS_COLUMNS_ADDED VALUES"
+			"(:id,:pos,NULL);\n"
+			"END;\n"
+			: "PROCEDURE ADD_SYS_COLUMNS_PROC () IS\n"
+			"BEGIN\n"
+			"INSERT INTO SYS_COLUMNS VALUES"
+			"(:id,:pos,:name,:mtype,:prtype,:len,0);\n"
+			"INSERT INTO SYS_COLUMNS_ADDED VALUES"
+			"(:id,:pos,:def);\n"
+			"END;\n",
+			FALSE, trx);
+
+		if (error != DB_SUCCESS) {
+			goto err_exit;
+		}
+	}
+
+	trx->op_info = "updating SYS_TABLES.N_COLS";
+
+	info = pars_info_create();
+
+	pars_info_add_ull_literal(info, "id", user_table->id);
+	pars_info_add_int4_literal(
+		info, "n_cols",
+		(lint) ((n_user + add->n_def)
+			| ((user_table->flags & DICT_TF_COMPACT) << 31)));
+
+	error = que_eval_sql(
+		info,
+		"PROCEDURE UPDATE_N_COLS_PROC () IS\n"
+		"BEGIN\n"
+		"UPDATE SYS_TABLES SET N_COLS=:n_cols\n"
+		"WHERE ID=:id;\n"
+		"END;\n",
+		FALSE, trx);
+
+	DBUG_EXECUTE_IF("ib_instant_add_column_error",
+			error = DB_OUT_OF_FILE_SPACE;);
+
+	if (error != DB_SUCCESS) {
+err_exit:
+		my_error_innodb(error, table_name, 0);
+		trx->error_state = DB_SUCCESS;
+		trx->op_info = "";
+		DBUG_RETURN(true);
+	}
+
+	trx->op_info = "";
+	DBUG_RETURN(false);
+}
+
 /** Rename columns in the data dictionary cache
 as part of commit_cache_norebuild().
 @param ha_alter_info	Data used during in-place alter.
@@ -5226,6 +5548,11 @@ commit_try_norebuild(
 		}
 	}
 
+	if (ctx->is_instant()
+	    && innobase_instant_add_cols_try(ctx, trx, table_name)) {
+		DBUG_RETURN(true);
+	}
+
 	if (!(ha_alter_info->handler_flags
 	      & Alter_inplace_info::ALTER_COLUMN_NAME)) {
 		DBUG_RETURN(false);
@@ -5317,6 +5644,14 @@ commit_cache_norebuild(
 		trx_commit_for_mysql(trx);
 	}
 
+	if (ctx->is_instant()) {
+		/* Append the added columns to the table definition.
+		The existing records will be converted lazily, when
+		they are updated. */
+		dict_table_add_instant_cols(ctx->new_table,
+					    ctx->instant_table);
+	}
+
 	DBUG_RETURN(found);
 }
 
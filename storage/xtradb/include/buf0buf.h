@@ -1600,6 +1600,10 @@ struct buf_page_t{
 					buffer that is then alligned */
 	bool		encrypt_later;  /*!< should we encrypt the page
 					at os0file.cc ? */
+	bool		no_doublewrite;	/*!< true if the pending write of
+					the page bypasses the doublewrite
+					buffer because the page belongs to
+					an unlogged temporary table */
 #ifndef UNIV_HOTBACKUP
 	buf_page_t*	hash;		/*!< node used in chaining to
 					buf_pool->page_hash or
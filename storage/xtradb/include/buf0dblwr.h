@@ -38,6 +38,10 @@ extern buf_dblwr_t*	buf_dblwr;
 /** Set to TRUE when the doublewrite buffer is being created */
 extern ibool		buf_dblwr_being_created;
 
+/** Name of the doublewrite files of innodb_parallel_doublewrite, in the
+data home directory, followed by the buffer pool instance number */
+#define BUF_DBLWR_FILE_NAME	"ib_doublewrite"
+
 /****************************************************************//**
 Creates the doublewrite buffer to a new InnoDB installation. The header of the
 doublewrite buffer is placed on the trx system header page. */
@@ -105,8 +109,12 @@ and also when we may have to wait for a page latch! Otherwise a deadlock
 of threads can occur. */
 UNIV_INTERN
 void
-buf_dblwr_flush_buffered_writes(void);
-/*=================================*/
+buf_dblwr_flush_buffered_writes(
+/*============================*/
+	const buf_pool_t*	buf_pool);/*!< in: buffer pool instance
+					whose writes to flush when
+					innodb_parallel_doublewrite is set,
+					or NULL for all of them */
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
 the page to the datafile and sync the datafile. This function is used
@@ -154,6 +162,17 @@ struct buf_dblwr_t{
 	buf_page_t**	buf_block_arr;/*!< array to store pointers to
 				the buffer blocks which have been
 				cached to write_buf */
+	char*		file_name;/*!< NULL for the doublewrite buffer
+				in the system tablespace; for a shard,
+				the name of its doublewrite file */
+	os_file_t	file;	/*!< doublewrite file of a shard */
+	buf_dblwr_t*	shards;	/*!< if innodb_parallel_doublewrite
+				is set, the doublewrite buffers used by
+				the batch flushes of each buffer pool
+				instance instead of this one, which is
+				then only used by single page flushes;
+				else NULL */
+	ulint		n_shards;/*!< number of shards */
 };
 
 
@@ -56,6 +56,19 @@ buf_read_page_async(
 	ulint	space,	/*!< in: space id */
 	ulint	offset);/*!< in: page number */
 /********************************************************************//**
+High-level function which reads a range of pages asynchronously from a file
+to the buffer buf_pool, skipping the pages that are already there. The
+requests are queued before the i/o handler threads are woken up, so that
+they can be merged into bigger reads.
+@return number of page read requests issued */
+UNIV_INTERN
+ulint
+buf_read_pages_async(
+/*=================*/
+	ulint	space,	/*!< in: space id */
+	ulint	offset,	/*!< in: first page number */
+	ulint	n_pages);/*!< in: number of pages */
+/********************************************************************//**
 Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
@@ -152,6 +152,17 @@ UNIV_INTERN
 dberr_t
 dict_create_or_check_sys_tablespace(void);
 /*=====================================*/
+/****************************************************************//**
+Creates the SYS_COLUMNS_ADDED system table, which holds the default
+values of columns that were added by ALTER TABLE without rebuilding
+the table, at server bootstrap or server start if it is not found or
+is not of the right form. A missing table is only created if the
+global innodb_instant_add_column is ON.
+@return	DB_SUCCESS or error code */
+UNIV_INTERN
+dberr_t
+dict_create_or_check_sys_columns_added(void);
+/*========================================*/
 /********************************************************************//**
 Add a single tablespace definition to the data dictionary tables in the
 database.
@@ -369,6 +369,18 @@ dict_table_add_system_columns(
 	__attribute__((nonnull));
 #ifndef UNIV_HOTBACKUP
 /**********************************************************************//**
+Adds columns to a table in the dictionary cache after ALTER TABLE added
+them to the data dictionary without rebuilding the table. */
+UNIV_INTERN
+void
+dict_table_add_instant_cols(
+/*========================*/
+	dict_table_t*		table,	/*!< in/out: table */
+	const dict_table_t*	add)	/*!< in: table object holding the
+					added columns and their default
+					values */
+	__attribute__((nonnull));
+/**********************************************************************//**
 Adds a table object to the dictionary cache. */
 UNIV_INTERN
 void
@@ -752,6 +764,36 @@ dict_index_is_unique(
 	const dict_index_t*	index)	/*!< in: index */
 	__attribute__((nonnull, pure, warn_unused_result));
 /********************************************************************//**
+Check whether columns have been added instantly to the clustered index,
+so that the leaf page records may contain fewer fields than the index.
+@return	true if columns have been added instantly */
+UNIV_INLINE
+bool
+dict_index_is_instant(
+/*==================*/
+	const dict_index_t*	index)	/*!< in: index */
+	__attribute__((nonnull, pure, warn_unused_result));
+/********************************************************************//**
+Gets the size of the null flags of node pointer records and of the
+leaf page records in the format of REC_STATUS_ORDINARY.
+@return	number of bytes of null flags */
+UNIV_INLINE
+ulint
+dict_index_get_n_core_null_bytes(
+/*=============================*/
+	const dict_index_t*	index)	/*!< in: index */
+	__attribute__((nonnull, pure, warn_unused_result));
+/********************************************************************//**
+Gets the number of nullable fields among the first fields of an index.
+@return	number of nullable fields among the first n fields */
+UNIV_INLINE
+ulint
+dict_index_get_n_nullable(
+/*======================*/
+	const dict_index_t*	index,	/*!< in: index */
+	ulint			n)	/*!< in: number of fields */
+	__attribute__((nonnull, pure, warn_unused_result));
+/********************************************************************//**
 Check whether the index is the insert buffer tree.
 @return	nonzero for insert buffer, zero for other indexes */
 UNIV_INLINE
@@ -1828,6 +1870,27 @@ dict_table_is_temporary(
 	const dict_table_t*	table)	/*!< in: table to check */
 	__attribute__((nonnull, pure, warn_unused_result));
 
+/********************************************************************//**
+Check if it is an unlogged temporary table.
+@return	true if the unlogged flag is set. */
+UNIV_INLINE
+bool
+dict_table_is_unlogged(
+/*===================*/
+	const dict_table_t*	table)	/*!< in: table to check */
+	__attribute__((nonnull, pure, warn_unused_result));
+
+/********************************************************************//**
+Turns off the redo logging of a mini-transaction that only modifies
+pages of an unlogged temporary table. */
+UNIV_INLINE
+void
+dict_disable_redo_if_unlogged(
+/*==========================*/
+	const dict_table_t*	table,	/*!< in: table */
+	mtr_t*			mtr)	/*!< in/out: mini-transaction */
+	__attribute__((nonnull));
+
 #ifndef UNIV_HOTBACKUP
 /*********************************************************************//**
 This function should be called whenever a page is successfully
@@ -286,7 +286,7 @@ ROW_FORMAT=REDUNDANT.  InnoDB engines do not check these flags
 for unknown bits in order to protect backward incompatibility. */
 /* @{ */
 /** Total number of bits in table->flags2. */
-#define DICT_TF2_BITS			7
+#define DICT_TF2_BITS			8
 #define DICT_TF2_BIT_MASK		~(~0 << DICT_TF2_BITS)
 
 /** TEMPORARY; TRUE for tables from CREATE TEMPORARY TABLE. */
@@ -308,6 +308,11 @@ use its own tablespace instead of the system tablespace. */
 /** This bit is set if all aux table names (both common tables and
 index tables) of a FTS table are in HEX format. */
 #define DICT_TF2_FTS_AUX_HEX_NAME	64
+
+/** UNLOGGED; TRUE for a temporary table in a tablespace of its own
+whose changes are not written to the redo log, see
+innodb_unlogged_temp_tables */
+#define DICT_TF2_UNLOGGED		128
 /* @} */
 
 #define DICT_TF2_FLAG_SET(table, flag)				\
@@ -554,6 +559,12 @@ struct dict_col_t{
 	unsigned	max_prefix:12;	/*!< maximum index prefix length on
 					this column. Our current max limit is
 					3072 for Barracuda table */
+	const byte*	def_val;	/*!< value of the column in the
+					records that were written before
+					the column was added instantly,
+					or NULL; see dict_index_is_instant() */
+	ulint		def_val_len;	/*!< length of def_val, or
+					UNIV_SQL_NULL */
 };
 
 /** @brief DICT_ANTELOPE_MAX_INDEX_COL_LEN is measured in bytes and
@@ -702,6 +713,14 @@ struct dict_index_t{
 	unsigned	n_def:10;/*!< number of fields defined so far */
 	unsigned	n_fields:10;/*!< number of fields in the index */
 	unsigned	n_nullable:10;/*!< number of nullable fields */
+	unsigned	n_core_fields:10;/*!< number of fields in the
+				leaf page records written before
+				columns were added instantly to the
+				clustered index, or 0 if no column
+				was added instantly */
+	unsigned	n_core_null_bytes:8;/*!< size of the null flags
+				of those records and of node pointer
+				records, if n_core_fields != 0 */
 	unsigned	cached:1;/*!< TRUE if the index object is in the
 				dictionary cache */
 	unsigned	to_be_dropped:1;
@@ -340,6 +340,11 @@ struct fil_space_t {
 	bool		printed_compression_failure;
 				/*!< true if we have already printed
 				compression failure */
+	bool		unlogged;
+				/*!< true if this is the tablespace of
+				an unlogged temporary table: its pages
+				are not written to the redo log or to
+				the doublewrite buffer */
 	UT_LIST_NODE_T(fil_space_t) space_list;
 				/*!< list of all spaces */
         fil_space_crypt_t* crypt_data;
@@ -528,6 +533,14 @@ fil_space_get_flags(
 /*================*/
 	ulint	id);	/*!< in: space id */
 /*******************************************************************//**
+Checks if the space is the tablespace of an unlogged temporary table.
+@return	true if the space is unlogged, false if not or if not found */
+UNIV_INTERN
+bool
+fil_space_is_unlogged(
+/*==================*/
+	ulint	id);	/*!< in: space id */
+/*******************************************************************//**
 Returns the compressed page size of the space, or 0 if the space
 is not compressed. The tablespace must be cached in the memory cache.
 @return	compressed page size, ULINT_UNDEFINED if space not found */
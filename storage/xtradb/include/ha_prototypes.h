@@ -339,6 +339,16 @@ innobase_index_cond(
 	void*	file)	/*!< in/out: pointer to ha_innobase */
 	__attribute__((nonnull, warn_unused_result));
 /******************************************************************//**
+Returns true if ALTER TABLE may add columns without rebuilding the table,
+global value of innodb_instant_add_column if thd is NULL.
+@return	true if columns can be added instantly */
+UNIV_INTERN
+bool
+thd_instant_add_column(
+/*===================*/
+	THD*	thd);	/*!< in: thread handle, or NULL to query
+			the global innodb_instant_add_column */
+/******************************************************************//**
 Returns true if the thread supports XA,
 global value of innodb_supports_xa if thd is NULL.
 @return	true if thd supports XA */
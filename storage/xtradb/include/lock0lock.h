@@ -770,6 +770,16 @@ lock_table_has_locks(
 					held on records in this table or on the
 					table itself */
 
+/*********************************************************************//**
+Looks for cycles in the wait-for graph of the suspended transactions and
+rolls back a victim of each one. This is how deadlocks are detected with
+innodb_deadlock_detect_mode=BACKGROUND. The caller must own
+lock_sys->wait_mutex. */
+UNIV_INTERN
+void
+lock_deadlock_detect_background(void);
+/*=================================*/
+
 /*********************************************************************//**
 A thread which wakes up threads whose lock wait may have lasted too long.
 @return	a dummy parameter */
@@ -929,10 +939,29 @@ struct lock_op_t{
 	enum lock_mode	mode;	/*!< lock mode */
 };
 
+/** Number of shards of the record lock hash table, a power of 2 */
+#define LOCK_REC_N_SHARDS	64
+
 /** The lock system struct */
 struct lock_sys_t{
-	ib_mutex_t	mutex;			/*!< Mutex protecting the
-						locks */
+	rw_lock_t	latch;			/*!< Latch protecting the
+						locks. Record lock requests
+						that can be granted at once
+						hold it in shared mode together
+						with the mutex of the rec_hash
+						shard of the page, see
+						lock_rec_lock(). Everything
+						else, including deadlock
+						detection, holds it in
+						exclusive mode. This is what
+						lock_mutex_enter() and the
+						comments about lock_sys->mutex
+						refer to. */
+	ib_mutex_t	rec_mutexes[LOCK_REC_N_SHARDS];
+						/*!< mutexes protecting the
+						record lock queues of each
+						shard of rec_hash while the
+						latch is held in shared mode */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
 	ulint		rec_num;
@@ -954,6 +983,14 @@ struct lock_sys_t{
 
 	ulint		n_lock_max_wait_time;	/*!< Max wait time */
 
+	ib_uint64_t	deadlock_detect_time;	/*!< microseconds spent looking
+						for deadlocks, protected by
+						lock_sys->mutex */
+	ulint		deadlock_graph_size;	/*!< number of waiting
+						transactions in the wait-for
+						graph of the last search,
+						protected by lock_sys->mutex */
+
 	os_event_t	timeout_event;		/*!< Set to the event that is
 						created in the lock wait monitor
 						thread. A value of 0 means the
@@ -966,20 +1003,30 @@ struct lock_sys_t{
 /** The lock system */
 extern lock_sys_t*	lock_sys;
 
-/** Test if lock_sys->mutex can be acquired without waiting. */
-#define lock_mutex_enter_nowait() mutex_enter_nowait(&lock_sys->mutex)
+/*********************************************************************//**
+Checks if the current thread holds lock_sys->latch in exclusive mode.
+@return	true if it does */
+UNIV_INLINE
+bool
+lock_sys_x_own(void);
+/*================*/
+
+/** Test if lock_sys->latch can be x-locked without waiting.
+Returns 0 if it was x-locked, like mutex_enter_nowait(). */
+#define lock_mutex_enter_nowait()				\
+	(!rw_lock_x_lock_nowait(&lock_sys->latch))
 
-/** Test if lock_sys->mutex is owned. */
-#define lock_mutex_own() mutex_own(&lock_sys->mutex)
+/** Test if lock_sys->latch is x-locked by this thread. */
+#define lock_mutex_own() lock_sys_x_own()
 
-/** Acquire the lock_sys->mutex. */
+/** X-lock the lock_sys->latch. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys->mutex);		\
+	rw_lock_x_lock(&lock_sys->latch);	\
 } while (0)
 
-/** Release the lock_sys->mutex. */
+/** Release the x-lock on lock_sys->latch. */
 #define lock_mutex_exit() do {			\
-	mutex_exit(&lock_sys->mutex);		\
+	rw_lock_x_unlock(&lock_sys->latch);	\
 } while (0)
 
 /** Test if lock_sys->wait_mutex is owned. */
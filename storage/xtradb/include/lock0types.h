@@ -43,5 +43,15 @@ enum lock_mode {
 	LOCK_NONE_UNSET = 255
 };
 
+/** Alternatives for srv_deadlock_detect_mode, set through the
+innodb_deadlock_detect_mode variable */
+enum lock_deadlock_detect_t {
+	LOCK_DEADLOCK_DETECT_EAGER,	/*!< search the wait-for graph
+					whenever a lock wait is enqueued */
+	LOCK_DEADLOCK_DETECT_BACKGROUND	/*!< look for cycles in the
+					lock wait timeout thread, see
+					lock_deadlock_detect_background() */
+};
+
 
 #endif
@@ -102,9 +102,17 @@ log_calc_where_lsn_is(
 	ib_int64_t	log_file_size);		/*!< in: log file size
 						(including the header) */
 #ifndef UNIV_HOTBACKUP
+#if defined HAVE_ATOMIC_BUILTINS && !defined UNIV_LOG_DEBUG \
+	&& !defined UNIV_LOG_LSN_DEBUG
+/** Mini-transactions copy their log records to the log buffer after
+releasing log_sys->mutex, see log_reserve_and_write_fast() */
+# define LOG_COPY_WITHOUT_MUTEX
+#endif
 /************************************************************//**
 Writes to the log the string given. The log must be released with
-log_release.
+log_release. If *copy_to is set to non-NULL, only the room for the string
+was reserved in the log buffer, and the string must be copied there with
+log_write_reserved() after the log has been released.
 @return	end lsn of the log record, zero if did not succeed */
 UNIV_INLINE
 lsn_t
@@ -112,7 +120,24 @@ log_reserve_and_write_fast(
 /*=======================*/
 	const void*	str,	/*!< in: string */
 	ulint		len,	/*!< in: string length */
-	lsn_t*		start_lsn);/*!< out: start lsn of the log record */
+	lsn_t*		start_lsn,/*!< out: start lsn of the log record */
+	byte**		copy_to,/*!< out: where to copy the string,
+				or NULL if it was already written */
+	ulint*		copy_slot);/*!< out: slot of
+				log_sys->n_pending_copies that counts the
+				copy, if *copy_to was set */
+/************************************************************//**
+Copies a string to the room that log_reserve_and_write_fast() reserved for
+it in the log buffer. This is called after log_release(). */
+UNIV_INLINE
+void
+log_write_reserved(
+/*===============*/
+	byte*		copy_to,/*!< in: where to copy the string */
+	ulint		copy_slot,/*!< in: slot of log_sys->n_pending_copies
+				returned by log_reserve_and_write_fast() */
+	const void*	str,	/*!< in: string */
+	ulint		len);	/*!< in: string length */
 /***********************************************************************//**
 Releases the log mutex. */
 UNIV_INLINE
@@ -882,6 +907,20 @@ struct log_t{
 					mtr_commit and still ensure that
 					insertions in the flush_list happen
 					in the LSN order. */
+	ulint		n_pending_copies[2];/*!< number of
+					mini-transactions that have reserved
+					room in the log buffer in
+					log_reserve_and_write_fast() and are
+					copying their log records there without
+					holding the mutex; the log buffer must
+					not be written or moved until both
+					counts are zero */
+	ulint		copy_slot;/*!< the slot of n_pending_copies[]
+					that counts new reservations;
+					log_wait_for_copies() switches it so
+					that it can wait for the older copies
+					without holding the mutex; protected
+					by mutex */
 #endif /* !UNIV_HOTBACKUP */
 	byte*		buf_ptr;	/* unaligned log buffer */
 	byte*		buf;		/*!< log buffer */
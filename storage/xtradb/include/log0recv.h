@@ -412,8 +412,18 @@ struct recv_dblwr_t {
 
 	std::list<byte *> pages; /* Pages from double write buffer */
 
+	std::list<byte *> bufs;	/* Buffers of the pages read from the
+				doublewrite files, freed with ut_free() */
+
 	void operator() () {
 		pages.clear();
+
+		for (std::list<byte*>::iterator i = bufs.begin();
+		     i != bufs.end(); ++i) {
+			ut_free(*i);
+		}
+
+		bufs.clear();
 	}
 };
 
@@ -486,6 +496,9 @@ struct recv_sys_t{
 	hash_table_t*	addr_hash;/*!< hash table of file addresses of pages */
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
+	ulint		n_apply_threads;
+				/*!< number of recv_apply_thread()s
+				still running in the current batch */
 
 	recv_dblwr_t	dblwr;
 };
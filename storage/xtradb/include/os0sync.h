@@ -788,6 +788,16 @@ architecture. Disable memory barrier for Intel architecture for now. */
 	"Memory barrier is not used"
 #endif
 
+/** Loads and stores that are not reordered with the memory accesses
+that follow (os_atomic_load_acquire) or precede (os_atomic_store_release)
+them, for data that is read without the latch protecting it. */
+#ifdef HAVE_IB_GCC_ATOMIC_THREAD_FENCE
+# define HAVE_ATOMIC_LOAD_STORE
+# define os_atomic_load_acquire(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+# define os_atomic_store_release(ptr, val) \
+	__atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#endif
+
 #ifndef UNIV_NONINL
 #include "os0sync.ic"
 #endif
@@ -195,6 +195,10 @@ struct read_view_t{
 	trx_id_t	creator_trx_id;
 				/*!< trx id of creating transaction, or
 				0 used in purge */
+	ulint		descr_version;
+				/*!< trx_sys->descr_version when the
+				descriptors were copied, or ULINT_UNDEFINED
+				if they can't be reused */
 	UT_LIST_NODE_T(read_view_t) view_list;
 				/*!< List of read views in trx_sys */
 };
@@ -53,6 +53,13 @@ in addition to the data and the offsets */
 #define REC_STATUS_NODE_PTR	1
 #define REC_STATUS_INFIMUM	2
 #define REC_STATUS_SUPREMUM	3
+/* A leaf page record of a clustered index to which columns were added
+instantly, see dict_index_is_instant().  The record header is followed
+by the number of fields in excess of dict_index_t::n_core_fields, in
+one or two bytes, and the null flags cover the nullable fields among
+the stored fields.  Any fields that are not stored take the default
+value of the column. */
+#define REC_STATUS_COLUMNS_ADDED 4
 
 /* The following four constants are needed in page0zip.cc in order to
 efficiently compress and decompress pages. */
@@ -543,10 +550,27 @@ rec_get_nth_field_offs(
 	const ulint*	offsets,/*!< in: array returned by rec_get_offsets() */
 	ulint		n,	/*!< in: index of the field */
 	ulint*		len)	/*!< out: length of the field; UNIV_SQL_NULL
-				if SQL null */
+				if SQL null; UNIV_SQL_DEFAULT if the field
+				is not stored, see rec_get_nth_cfield() */
 	__attribute__((nonnull));
 #define rec_get_nth_field(rec, offsets, n, len) \
 ((rec) + rec_get_nth_field_offs(offsets, n, len))
+/************************************************************//**
+Gets the value of the nth field of a record, also if the field is not
+stored in the record because the column was added instantly.
+@return	pointer to the data of the field; undefined if SQL null */
+UNIV_INLINE
+const byte*
+rec_get_nth_cfield(
+/*===============*/
+	const rec_t*		rec,	/*!< in: record */
+	const dict_index_t*	index,	/*!< in: record descriptor */
+	const ulint*		offsets,/*!< in: array returned by
+					rec_get_offsets() */
+	ulint			n,	/*!< in: index of the field */
+	ulint*			len)	/*!< out: length of the field;
+					UNIV_SQL_NULL if SQL null */
+	__attribute__((nonnull, warn_unused_result));
 /******************************************************//**
 Determine if the offsets are for a record in the new
 compact format.
@@ -568,6 +592,16 @@ rec_offs_any_extern(
 	const ulint*	offsets)/*!< in: array returned by rec_get_offsets() */
 	__attribute__((nonnull, pure, warn_unused_result));
 /******************************************************//**
+Determine if the offsets are for a record that lacks some fields
+because of columns that were added instantly.
+@return	nonzero if some fields take their default values */
+UNIV_INLINE
+ulint
+rec_offs_any_default(
+/*=================*/
+	const ulint*	offsets)/*!< in: array returned by rec_get_offsets() */
+	__attribute__((nonnull, pure, warn_unused_result));
+/******************************************************//**
 Determine if the offsets are for a record containing null BLOB pointers.
 @return	first field containing a null BLOB pointer, or NULL if none found */
 UNIV_INLINE
@@ -598,6 +632,17 @@ rec_offs_nth_sql_null(
 	ulint		n)	/*!< in: nth field */
 	__attribute__((nonnull, pure, warn_unused_result));
 /******************************************************//**
+Returns nonzero if the nth field is not stored in the record, because
+the column was added instantly after the record was written.
+@return	nonzero if the field takes the default value of the column */
+UNIV_INLINE
+ulint
+rec_offs_nth_default(
+/*=================*/
+	const ulint*	offsets,/*!< in: array returned by rec_get_offsets() */
+	ulint		n)	/*!< in: nth field */
+	__attribute__((nonnull, pure, warn_unused_result));
+/******************************************************//**
 Gets the physical size of a field.
 @return	length of field */
 UNIV_INLINE
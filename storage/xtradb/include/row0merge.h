@@ -129,6 +129,9 @@ struct row_merge_dup_t {
 					(index->table), or NULL if not
 					rebuilding table */
 	ulint			n_dup;	/*!< number of duplicates */
+	os_fast_mutex_t*	mutex;	/*!< mutex for reporting duplicates
+					when several threads sort entries
+					of the same index, or NULL */
 };
 
 /*************************************************************//**
@@ -383,7 +386,11 @@ row_merge_sort(
 					index entries */
 	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
 	int*			tmpfd,	/*!< in/out: temporary file handle */
-	const bool		update_progress, /*!< in: update progress status variable or not */
+	const bool		update_progress, /*!< in: update progress status variable
+						and the progress report of
+						trx->mysql_thd or not; false
+						if not called by the thread
+						of trx->mysql_thd */
 	const float		pct_progress, /*!< in: total progress percent until now */
 	const float		pct_cost) /*!< in: current progress percent */
 	__attribute__((nonnull));
@@ -185,6 +185,15 @@ struct srv_stats_t {
 	/** Number of lock deadlocks */
 	ulint_ctr_1_t		lock_deadlock_count;
 
+	/** Number of read views opened without copying the active
+	transactions again, because none started or committed since the
+	view was last opened */
+	ulint_ctr_64_t		n_read_views_reused;
+
+	/** Number of read views whose active transactions were copied
+	again under trx_sys->mutex, because they changed during the copy */
+	ulint_ctr_64_t		n_read_views_recopied;
+
 	/** Number of lock waits that have been up to max time (i.e.) lock
 	wait timeout */
 	ulint_ctr_1_t		n_lock_max_wait_time;
@@ -213,6 +222,9 @@ and/or load it during startup. */
 extern char		srv_buffer_pool_dump_at_shutdown;
 extern char		srv_buffer_pool_load_at_startup;
 
+/** The number of threads reading the pages of a buffer pool load */
+extern ulong		srv_buf_load_threads;
+
 /* Whether to disable file system cache if it is defined */
 extern char		srv_disable_sort_file_cache;
 
@@ -268,6 +280,9 @@ extern my_bool	srv_read_only_mode;
 /** store to its own file each table created by an user; data
 dictionary tables are in the system tablespace 0 */
 extern my_bool	srv_file_per_table;
+/** create each temporary table in a tablespace of its own whose changes
+are not written to the redo log nor to the doublewrite buffer */
+extern my_bool	srv_unlogged_temp_tables;
 /** Sleep delay for threads waiting to enter InnoDB. In micro-seconds. */
 extern	ulong	srv_thread_sleep_delay;
 #if defined(HAVE_ATOMIC_BUILTINS)
@@ -287,6 +302,9 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Number of threads that read, sort and load the entries of new
+indexes in index creation */
+extern ulong	srv_index_build_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -515,6 +533,9 @@ extern unsigned long long	srv_stats_modified_counter;
 extern my_bool			srv_stats_sample_traditional;
 
 extern ibool	srv_use_doublewrite_buf;
+/** TRUE if the batch flushes of each buffer pool instance use their own
+doublewrite buffer and file */
+extern my_bool	srv_parallel_doublewrite;
 extern ulong	srv_doublewrite_batch_size;
 extern ulong	srv_checksum_algorithm;
 
@@ -676,12 +697,18 @@ extern ulong srv_n_purge_threads;
 /* the number of pages to purge in one batch */
 extern ulong srv_purge_batch_size;
 
+/* the number of threads that apply redo log records in crash recovery */
+extern ulong srv_n_recovery_threads;
+
 /* the number of sync wait arrays */
 extern ulong srv_sync_array_size;
 
 /* print all user-level transactions deadlocks to mysqld stderr */
 extern my_bool srv_print_all_deadlocks;
 
+/** when to look for deadlocks, see lock_deadlock_detect_t */
+extern ulong srv_deadlock_detect_mode;
+
 extern my_bool	srv_cmp_per_index_enabled;
 
 /* is encryption enabled */
@@ -723,6 +750,9 @@ extern mysql_pfs_key_t	srv_monitor_thread_key;
 extern mysql_pfs_key_t	srv_master_thread_key;
 extern mysql_pfs_key_t	srv_purge_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
+extern mysql_pfs_key_t	buf_load_thread_key;
+extern mysql_pfs_key_t	row_merge_thread_key;
 extern mysql_pfs_key_t	srv_log_tracking_thread_key;
 
 /* This macro register the current thread and its key with performance
@@ -1117,6 +1147,8 @@ struct export_var_t{
 	ulint innodb_dblwr_pages_written;	/*!< srv_dblwr_pages_written */
 	ulint innodb_dblwr_writes;		/*!< srv_dblwr_writes */
 	ulint innodb_deadlocks;
+	ib_uint64_t innodb_deadlock_detect_time;/*!< lock_sys->deadlock_detect_time */
+	ulint innodb_deadlock_graph_size;	/*!< lock_sys->deadlock_graph_size */
 	ibool innodb_have_atomic_builtins;	/*!< HAVE_ATOMIC_BUILTINS */
 	ulint innodb_history_list_length;
 	ulint innodb_ibuf_size;
@@ -1177,6 +1209,8 @@ struct export_var_t{
 	ulint innodb_truncated_status_writes;	/*!< srv_truncated_status_writes */
 	ulint innodb_available_undo_logs;       /*!< srv_available_undo_logs */
 	ulint innodb_read_views_memory;		/*!< srv_read_views_memory */
+	ulint innodb_read_views_reused;		/*!< srv_stats.n_read_views_reused */
+	ulint innodb_read_views_recopied;	/*!< srv_stats.n_read_views_recopied */
 	ulint innodb_descriptors_memory;	/*!< srv_descriptors_memory */
 	ib_int64_t innodb_s_lock_os_waits;
 	ib_int64_t innodb_s_lock_spin_rounds;
@@ -684,8 +684,19 @@ struct trx_sys_t{
 					descr_n_used */
 	ulint		descr_n_used;	/*!< Number of used elements in the
 					descriptors array. */
+	ulint		descr_version;	/*!< Incremented whenever the
+					descriptors array is modified.
+					read_view_open_now() copies the array
+					without holding the mutex and checks
+					this under the mutex. */
 	char		pad3[64];	/*!< Ensure descriptors do not share
 					cache line with other fields */
+	trx_id_t*	descr_retired[64];
+					/*!< Descriptors arrays replaced by a
+					bigger one. They are only freed at
+					shutdown, because read_view_open_now()
+					may still be reading them. */
+	ulint		descr_n_retired;/*!< Number of retired arrays */
 #ifdef UNIV_DEBUG
 	trx_id_t	rw_max_trx_id;	/*!< Max trx id of read-write transactions
 					which exist or existed */
@@ -575,6 +575,13 @@ computers! */
 
 #define UNIV_SQL_NULL ULINT32_UNDEFINED
 
+/** The following number as the length of a field in a physical record
+means that the field is not stored in the record, because the column
+was added instantly after the record was written.  The value of the
+field is the default value of the column, dict_col_t::def_val. */
+
+#define UNIV_SQL_DEFAULT (UNIV_SQL_NULL - 1)
+
 /** Lengths which are not UNIV_SQL_NULL, but bigger than the following
 number indicate that a field contains a reference to an externally
 stored part of the field in the tablespace. The length field then
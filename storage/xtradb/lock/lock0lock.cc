@@ -50,6 +50,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "btr0btr.h"
 #include "dict0boot.h"
 #include <set>
+#include <algorithm>
 #include "mysql/plugin.h"
 
 #include <mysql/service_wsrep.h>
@@ -390,9 +391,14 @@ static lock_stack_t*	lock_stack;
 /** The count of the types of locks. */
 static const ulint	lock_types = UT_ARR_SIZE(lock_compatibility_matrix);
 
+#ifdef UNIV_PFS_RWLOCK
+/* Key to register rw-lock with performance schema */
+UNIV_INTERN mysql_pfs_key_t	lock_sys_latch_key;
+#endif /* UNIV_PFS_RWLOCK */
+
 #ifdef UNIV_PFS_MUTEX
 /* Key to register mutex with performance schema */
-UNIV_INTERN mysql_pfs_key_t	lock_sys_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	lock_sys_rec_mutex_key;
 /* Key to register mutex with performance schema */
 UNIV_INTERN mysql_pfs_key_t	lock_sys_wait_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
@@ -451,6 +457,13 @@ lock_deadlock_check_and_resolve(
 	const lock_t*	lock,	/*!< in: lock the transaction is requesting */
 	const trx_t*	trx);	/*!< in: transaction */
 
+/*********************************************************************//**
+Frees the wait-for graph of lock_deadlock_detect_background(). */
+static
+void
+lock_wfg_free(void);
+/*===============*/
+
 /*********************************************************************//**
 Gets the nth bit of a record lock.
 @return	TRUE if bit set also if i == ULINT_UNDEFINED return FALSE*/
@@ -623,7 +636,12 @@ lock_sys_create(
 
 	lock_sys->last_slot = lock_sys->waiting_threads;
 
-	mutex_create(lock_sys_mutex_key, &lock_sys->mutex, SYNC_LOCK_SYS);
+	rw_lock_create(lock_sys_latch_key, &lock_sys->latch, SYNC_LOCK_SYS);
+
+	for (ulint i = 0; i < LOCK_REC_N_SHARDS; i++) {
+		mutex_create(lock_sys_rec_mutex_key, &lock_sys->rec_mutexes[i],
+			     SYNC_LOCK_REC_SHARD);
+	}
 
 	mutex_create(lock_sys_wait_mutex_key,
 		     &lock_sys->wait_mutex, SYNC_LOCK_WAIT_SYS);
@@ -653,9 +671,15 @@ lock_sys_close(void)
 
 	hash_table_free(lock_sys->rec_hash);
 
-	mutex_free(&lock_sys->mutex);
+	rw_lock_free(&lock_sys->latch);
+
+	for (ulint i = 0; i < LOCK_REC_N_SHARDS; i++) {
+		mutex_free(&lock_sys->rec_mutexes[i]);
+	}
 	mutex_free(&lock_sys->wait_mutex);
 
+	lock_wfg_free();
+
 	mem_free(lock_stack);
 	mem_free(lock_sys);
 
@@ -1236,6 +1260,39 @@ lock_rec_reset_nth_bit(
 	((byte*) &lock[1])[byte_index] &= ~(1 << bit_index);
 }
 
+/*********************************************************************//**
+Gets the mutex of the rec_hash shard that the record locks on a page
+belong to.
+@return	mutex of the shard */
+UNIV_INLINE
+ib_mutex_t*
+lock_rec_get_shard_mutex(
+/*=====================*/
+	ulint	hash)	/*!< in: lock_rec_hash() of the page */
+{
+	return(&lock_sys->rec_mutexes[
+		       ut_2pow_remainder(hash, LOCK_REC_N_SHARDS)]);
+}
+
+#ifdef UNIV_DEBUG
+/*********************************************************************//**
+Checks if the current thread may access the record lock queue of a page:
+either it holds lock_sys->latch in exclusive mode, or in shared mode
+together with the mutex of the shard of the page.
+@return	true if it may */
+static
+bool
+lock_rec_queue_own(
+/*===============*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	return(lock_mutex_own()
+	       || mutex_own(lock_rec_get_shard_mutex(
+				    lock_rec_hash(space, page_no))));
+}
+#endif /* UNIV_DEBUG */
+
 /*********************************************************************//**
 Gets the first or next record lock on a page.
 @return	next lock, NULL if none exists */
@@ -1248,12 +1305,13 @@ lock_rec_get_next_on_page_const(
 	ulint	space;
 	ulint	page_no;
 
-	ut_ad(lock_mutex_own());
 	ut_ad(lock_get_type_low(lock) == LOCK_REC);
 
 	space = lock->un_member.rec_lock.space;
 	page_no = lock->un_member.rec_lock.page_no;
 
+	ut_ad(lock_rec_queue_own(space, page_no));
+
 	for (;;) {
 		lock = static_cast<const lock_t*>(HASH_GET_NEXT(hash, lock));
 
@@ -1349,7 +1407,7 @@ lock_rec_get_first_on_page(
 	ulint	space	= buf_block_get_space(block);
 	ulint	page_no	= buf_block_get_page_no(block);
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(space, page_no));
 
 	hash = buf_block_get_lock_hash_val(block);
 
@@ -2006,7 +2064,8 @@ lock_rec_create(
 	ulint		n_bytes;
 	const page_t*	page;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -2057,7 +2116,13 @@ lock_rec_create(
 	lock->requested_time = ut_time();
 	lock->wait_time = 0;
 
+#ifdef HAVE_ATOMIC_BUILTINS
+	/* lock_rec_lock() may create locks in different shards of
+	rec_hash at the same time */
+	os_atomic_increment_ulint(&index->table->n_rec_locks, 1);
+#else /* HAVE_ATOMIC_BUILTINS */
 	index->table->n_rec_locks++;
+#endif /* HAVE_ATOMIC_BUILTINS */
 
 	ut_ad(index->table->n_ref_count > 0 || !index->table->can_be_evicted);
 
@@ -2144,7 +2209,11 @@ lock_rec_create(
 		    lock_rec_fold(space, page_no), lock);
 #endif /* WITH_WSREP */
 
+#ifdef HAVE_ATOMIC_BUILTINS
+	os_atomic_increment_ulint(&lock_sys->rec_num, 1);
+#else /* HAVE_ATOMIC_BUILTINS */
 	lock_sys->rec_num++;
+#endif /* HAVE_ATOMIC_BUILTINS */
 
 	if (!caller_owns_trx_mutex) {
 		trx_mutex_enter(trx);
@@ -2161,8 +2230,8 @@ lock_rec_create(
 		trx_mutex_exit(trx);
 	}
 
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 	return(lock);
 }
 
@@ -2472,7 +2541,8 @@ lock_rec_lock_fast(
 	trx_t*			trx;
 	enum lock_rec_req_status status = LOCK_REC_SUCCESS;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_queue_own(buf_block_get_space(block),
+				 buf_block_get_page_no(block)));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2646,7 +2716,10 @@ lock_rec_lock(
 	dict_index_t*		index,	/*!< in: index of record */
 	que_thr_t*		thr)	/*!< in: query thread */
 {
-	ut_ad(lock_mutex_own());
+	enum lock_rec_req_status	status;
+	dberr_t				err;
+
+	ut_ad(!lock_mutex_own());
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2661,18 +2734,48 @@ lock_rec_lock(
 
 	/* We try a simplified and faster subroutine for the most
 	common cases */
-	switch (lock_rec_lock_fast(impl, mode, block, heap_no, index, thr)) {
-	case LOCK_REC_SUCCESS:
-		return(DB_SUCCESS);
-	case LOCK_REC_SUCCESS_CREATED:
-		return(DB_SUCCESS_LOCKED_REC);
-	case LOCK_REC_FAIL:
-		return(lock_rec_lock_slow(impl, mode, block,
-					  heap_no, index, thr));
+#ifdef HAVE_ATOMIC_BUILTINS
+	/* It only looks at the lock queue of the page. Transactions
+	locking records on pages of other shards of rec_hash can do so
+	at the same time, while the s-latch keeps out everybody that
+	needs the lock system for itself. */
+	ib_mutex_t*	shard_mutex = lock_rec_get_shard_mutex(
+		buf_block_get_lock_hash_val(block));
+
+	rw_lock_s_lock(&lock_sys->latch);
+	mutex_enter(shard_mutex);
+
+	status = lock_rec_lock_fast(impl, mode, block, heap_no, index, thr);
+
+	mutex_exit(shard_mutex);
+	rw_lock_s_unlock(&lock_sys->latch);
+
+	if (status == LOCK_REC_FAIL) {
+		lock_mutex_enter();
+		err = lock_rec_lock_slow(impl, mode, block,
+					 heap_no, index, thr);
+		lock_mutex_exit();
+
+		return(err);
 	}
+#else /* HAVE_ATOMIC_BUILTINS */
+	lock_mutex_enter();
 
-	ut_error;
-	return(DB_ERROR);
+	status = lock_rec_lock_fast(impl, mode, block, heap_no, index, thr);
+
+	if (status == LOCK_REC_FAIL) {
+		err = lock_rec_lock_slow(impl, mode, block,
+					 heap_no, index, thr);
+		lock_mutex_exit();
+
+		return(err);
+	}
+
+	lock_mutex_exit();
+#endif /* HAVE_ATOMIC_BUILTINS */
+
+	return(status == LOCK_REC_SUCCESS_CREATED
+	       ? DB_SUCCESS_LOCKED_REC : DB_SUCCESS);
 }
 
 /*********************************************************************//**
@@ -4493,6 +4596,8 @@ lock_deadlock_check_and_resolve(
 	struct thd_wait_reports	waitee_buf;
 	struct thd_wait_reports*waitee_buf_ptr;
 	THD*			start_mysql_thd;
+	ullint			start_time;
+	ulint			cost = 0;
 
 	ut_ad(trx != NULL);
 	ut_ad(lock != NULL);
@@ -4506,6 +4611,19 @@ lock_deadlock_check_and_resolve(
 		waitee_buf_ptr = NULL;
 	}
 
+	/* Leave the search to lock_deadlock_detect_background(), unless
+	the waits must be reported to the server as they happen. */
+	if (srv_deadlock_detect_mode == LOCK_DEADLOCK_DETECT_BACKGROUND
+	    && waitee_buf_ptr == NULL
+#ifdef WITH_WSREP
+	    && !wsrep_on(start_mysql_thd)
+#endif /* WITH_WSREP */
+	    ) {
+		return(0);
+	}
+
+	start_time = ut_time_us(NULL);
+
 	/* Try and resolve as many deadlocks as possible. */
 	do {
 		lock_deadlock_ctx_t	ctx;
@@ -4525,6 +4643,8 @@ lock_deadlock_check_and_resolve(
 
 		victim_trx_id = lock_deadlock_search(&ctx, waitee_buf_ptr);
 
+		cost += ctx.cost;
+
 		/* Report waits to upper layer, as needed. */
 		if (waitee_buf_ptr) {
 			lock_report_waiters_to_mysql(waitee_buf_ptr,
@@ -4576,9 +4696,502 @@ lock_deadlock_check_and_resolve(
 		lock_deadlock_found = TRUE;
 	}
 
+	lock_sys->deadlock_detect_time += ut_time_us(NULL) - start_time;
+	lock_sys->deadlock_graph_size = cost;
+
 	return(victim_trx_id);
 }
 
+/*=========== BACKGROUND DEADLOCK DETECTION ==========================*/
+
+/** Search state of a node of the wait-for graph */
+enum lock_wfg_state_t {
+	LOCK_WFG_NEW,		/*!< not visited yet */
+	LOCK_WFG_ON_STACK,	/*!< on the current search path */
+	LOCK_WFG_DONE		/*!< all its edges were followed */
+};
+
+/** Edge of the wait-for graph. The transaction must not be dereferenced,
+because it may have been freed after the edge was cached. */
+struct lock_wfg_edge_t {
+	const trx_t*	trx;		/*!< transaction that holds a lock
+					that the node is waiting for */
+	trx_id_t	trx_id;		/*!< trx->id */
+};
+
+/** Node of the wait-for graph, for a slot of lock_sys->waiting_threads */
+struct lock_wfg_node_t {
+	trx_t*		trx;		/*!< suspended transaction, or NULL
+					if the slot is not waiting */
+	trx_id_t	trx_id;		/*!< trx->id when the edges were
+					computed */
+	const lock_t*	wait_lock;	/*!< trx->lock.wait_lock when the
+					edges were computed */
+	lock_wfg_edge_t*edges;		/*!< transactions that hold a lock
+					that wait_lock has to wait for */
+	ulint		n_edges;	/*!< number of edges */
+	ulint		max_edges;	/*!< allocated size of edges */
+	lock_wfg_state_t state;		/*!< search state */
+	ulint		next_edge;	/*!< next edge to follow */
+	ulint		parent;		/*!< node that the search came from */
+};
+
+/** Lookup entry from a transaction to its node in the wait-for graph */
+struct lock_wfg_index_t {
+	const trx_t*	trx;		/*!< suspended transaction */
+	ulint		node;		/*!< its slot in lock_wfg */
+};
+
+/** Wait-for graph of lock_deadlock_detect_background(), with a node for
+each slot of lock_sys->waiting_threads. The edges of a node are cached
+until the transaction waits for another lock. All of them are computed
+again once a second, because a lock may be granted ahead of a waiting
+lock. Protected by lock_sys->wait_mutex and lock_sys->mutex. */
+static lock_wfg_node_t*		lock_wfg;
+/** Nodes of lock_wfg sorted by transaction */
+static lock_wfg_index_t*	lock_wfg_index;
+/** Number of entries in lock_wfg_index */
+static ulint			lock_wfg_n_nodes;
+/** When all the edges of lock_wfg were last computed */
+static ib_time_t		lock_wfg_rebuilt;
+
+/** Orders lock_wfg_index by transaction */
+struct lock_wfg_index_less {
+	bool operator()(const lock_wfg_index_t& a,
+			const lock_wfg_index_t& b) const
+	{
+		return(a.trx < b.trx);
+	}
+};
+
+/********************************************************************//**
+Computes the edges of a node of the wait-for graph from the lock queue
+of the lock that its transaction is waiting for. */
+static
+void
+lock_wfg_compute_edges(
+/*===================*/
+	lock_wfg_node_t*	node)	/*!< in/out: node with trx set */
+{
+	const lock_t*	wait_lock = node->trx->lock.wait_lock;
+	const lock_t*	lock;
+	ulint		heap_no = ULINT_UNDEFINED;
+
+	ut_ad(lock_mutex_own());
+	ut_ad(wait_lock != NULL);
+
+	node->trx_id = node->trx->id;
+	node->wait_lock = wait_lock;
+	node->n_edges = 0;
+
+	if (lock_get_type_low(wait_lock) == LOCK_REC) {
+		heap_no = lock_rec_find_set_bit(wait_lock);
+
+		lock = lock_rec_get_first_on_page_addr(
+			wait_lock->un_member.rec_lock.space,
+			wait_lock->un_member.rec_lock.page_no);
+	} else {
+		lock = UT_LIST_GET_PREV(un_member.tab_lock.locks, wait_lock);
+	}
+
+	/* Look at the locks ahead of wait_lock in the queue */
+	while (lock != NULL && lock != wait_lock) {
+
+		if ((heap_no == ULINT_UNDEFINED
+		     || lock_rec_get_nth_bit(lock, heap_no))
+		    && lock->trx != node->trx
+		    && lock_has_to_wait(wait_lock, lock)
+		    && (node->n_edges == 0
+			|| node->edges[node->n_edges - 1].trx != lock->trx)) {
+
+			if (node->n_edges == node->max_edges) {
+				node->max_edges = node->max_edges
+					? 2 * node->max_edges : 8;
+				node->edges = static_cast<lock_wfg_edge_t*>(
+					ut_realloc(node->edges,
+						   node->max_edges
+						   * sizeof *node->edges));
+				ut_a(node->edges);
+			}
+
+			node->edges[node->n_edges].trx = lock->trx;
+			node->edges[node->n_edges].trx_id = lock->trx->id;
+			node->n_edges++;
+		}
+
+		if (heap_no == ULINT_UNDEFINED) {
+			lock = UT_LIST_GET_PREV(un_member.tab_lock.locks, lock);
+		} else {
+			lock = lock_rec_get_next_on_page_const(lock);
+		}
+	}
+}
+
+/********************************************************************//**
+Finds the node of the wait-for graph that an edge leads to.
+@return slot of the node, or ULINT_UNDEFINED if the transaction is not
+suspended in a lock wait */
+static
+ulint
+lock_wfg_get_node(
+/*==============*/
+	const lock_wfg_edge_t*	edge)	/*!< in: edge */
+{
+	lock_wfg_index_t	key;
+	lock_wfg_index_t*	end = lock_wfg_index + lock_wfg_n_nodes;
+	lock_wfg_index_t*	it;
+
+	key.trx = edge->trx;
+
+	it = std::lower_bound(lock_wfg_index, end, key,
+			      lock_wfg_index_less());
+
+	if (it == end || it->trx != edge->trx) {
+		return(ULINT_UNDEFINED);
+	}
+
+	const lock_wfg_node_t*	node = &lock_wfg[it->node];
+
+	/* The transaction object may have been reused since the edge
+	was computed */
+	if (node->trx == NULL || node->trx->id != edge->trx_id) {
+		return(ULINT_UNDEFINED);
+	}
+
+	return(it->node);
+}
+
+/********************************************************************//**
+Looks for a cycle in the wait-for graph with an iterative depth-first
+search. The members of the cycle can be found by following the parent
+links from the returned node back to its successor.
+@return last node of a cycle, or ULINT_UNDEFINED if there are none */
+static
+ulint
+lock_wfg_find_cycle(
+/*================*/
+	ulint	n_slots,	/*!< in: number of nodes */
+	ulint*	first)		/*!< out: first node of the cycle */
+{
+	ulint	i;
+
+	for (i = 0; i < n_slots; i++) {
+		lock_wfg[i].state = LOCK_WFG_NEW;
+	}
+
+	for (i = 0; i < n_slots; i++) {
+		ulint	cur = i;
+
+		if (lock_wfg[i].trx == NULL
+		    || lock_wfg[i].state != LOCK_WFG_NEW) {
+			continue;
+		}
+
+		lock_wfg[i].state = LOCK_WFG_ON_STACK;
+		lock_wfg[i].next_edge = 0;
+		lock_wfg[i].parent = ULINT_UNDEFINED;
+
+		while (cur != ULINT_UNDEFINED) {
+			lock_wfg_node_t*	node = &lock_wfg[cur];
+			ulint			next;
+
+			if (node->next_edge == node->n_edges) {
+				node->state = LOCK_WFG_DONE;
+				cur = node->parent;
+				continue;
+			}
+
+			next = lock_wfg_get_node(
+				&node->edges[node->next_edge++]);
+
+			if (next == ULINT_UNDEFINED) {
+				continue;
+			}
+
+			switch (lock_wfg[next].state) {
+			case LOCK_WFG_ON_STACK:
+				*first = next;
+				return(cur);
+			case LOCK_WFG_NEW:
+				lock_wfg[next].state = LOCK_WFG_ON_STACK;
+				lock_wfg[next].next_edge = 0;
+				lock_wfg[next].parent = cur;
+				cur = next;
+				break;
+			case LOCK_WFG_DONE:
+				break;
+			}
+		}
+	}
+
+	return(ULINT_UNDEFINED);
+}
+
+/********************************************************************//**
+Checks that a cycle found in the wait-for graph is a deadlock, by
+computing again the edges of its members from the lock queues.
+@return true if every member still waits for the next one */
+static
+bool
+lock_wfg_check_cycle(
+/*=================*/
+	ulint	last,	/*!< in: last node of the cycle */
+	ulint	first)	/*!< in: first node of the cycle */
+{
+	bool	deadlock = true;
+	ulint	succ = first;
+
+	for (ulint cur = last; ; cur = lock_wfg[cur].parent) {
+		lock_wfg_node_t*	node = &lock_wfg[cur];
+		bool			found = false;
+
+		if (node->trx->lock.wait_lock == NULL) {
+			/* The lock was granted when a deadlock victim
+			released its waiting lock */
+			node->trx = NULL;
+			deadlock = false;
+		} else {
+			lock_wfg_compute_edges(node);
+
+			for (ulint i = 0; i < node->n_edges; i++) {
+				if (lock_wfg_get_node(&node->edges[i])
+				    == succ) {
+					found = true;
+					break;
+				}
+			}
+
+			deadlock = deadlock && found;
+		}
+
+		if (cur == first) {
+			return(deadlock);
+		}
+
+		succ = cur;
+	}
+}
+
+/********************************************************************//**
+Compares two members of a deadlock as the victim to roll back. Like
+lock_deadlock_select_victim(), avoids brute force appliers under wsrep.
+@return true if trx should be rolled back rather than victim */
+static
+bool
+lock_wfg_prefer_victim(
+/*===================*/
+	const trx_t*	trx,	/*!< in: member of the cycle */
+	const trx_t*	victim)	/*!< in: victim chosen so far */
+{
+#ifdef WITH_WSREP
+	bool	trx_bf = wsrep_thd_is_BF(trx->mysql_thd, TRUE);
+	bool	victim_bf = wsrep_thd_is_BF(victim->mysql_thd, TRUE);
+
+	if (trx_bf != victim_bf) {
+		return(victim_bf);
+	}
+#endif /* WITH_WSREP */
+
+	return(trx_weight_ge(victim, trx));
+}
+
+/********************************************************************//**
+Reports a deadlock found in the wait-for graph and rolls back the
+lightest transaction of the cycle. */
+static
+void
+lock_wfg_resolve_cycle(
+/*===================*/
+	ulint	last,	/*!< in: last node of the cycle */
+	ulint	first)	/*!< in: first node of the cycle */
+{
+	trx_t*	victim = NULL;
+	ulint	victim_no = 0;
+	ulint	n = 0;
+	char	buf[80];
+
+	ut_ad(lock_mutex_own());
+
+	lock_deadlock_start_print();
+
+	for (ulint cur = last; ; cur = lock_wfg[cur].parent) {
+		trx_t*	trx = lock_wfg[cur].trx;
+
+		n++;
+
+		ut_snprintf(buf, sizeof buf, "\n*** (%lu) TRANSACTION:\n",
+			    (ulong) n);
+		lock_deadlock_fputs(buf);
+		lock_deadlock_trx_print(trx, 3000);
+
+		ut_snprintf(buf, sizeof buf,
+			    "*** (%lu) WAITING FOR THIS LOCK TO BE GRANTED:\n",
+			    (ulong) n);
+		lock_deadlock_fputs(buf);
+		lock_deadlock_lock_print(trx->lock.wait_lock);
+
+		if (victim == NULL || lock_wfg_prefer_victim(trx, victim)) {
+			victim = trx;
+			victim_no = n;
+		}
+
+		if (cur == first) {
+			break;
+		}
+	}
+
+	ut_snprintf(buf, sizeof buf, "*** WE ROLL BACK TRANSACTION (%lu)\n",
+		    (ulong) victim_no);
+	lock_deadlock_fputs(buf);
+
+	trx_mutex_enter(victim);
+
+	victim->lock.was_chosen_as_deadlock_victim = TRUE;
+
+	lock_cancel_waiting_and_release(victim->lock.wait_lock);
+
+	trx_mutex_exit(victim);
+
+	lock_deadlock_found = TRUE;
+
+	srv_stats.lock_deadlock_count.inc();
+
+	MONITOR_INC(MONITOR_DEADLOCK);
+}
+
+/*********************************************************************//**
+Looks for cycles in the wait-for graph of the suspended transactions and
+rolls back a victim of each one. This is how deadlocks are detected with
+innodb_deadlock_detect_mode=BACKGROUND. The caller must own
+lock_sys->wait_mutex. */
+UNIV_INTERN
+void
+lock_deadlock_detect_background(void)
+/*=================================*/
+{
+	ulint		n_slots;
+	ulint		last;
+	ulint		first;
+	ib_time_t	now = ut_time();
+	bool		rebuild;
+	ullint		start_time;
+
+	ut_ad(lock_wait_mutex_own());
+	ut_ad(!srv_read_only_mode);
+
+	n_slots = lock_sys->last_slot - lock_sys->waiting_threads;
+
+	lock_mutex_enter();
+
+	start_time = ut_time_us(NULL);
+
+	if (lock_wfg == NULL) {
+		lock_wfg = static_cast<lock_wfg_node_t*>(
+			mem_zalloc(OS_THREAD_MAX_N * sizeof *lock_wfg));
+		lock_wfg_index = static_cast<lock_wfg_index_t*>(
+			mem_alloc(OS_THREAD_MAX_N * sizeof *lock_wfg_index));
+	}
+
+	rebuild = now != lock_wfg_rebuilt;
+	lock_wfg_rebuilt = now;
+	lock_wfg_n_nodes = 0;
+
+	for (ulint i = 0; i < n_slots; i++) {
+		const srv_slot_t*	slot = &lock_sys->waiting_threads[i];
+		lock_wfg_node_t*	node = &lock_wfg[i];
+		trx_t*			trx = NULL;
+
+		/* A slot can't be freed or reserved without the lock
+		wait mutex, and the wait can't end without the lock mutex */
+		if (slot->in_use) {
+			trx = thr_get_trx(slot->thr);
+
+			if (trx->lock.wait_lock == NULL
+			    || trx->lock.wait_thr != slot->thr) {
+				trx = NULL;
+			}
+		}
+
+		if (trx == NULL) {
+			node->trx = NULL;
+			continue;
+		}
+
+		if (rebuild
+		    || node->trx != trx
+		    || node->trx_id != trx->id
+		    || node->wait_lock != trx->lock.wait_lock) {
+
+			node->trx = trx;
+			lock_wfg_compute_edges(node);
+		}
+
+		lock_wfg_index[lock_wfg_n_nodes].trx = trx;
+		lock_wfg_index[lock_wfg_n_nodes].node = i;
+		lock_wfg_n_nodes++;
+	}
+
+	lock_sys->deadlock_graph_size = lock_wfg_n_nodes;
+
+	std::sort(lock_wfg_index, lock_wfg_index + lock_wfg_n_nodes,
+		  lock_wfg_index_less());
+
+	while ((last = lock_wfg_find_cycle(n_slots, &first))
+	       != ULINT_UNDEFINED) {
+
+		/* The cached edges may be stale: only act on a cycle
+		that still exists. If it doesn't, the edges of its
+		members were computed again and we search again. */
+		if (lock_wfg_check_cycle(last, first)) {
+			lock_wfg_resolve_cycle(last, first);
+
+			for (ulint cur = last; ; cur = lock_wfg[cur].parent) {
+				/* The victim no longer waits, the other
+				transactions of the cycle may have been
+				granted their locks */
+				if (lock_wfg[cur].trx->lock.wait_lock
+				    == NULL) {
+					lock_wfg[cur].trx = NULL;
+				} else {
+					lock_wfg_compute_edges(&lock_wfg[cur]);
+				}
+
+				if (cur == first) {
+					break;
+				}
+			}
+		}
+	}
+
+	lock_sys->deadlock_detect_time += ut_time_us(NULL) - start_time;
+
+	lock_mutex_exit();
+}
+
+/*********************************************************************//**
+Frees the wait-for graph of lock_deadlock_detect_background(). */
+static
+void
+lock_wfg_free(void)
+/*===============*/
+{
+	if (lock_wfg == NULL) {
+		return;
+	}
+
+	for (ulint i = 0; i < OS_THREAD_MAX_N; i++) {
+		if (lock_wfg[i].edges != NULL) {
+			ut_free(lock_wfg[i].edges);
+		}
+	}
+
+	mem_free(lock_wfg);
+	mem_free(lock_wfg_index);
+
+	lock_wfg = NULL;
+	lock_wfg_index = NULL;
+}
+
 /*========================= TABLE LOCKS ==============================*/
 
 /*********************************************************************//**
@@ -6874,16 +7487,10 @@ lock_clust_rec_modify_check_and_lock(
 
 	lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 
-	lock_mutex_enter();
-
-	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
-
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
@@ -6938,16 +7545,10 @@ lock_sec_rec_modify_check_and_lock(
 	index record, and this would not have been possible if another active
 	transaction had modified this secondary index record. */
 
-	lock_mutex_enter();
-
-	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
-
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
 
 #ifdef UNIV_DEBUG
 	{
@@ -7046,19 +7647,10 @@ lock_sec_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
-	ut_ad(mode != LOCK_X
-	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
-	ut_ad(mode != LOCK_S
-	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
-
 	err = lock_rec_lock(FALSE, mode | gap_mode,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
@@ -7127,19 +7719,10 @@ lock_clust_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
-	ut_ad(mode != LOCK_X
-	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
-	ut_ad(mode != LOCK_S
-	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
-
 	err = lock_rec_lock(FALSE, mode | gap_mode,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
 
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
@@ -272,6 +272,11 @@ lock_wait_suspend_thread(
 
 	slot = lock_wait_table_reserve_slot(thr, lock_wait_timeout);
 
+	if (srv_deadlock_detect_mode == LOCK_DEADLOCK_DETECT_BACKGROUND) {
+		/* Let lock_wait_timeout_thread() look for a deadlock */
+		os_event_set(lock_sys->timeout_event);
+	}
+
 	if (thr->lock_state == QUE_THR_LOCK_ROW) {
 		srv_stats.n_lock_wait_count.inc();
 		srv_stats.n_lock_wait_current_count.inc();
@@ -516,6 +521,7 @@ DECLARE_THREAD(lock_wait_timeout_thread)(
 {
 	ib_int64_t	sig_count = 0;
 	os_event_t	event = lock_sys->timeout_event;
+	ulong		deadlock_detect_mode = LOCK_DEADLOCK_DETECT_EAGER;
 
 	ut_ad(!srv_read_only_mode);
 
@@ -557,6 +563,19 @@ DECLARE_THREAD(lock_wait_timeout_thread)(
 			}
 		}
 
+		/* Look for deadlocks once more after switching back to
+		EAGER, because the waits that started before were not
+		checked. */
+
+		if (srv_deadlock_detect_mode == LOCK_DEADLOCK_DETECT_BACKGROUND
+		    || deadlock_detect_mode
+		    == LOCK_DEADLOCK_DETECT_BACKGROUND) {
+
+			lock_deadlock_detect_background();
+		}
+
+		deadlock_detect_mode = srv_deadlock_detect_mode;
+
 		sig_count = os_event_reset(event);
 
 		lock_wait_mutex_exit();
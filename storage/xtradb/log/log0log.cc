@@ -250,6 +250,72 @@ log_check_tracking_margin(
 	return tracked_lsn_age + lsn_advance > log_sys->max_checkpoint_age;
 }
 
+#ifdef LOG_COPY_WITHOUT_MUTEX
+/******************************************************//**
+Waits until the mini-transactions counted in a slot of
+log_sys->n_pending_copies have copied their log records to the room that
+they reserved in log_reserve_and_write_fast(). */
+static
+void
+log_wait_for_slot(
+/*==============*/
+	ulint	slot)	/*!< in: slot of log_sys->n_pending_copies */
+{
+	/* Adding 0 reads the count with a full memory barrier, so that
+	the copied log records are visible when it is zero. */
+	for (ulint i = 0;
+	     os_atomic_increment_ulint(&log_sys->n_pending_copies[slot], 0);
+	     i++) {
+		if (i < srv_n_spin_wait_rounds) {
+			ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+		} else {
+			os_thread_yield();
+		}
+	}
+}
+#endif /* LOG_COPY_WITHOUT_MUTEX */
+
+/******************************************************//**
+Waits until the mini-transactions that reserved room in the log buffer in
+log_reserve_and_write_fast() have copied their log records there. This
+must be called before the log buffer is written or moved. The caller owns
+the log mutex. If release is true, the mutex may be released and acquired
+again while waiting, and the caller must not rely on the state of the log
+buffer that it saw before the call. */
+static
+void
+log_wait_for_copies(
+/*================*/
+	bool	release)	/*!< in: whether the log mutex may be
+				released while waiting */
+{
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+#ifdef LOG_COPY_WITHOUT_MUTEX
+	ulint	slot = log_sys->copy_slot;
+
+	if (release
+	    && log_sys->n_pending_copies[slot]
+	    && !log_sys->n_pending_copies[1 - slot]) {
+		/* Count the new reservations in the other slot, and
+		wait for the copies counted in this one without
+		blocking mtr_commit(). */
+		log_sys->copy_slot = 1 - slot;
+
+		mutex_exit(&(log_sys->mutex));
+
+		log_wait_for_slot(slot);
+
+		mutex_enter(&(log_sys->mutex));
+	}
+
+	/* No new room can be reserved now. The copies that are left were
+	started while the mutex was released, and they wait for nothing. */
+	log_wait_for_slot(0);
+	log_wait_for_slot(1);
+#endif /* LOG_COPY_WITHOUT_MUTEX */
+}
+
 /** Extends the log buffer.
 @param[in] len	requested minimum size in bytes */
 static
@@ -294,6 +360,8 @@ log_buffer_extend(
 		mutex_enter(&(log_sys->mutex));
 	}
 
+	log_wait_for_copies(false);
+
 	move_start = ut_calc_align_down(
 		log_sys->buf_free,
 		OS_FILE_LOG_BLOCK_SIZE);
@@ -953,6 +1021,10 @@ log_init(void)
 		     &log_sys->log_flush_order_mutex,
 		     SYNC_LOG_FLUSH_ORDER);
 
+	log_sys->n_pending_copies[0] = 0;
+	log_sys->n_pending_copies[1] = 0;
+	log_sys->copy_slot = 0;
+
 	mutex_enter(&(log_sys->mutex));
 
 	/* Start the lsn from one log block from zero: this way every
@@ -1249,6 +1321,8 @@ log_sys_check_flush_completion(void)
 			move_end = ut_calc_align(log_sys->buf_free,
 						 OS_FILE_LOG_BLOCK_SIZE);
 
+			log_wait_for_copies(false);
+
 			ut_memmove(log_sys->buf, log_sys->buf + move_start,
 				   move_end - move_start);
 			log_sys->buf_free -= move_start;
@@ -1699,6 +1773,10 @@ log_write_up_to(
 	os_event_reset(log_sys->no_flush_event);
 	os_event_reset(log_sys->one_flushed_event);
 
+	/* Other writers wait for n_pending_writes, so the log buffer is
+	not written or moved while the mutex is released here */
+	log_wait_for_copies(true);
+
 	start_offset = log_sys->buf_next_to_write;
 	end_offset = log_sys->buf_free;
 
@@ -174,6 +174,7 @@ UNIV_INTERN mysql_pfs_key_t	recv_sys_mutex_key;
 #ifndef UNIV_HOTBACKUP
 # ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t	recv_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	recv_apply_thread_key;
 # endif /* UNIV_PFS_THREAD */
 
 # ifdef UNIV_PFS_MUTEX
@@ -1908,48 +1909,26 @@ recv_read_in_area(
 }
 
 /*******************************************************************//**
-Empties the hash table of stored log records, applying them to appropriate
-pages. */
-UNIV_INTERN
+Applies the hashed log records of the pages in every step'th cell of the
+hash table, starting from the first'th. Pages in the buffer pool are
+recovered right away; other pages are read in asynchronously, together
+with their neighbours, and recovered by the i/o handler threads as the
+reads complete. The caller must own recv_sys->mutex. */
+static
 void
-recv_apply_hashed_log_recs(
-/*=======================*/
-	ibool	allow_ibuf)	/*!< in: if TRUE, also ibuf operations are
-				allowed during the application; if FALSE,
-				no ibuf operations are allowed, and after
-				the application all file pages are flushed to
-				disk and invalidated in buffer pool: this
-				alternative means that no new log records
-				can be generated during the application;
-				the caller must in this case own the log
-				mutex */
+recv_apply_hashed_log_recs_low(
+/*===========================*/
+	ulint	first,	/*!< in: first cell of the hash table */
+	ulint	step)	/*!< in: number of cells between two cells */
 {
 	recv_addr_t* recv_addr;
 	ulint	i;
-	ibool	has_printed	= FALSE;
 	mtr_t	mtr;
-loop:
-	mutex_enter(&(recv_sys->mutex));
-
-	if (recv_sys->apply_batch_on) {
-
-		mutex_exit(&(recv_sys->mutex));
-
-		os_thread_sleep(500000);
-
-		goto loop;
-	}
-
-	ut_ad(!allow_ibuf == mutex_own(&log_sys->mutex));
 
-	if (!allow_ibuf) {
-		recv_no_ibuf_operations = TRUE;
-	}
-
-	recv_sys->apply_log_recs = TRUE;
-	recv_sys->apply_batch_on = TRUE;
+	ut_ad(mutex_own(&recv_sys->mutex));
 
-	for (i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
+	for (i = first; i < hash_get_n_cells(recv_sys->addr_hash);
+	     i += step) {
 
 		for (recv_addr = static_cast<recv_addr_t*>(
 				HASH_GET_FIRST(recv_sys->addr_hash, i));
@@ -1962,16 +1941,6 @@ recv_apply_hashed_log_recs(
 			ulint	page_no = recv_addr->page_no;
 
 			if (recv_addr->state == RECV_NOT_PROCESSED) {
-				if (!has_printed) {
-					ib_logf(IB_LOG_LEVEL_INFO,
-						"Starting an apply batch"
-						" of log records"
-						" to the database...");
-					fputs("InnoDB: Progress in percent: ",
-					      stderr);
-					has_printed = TRUE;
-				}
-
 				mutex_exit(&(recv_sys->mutex));
 
 				if (buf_page_peek(space, page_no)) {
@@ -1995,32 +1964,152 @@ recv_apply_hashed_log_recs(
 				mutex_enter(&(recv_sys->mutex));
 			}
 		}
+	}
+}
+
+/** Arguments of recv_apply_thread() */
+struct recv_apply_arg_t {
+	ulint	first;	/*!< first cell of the hash table */
+	ulint	step;	/*!< number of apply threads */
+};
 
-		if (has_printed
-		    && (i * 100) / hash_get_n_cells(recv_sys->addr_hash)
-		    != ((i + 1) * 100)
-		    / hash_get_n_cells(recv_sys->addr_hash)) {
+/******************************************************************//**
+Thread applying the hashed log records of the pages in its share of the
+hash table cells. The records of one page are only ever applied by one
+thread, in lsn order, as recv_addr_t::state is changed under
+recv_sys->mutex.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(
+/*==============================*/
+	void*	arg)	/*!< in: recv_apply_arg_t */
+{
+	recv_apply_arg_t*	apply_arg = static_cast<recv_apply_arg_t*>(arg);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	mutex_enter(&(recv_sys->mutex));
+
+	recv_apply_hashed_log_recs_low(apply_arg->first, apply_arg->step);
+
+	ut_a(recv_sys->n_apply_threads);
+	recv_sys->n_apply_threads--;
+
+	mutex_exit(&(recv_sys->mutex));
 
-			fprintf(stderr, "%lu ", (ulong)
-				((i * 100)
-				 / hash_get_n_cells(recv_sys->addr_hash)));
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*******************************************************************//**
+Empties the hash table of stored log records, applying them to appropriate
+pages. The pages are divided between innodb_recovery_threads threads by
+their hash, see recv_apply_thread(). */
+UNIV_INTERN
+void
+recv_apply_hashed_log_recs(
+/*=======================*/
+	ibool	allow_ibuf)	/*!< in: if TRUE, also ibuf operations are
+				allowed during the application; if FALSE,
+				no ibuf operations are allowed, and after
+				the application all file pages are flushed to
+				disk and invalidated in buffer pool: this
+				alternative means that no new log records
+				can be generated during the application;
+				the caller must in this case own the log
+				mutex */
+{
+	recv_apply_arg_t*	apply_args = NULL;
+	ulint	n_threads;
+	ulint	n_pages;
+	ulint	n_percent = 0;
+	ulint	start_time;
+	ulint	i;
+	ibool	has_printed	= FALSE;
+loop:
+	mutex_enter(&(recv_sys->mutex));
+
+	if (recv_sys->apply_batch_on) {
+
+		mutex_exit(&(recv_sys->mutex));
+
+		os_thread_sleep(500000);
+
+		goto loop;
+	}
+
+	ut_ad(!allow_ibuf == mutex_own(&log_sys->mutex));
+
+	if (!allow_ibuf) {
+		recv_no_ibuf_operations = TRUE;
+	}
+
+	recv_sys->apply_log_recs = TRUE;
+	recv_sys->apply_batch_on = TRUE;
+
+	n_pages = recv_sys->n_addrs;
+	n_threads = ut_min(srv_n_recovery_threads,
+			   hash_get_n_cells(recv_sys->addr_hash));
+	start_time = ut_time_ms();
+
+	if (n_pages) {
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Starting an apply batch of log records"
+			" to the database (%lu pages, %lu threads)...",
+			(ulong) n_pages, (ulong) n_threads);
+		fputs("InnoDB: Progress in percent: ", stderr);
+		has_printed = TRUE;
+
+		apply_args = static_cast<recv_apply_arg_t*>(
+			mem_alloc(n_threads * sizeof(*apply_args)));
+
+		recv_sys->n_apply_threads = n_threads;
+
+		for (i = 0; i < n_threads; i++) {
+			apply_args[i].first = i;
+			apply_args[i].step = n_threads;
+			os_thread_create(recv_apply_thread, &apply_args[i],
+					 NULL);
 		}
 	}
 
 	/* Wait until all the pages have been processed */
 
-	while (recv_sys->n_addrs != 0) {
+	while (recv_sys->n_addrs != 0 || recv_sys->n_apply_threads != 0) {
+
+		ulint	percent = (n_pages - recv_sys->n_addrs) * 100
+			/ n_pages;
+
+		if (percent != n_percent) {
+			n_percent = percent;
+			fprintf(stderr, "%lu ", (ulong) percent);
+		}
 
 		mutex_exit(&(recv_sys->mutex));
 
-		os_thread_sleep(500000);
+		os_thread_sleep(100000);
 
 		mutex_enter(&(recv_sys->mutex));
 	}
 
 	if (has_printed) {
+		ulint	elapsed = ut_time_ms() - start_time;
 
 		fprintf(stderr, "\n");
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Applied log records to %lu pages in %lu.%03lu"
+			" seconds (%lu pages/s)",
+			(ulong) n_pages, (ulong) (elapsed / 1000),
+			(ulong) (elapsed % 1000),
+			(ulong) (n_pages * 1000 / ut_max(elapsed, 1)));
+		mem_free(apply_args);
 	}
 
 	if (!allow_ibuf) {
@@ -472,7 +472,7 @@ mlog_open_and_write_index(
 		ulint	i;
 		ulint	n	= dict_index_get_n_fields(index);
 		/* total size needed */
-		ulint	total	= 11 + size + (n + 2) * 2;
+		ulint	total	= 11 + size + (n + 3) * 2;
 		ulint	alloc	= total;
 		/* allocate at most DYN_ARRAY_DATA_SIZE at a time */
 		if (alloc > DYN_ARRAY_DATA_SIZE) {
@@ -485,11 +485,22 @@ mlog_open_and_write_index(
 		log_end = log_ptr + alloc;
 		log_ptr = mlog_write_initial_log_record_fast(rec, type,
 							     log_ptr, mtr);
-		mach_write_to_2(log_ptr, n);
+		if (dict_index_is_instant(index)) {
+			/* Flag the number of fields, so that the number
+			of fields in the records that were written before
+			columns were added instantly will follow. */
+			mach_write_to_2(log_ptr, n | 0x8000);
+		} else {
+			mach_write_to_2(log_ptr, n);
+		}
 		log_ptr += 2;
 		mach_write_to_2(log_ptr,
 				dict_index_get_n_unique_in_tree(index));
 		log_ptr += 2;
+		if (dict_index_is_instant(index)) {
+			mach_write_to_2(log_ptr, index->n_core_fields);
+			log_ptr += 2;
+		}
 		for (i = 0; i < n; i++) {
 			dict_field_t*		field;
 			const dict_col_t*	col;
@@ -550,6 +561,7 @@ mlog_parse_index(
 	dict_index_t**	index)	/*!< out, own: dummy index */
 {
 	ulint		i, n, n_uniq;
+	ulint		n_core	= 0;
 	dict_table_t*	table;
 	dict_index_t*	ind;
 
@@ -563,6 +575,17 @@ mlog_parse_index(
 		ptr += 2;
 		n_uniq = mach_read_from_2(ptr);
 		ptr += 2;
+		if (n & 0x8000) {
+			/* Columns were added instantly to the index. */
+			n &= 0x7fff;
+			if (end_ptr < ptr + 2) {
+				return(NULL);
+			}
+			n_core = mach_read_from_2(ptr);
+			ptr += 2;
+			ut_ad(n_core > n_uniq);
+			ut_ad(n_core < n);
+		}
 		ut_ad(n_uniq <= n);
 		if (end_ptr < ptr + n * 2) {
 			return(NULL);
@@ -612,6 +635,12 @@ mlog_parse_index(
 			ind->fields[DATA_ROLL_PTR - 1 + n_uniq].col
 				= &table->cols[n + DATA_ROLL_PTR];
 		}
+		if (n_core) {
+			ind->n_core_fields = (unsigned int) n_core;
+			ind->n_core_null_bytes = (unsigned int)
+				UT_BITS_IN_BYTES(
+					dict_index_get_n_nullable(ind, n_core));
+		}
 	}
 	/* avoid ut_ad(index->cached) in dict_index_get_n_unique_in_tree */
 	ind->cached = TRUE;
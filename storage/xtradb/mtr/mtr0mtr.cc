@@ -203,7 +203,11 @@ static
 void
 mtr_add_dirtied_pages_to_flush_list(
 /*================================*/
-	mtr_t*	mtr)	/*!< in/out: mtr */
+	mtr_t*	mtr,	/*!< in/out: mtr */
+	byte*	copy_to,/*!< in: where log_reserve_and_write_fast()
+			reserved room for the mtr log, or NULL */
+	ulint	copy_slot)/*!< in: slot of log_sys->n_pending_copies
+			that counts the copy, if copy_to != NULL */
 {
 	ut_ad(!srv_read_only_mode);
 
@@ -228,6 +232,18 @@ mtr_add_dirtied_pages_to_flush_list(
 	if (mtr->made_dirty) {
 		log_flush_order_mutex_exit();
 	}
+
+	if (copy_to) {
+		/* The copy does not need log_flush_order_mutex: the
+		pages stay latched by this mtr, and log_sys->buf cannot be
+		written past the reserved room until the copy is done. */
+		DEBUG_SYNC_C("mtr_log_copy_reserved");
+
+		/* The mtr log fits in a single dyn block on this path */
+		log_write_reserved(copy_to, copy_slot,
+				   dyn_block_get_data(&mtr->log),
+				   dyn_block_get_used(&mtr->log));
+	}
 }
 
 /************************************************************//**
@@ -257,18 +273,23 @@ mtr_log_reserve_and_write(
 
 	if (mlog->heap == NULL) {
 		ulint	len;
+		byte*	copy_to;
+		ulint	copy_slot = 0;
 
 		len = mtr->log_mode != MTR_LOG_NO_REDO
 			? dyn_block_get_used(mlog) : 0;
 
 		mtr->end_lsn = log_reserve_and_write_fast(
-			first_data, len, &mtr->start_lsn);
+			first_data, len, &mtr->start_lsn,
+			&copy_to, &copy_slot);
 
 		if (mtr->end_lsn) {
 
 			/* Success. We have the log mutex.
-			Add pages to flush list and exit */
-			mtr_add_dirtied_pages_to_flush_list(mtr);
+			Add pages to flush list, copy the log
+			to the reserved room and exit */
+			mtr_add_dirtied_pages_to_flush_list(
+				mtr, copy_to, copy_slot);
 
 			return;
 		}
@@ -300,7 +321,7 @@ mtr_log_reserve_and_write(
 
 	mtr->end_lsn = log_close();
 
-	mtr_add_dirtied_pages_to_flush_list(mtr);
+	mtr_add_dirtied_pages_to_flush_list(mtr, NULL, 0);
 }
 #endif /* !UNIV_HOTBACKUP */
 
@@ -1064,8 +1064,10 @@ page_cur_insert_rec_low(
 #ifdef UNIV_DEBUG
 		if (page_is_comp(page)) {
 			ut_ad(rec_get_status(current_rec)
-				<= REC_STATUS_INFIMUM);
-			ut_ad(rec_get_status(insert_rec) < REC_STATUS_INFIMUM);
+			      != REC_STATUS_SUPREMUM);
+			ut_ad(rec_get_status(insert_rec) != REC_STATUS_INFIMUM);
+			ut_ad(rec_get_status(insert_rec)
+			      != REC_STATUS_SUPREMUM);
 			ut_ad(rec_get_status(next_rec) != REC_STATUS_INFIMUM);
 		}
 #endif
@@ -1541,8 +1543,9 @@ page_cur_insert_rec_zip(
 		const rec_t*	next_rec = page_rec_get_next_low(
 			cursor->rec, TRUE);
 		ut_ad(rec_get_status(cursor->rec)
-		      <= REC_STATUS_INFIMUM);
-		ut_ad(rec_get_status(insert_rec) < REC_STATUS_INFIMUM);
+		      != REC_STATUS_SUPREMUM);
+		ut_ad(rec_get_status(insert_rec) != REC_STATUS_INFIMUM);
+		ut_ad(rec_get_status(insert_rec) != REC_STATUS_SUPREMUM);
 		ut_ad(rec_get_status(next_rec) != REC_STATUS_INFIMUM);
 
 		page_rec_set_next(insert_rec, next_rec);
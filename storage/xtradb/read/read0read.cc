@@ -193,6 +193,7 @@ read_view_create_low(
 					  sizeof(read_view_t));
 		view->max_descr = 0;
 		view->descriptors = NULL;
+		view->descr_version = ULINT_UNDEFINED;
 	}
 
 	if (UNIV_UNLIKELY(view->max_descr < n)) {
@@ -244,6 +245,7 @@ read_view_clone(
 
 	clone->descriptors = old_descriptors;
 	clone->max_descr = old_max_descr;
+	clone->descr_version = ULINT_UNDEFINED;
 
 	if (view->n_descr) {
 		memcpy(clone->descriptors, view->descriptors,
@@ -285,6 +287,56 @@ read_view_add(
 	ut_ad(read_view_list_validate());
 }
 
+/*********************************************************************//**
+Sets the limits of a read view whose descriptors array has been filled in
+with the transactions active now, and adds it to trx_sys->view_list. */
+static
+void
+read_view_open_finish(
+/*==================*/
+	trx_id_t	cr_trx_id,	/*!< in: trx_id of creating
+					transaction, or 0 used in purge */
+	read_view_t*	view)		/*!< in/out: read view */
+{
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+	view->undo_no = 0;
+	view->type = VIEW_NORMAL;
+	view->creator_trx_id = cr_trx_id;
+
+	/* No future transactions should be visible in the view */
+
+	view->low_limit_no = trx_sys->max_trx_id;
+	view->low_limit_id = view->low_limit_no;
+
+	/* NOTE that a transaction whose trx number is < trx_sys->max_trx_id can
+	still be active, if it is in the middle of its commit! Note that when a
+	transaction starts, we initialize trx->no to TRX_ID_MAX. */
+
+	if (UT_LIST_GET_LEN(trx_sys->trx_serial_list) > 0) {
+
+		trx_id_t	trx_no;
+
+		trx_no = UT_LIST_GET_FIRST(trx_sys->trx_serial_list)->no;
+
+		if (trx_no < view->low_limit_no) {
+			view->low_limit_no = trx_no;
+		}
+	}
+
+	if (UNIV_LIKELY(view->n_descr > 0)) {
+		/* The last active transaction has the smallest id: */
+		view->up_limit_id = view->descriptors[0];
+	} else {
+		view->up_limit_id = view->low_limit_id;
+	}
+
+	/* Purge views are not added to the view list. */
+	if (cr_trx_id > 0) {
+		read_view_add(view);
+	}
+}
+
 /*********************************************************************//**
 Opens a read view where exactly the transactions serialized before this
 point in time are seen in the view.
@@ -305,15 +357,6 @@ read_view_open_now_low(
 
 	view = read_view_create_low(trx_sys->descr_n_used, view);
 
-	view->undo_no = 0;
-	view->type = VIEW_NORMAL;
-	view->creator_trx_id = cr_trx_id;
-
-	/* No future transactions should be visible in the view */
-
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
-
 	descr = trx_find_descriptor(trx_sys->descriptors,
 				    trx_sys->descr_n_used,
 				    cr_trx_id);
@@ -342,39 +385,84 @@ read_view_open_now_low(
 		       sizeof(trx_id_t));
  	}
 
-	/* NOTE that a transaction whose trx number is < trx_sys->max_trx_id can
-	still be active, if it is in the middle of its commit! Note that when a
-	transaction starts, we initialize trx->no to TRX_ID_MAX. */
+	view->descr_version = trx_sys->descr_version;
 
-	if (UT_LIST_GET_LEN(trx_sys->trx_serial_list) > 0) {
+	read_view_open_finish(cr_trx_id, view);
 
-		trx_id_t	trx_no;
+	return(view);
+}
 
-		trx_no = UT_LIST_GET_FIRST(trx_sys->trx_serial_list)->no;
+#ifdef HAVE_ATOMIC_LOAD_STORE
+/*********************************************************************//**
+Fills in the descriptors array of a read view without holding
+trx_sys->mutex, unless the view already holds the same transactions. The
+array may change while it is being copied: the caller must check under
+the mutex that trx_sys->descr_version still is the returned value.
+@return	trx_sys->descr_version before the copy */
+static
+ulint
+read_view_copy_descriptors(
+/*=======================*/
+	trx_id_t	cr_trx_id,	/*!< in: trx_id of creating
+					transaction */
+	read_view_t*&	view)		/*!< in,out: pre-allocated view array or
+					NULL if a new one needs to be created */
+{
+	ulint		version;
+	ulint		n_used;
+	const trx_id_t*	descriptors;
+	trx_id_t*	descr;
 
-		if (trx_no < view->low_limit_no) {
-			view->low_limit_no = trx_no;
-		}
-	}
+	ut_ad(!mutex_own(&trx_sys->mutex));
 
-	if (UNIV_LIKELY(view->n_descr > 0)) {
-		/* The last active transaction has the smallest id: */
-		view->up_limit_id = view->descriptors[0];
-	} else {
-		view->up_limit_id = view->low_limit_id;
+	/* A growing array is published before the number of its used
+	elements, so descriptors has room for n_used elements. */
+
+	version = os_atomic_load_acquire(&trx_sys->descr_version);
+	n_used = os_atomic_load_acquire(&trx_sys->descr_n_used);
+	descriptors = os_atomic_load_acquire(&trx_sys->descriptors);
+
+	/* If no transaction has started or committed since the view was
+	last opened, it already holds the transactions active now. */
+
+	if (view != NULL
+	    && view->descr_version == version
+	    && (view->creator_trx_id == cr_trx_id
+		|| (view->n_descr == n_used
+		    && trx_find_descriptor(view->descriptors, view->n_descr,
+					   cr_trx_id) == NULL))) {
+
+		srv_stats.n_read_views_reused.inc();
+
+		return(version);
 	}
 
-	/* Purge views are not added to the view list. */
-	if (cr_trx_id > 0) {
-		read_view_add(view);
+	view = read_view_create_low(n_used, view);
+
+	memcpy(view->descriptors, descriptors, n_used * sizeof(trx_id_t));
+
+	descr = trx_find_descriptor(view->descriptors, n_used, cr_trx_id);
+
+	if (descr != NULL) {
+		/* The view does not need to see the creating transaction */
+		ut_memmove(descr, descr + 1,
+			   (view->descriptors + n_used - 1 - descr)
+			   * sizeof(trx_id_t));
+		view->n_descr--;
 	}
 
-	return(view);
+	view->descr_version = version;
+
+	return(version);
 }
+#endif /* HAVE_ATOMIC_LOAD_STORE */
 
 /*********************************************************************//**
 Opens a read view where exactly the transactions serialized before this
-point in time are seen in the view.
+point in time are seen in the view. The active transactions are copied
+before acquiring trx_sys->mutex, so that the mutex is held only for
+setting the limits of the view and adding it to trx_sys->view_list, unless
+a transaction started or committed during the copy.
 @return	own: read view struct */
 UNIV_INTERN
 read_view_t*
@@ -385,9 +473,26 @@ read_view_open_now(
 	read_view_t*&	view)		/*!< in,out: pre-allocated view array or
 					NULL if a new one needs to be created */
 {
+#ifdef HAVE_ATOMIC_LOAD_STORE
+	ulint	version = read_view_copy_descriptors(cr_trx_id, view);
+
+	mutex_enter(&trx_sys->mutex);
+
+	if (UNIV_LIKELY(trx_sys->descr_version == version)) {
+		/* The copy is the same as if it was made now. Purge
+		can't have missed the view, because it only gets the
+		limits of the view below. */
+		read_view_open_finish(cr_trx_id, view);
+	} else {
+		srv_stats.n_read_views_recopied.inc();
+
+		view = read_view_open_now_low(cr_trx_id, view);
+	}
+#else
 	mutex_enter(&trx_sys->mutex);
 
 	view = read_view_open_now_low(cr_trx_id, view);
+#endif /* HAVE_ATOMIC_LOAD_STORE */
 
 	mutex_exit(&trx_sys->mutex);
 
@@ -466,6 +571,7 @@ read_view_purge_open(
 	}
 
 	view->creator_trx_id = 0;
+	view->descr_version = ULINT_UNDEFINED;
 
 	view->low_limit_no = oldest_view->low_limit_no;
 	view->low_limit_id = oldest_view->low_limit_id;
@@ -940,8 +940,8 @@ cmp_rec_rec_simple_field(
 	ut_ad(!rec_offs_nth_extern(offsets1, n));
 	ut_ad(!rec_offs_nth_extern(offsets2, n));
 
-	rec1_b_ptr = rec_get_nth_field(rec1, offsets1, n, &rec1_f_len);
-	rec2_b_ptr = rec_get_nth_field(rec2, offsets2, n, &rec2_f_len);
+	rec1_b_ptr = rec_get_nth_cfield(rec1, index, offsets1, n, &rec1_f_len);
+	rec2_b_ptr = rec_get_nth_cfield(rec2, index, offsets2, n, &rec2_f_len);
 
 	if (rec1_f_len == UNIV_SQL_NULL || rec2_f_len == UNIV_SQL_NULL) {
 		if (rec1_f_len == rec2_f_len) {
@@ -1066,9 +1066,12 @@ cmp_rec_rec_simple(
 	/* If we ran out of fields, the ordering columns of rec1 were
 	equal to rec2. Issue a duplicate key error if needed. */
 
-	if (!null_eq && table && dict_index_is_unique(index)) {
-		/* Report erroneous row using new version of table. */
-		innobase_rec_to_mysql(table, rec1, index, offsets1);
+	if (!null_eq && dict_index_is_unique(index)) {
+		if (table) {
+			/* Report erroneous row using new version
+			of table. */
+			innobase_rec_to_mysql(table, rec1, index, offsets1);
+		}
 		return(0);
 	}
 
@@ -1170,10 +1173,10 @@ cmp_rec_rec_with_match(
 			prtype = col->prtype;
 		}
 
-		rec1_b_ptr = rec_get_nth_field(rec1, offsets1,
-					       cur_field, &rec1_f_len);
-		rec2_b_ptr = rec_get_nth_field(rec2, offsets2,
-					       cur_field, &rec2_f_len);
+		rec1_b_ptr = rec_get_nth_cfield(rec1, index, offsets1,
+						cur_field, &rec1_f_len);
+		rec2_b_ptr = rec_get_nth_cfield(rec2, index, offsets2,
+						cur_field, &rec2_f_len);
 
 		if (cur_bytes == 0) {
 			if (cur_field == 0) {
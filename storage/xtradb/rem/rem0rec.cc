@@ -94,6 +94,9 @@ represented on a higher text line):
 ...
 | length of first variable-length field of data |
 | SQL-null flags (1 bit per nullable field), padded to full bytes |
+| only if the record type is 100: the number of fields in excess of
+  dict_index_t::n_core_fields, 0xxxxxxx (one byte, 0..127) or
+  1xxxxxxx xxxxxxxx (two bytes, least significant bits first) |
 | 4 bits used to delete mark a record, and mark a predefined
   minimum record in alphabetical order |
 | 4 bits giving the number of records owned by this record
@@ -101,7 +104,8 @@ represented on a higher text line):
 | 13 bits giving the order number of this record in the
   heap of the index page |
 | 3 bits record type: 000=conventional, 001=node pointer (inside B-tree),
-  010=infimum, 011=supremum, 1xx=reserved |
+  010=infimum, 011=supremum, 100=conventional with columns added
+  instantly, 101..111=reserved |
 | two bytes giving a relative pointer to the next record in the page |
 ORIGIN of the record
 | first field of data |
@@ -158,6 +162,105 @@ rec_validate_old(
 /*=============*/
 	const rec_t*	rec);	/*!< in: physical record */
 
+/******************************************************//**
+Gets the size of the field count of a record in
+REC_STATUS_COLUMNS_ADDED.
+@return	1 or 2 bytes */
+UNIV_INLINE
+ulint
+rec_get_n_add_field_size(
+/*=====================*/
+	ulint	n_add)	/*!< in: number of fields in excess of
+			dict_index_t::n_core_fields */
+{
+	ut_ad(n_add < REC_MAX_N_FIELDS);
+	return(n_add < 0x80 ? 1 : 2);
+}
+
+/******************************************************//**
+Reads the field count of a record in REC_STATUS_COLUMNS_ADDED.
+@return	number of fields in excess of dict_index_t::n_core_fields */
+UNIV_INLINE
+ulint
+rec_get_n_add_field(
+/*================*/
+	const byte**	header)	/*!< in/out: the byte before the record
+				header; out: the byte before the
+				field count */
+{
+	ulint	n_add = *(*header)--;
+
+	if (n_add & 0x80) {
+		n_add &= 0x7f;
+		n_add |= ulint(*(*header)--) << 7;
+	}
+
+	return(n_add);
+}
+
+/******************************************************//**
+Writes the field count of a record in REC_STATUS_COLUMNS_ADDED. */
+UNIV_INLINE
+void
+rec_set_n_add_field(
+/*================*/
+	byte**	header,	/*!< in/out: the byte before the record
+			header; out: the byte before the
+			field count */
+	ulint	n_add)	/*!< in: number of fields in excess of
+			dict_index_t::n_core_fields */
+{
+	ut_ad(n_add < REC_MAX_N_FIELDS);
+
+	if (n_add < 0x80) {
+		*(*header)-- = (byte) n_add;
+	} else {
+		*(*header)-- = (byte) (n_add | 0x80);
+		*(*header)-- = (byte) (n_add >> 7);
+	}
+}
+
+/******************************************************//**
+Determines the null flags and the number of stored fields of a
+leaf page record in ROW_FORMAT=COMPACT.
+@return	number of fields that are stored in the record */
+UNIV_INLINE
+ulint
+rec_get_n_stored_comp(
+/*==================*/
+	const rec_t*		rec,	/*!< in: leaf page record */
+	const dict_index_t*	index,	/*!< in: record descriptor */
+	const byte**		nulls,	/*!< out: the last byte of
+					the null flags */
+	ulint*			n_null_bytes)/*!< out: size of the
+					null flags */
+{
+	ulint	n_stored;
+
+	*nulls = rec - (REC_N_NEW_EXTRA_BYTES + 1);
+
+	if (!dict_index_is_instant(index)) {
+		ut_ad(rec_get_status(rec) == REC_STATUS_ORDINARY);
+		*n_null_bytes = UT_BITS_IN_BYTES(index->n_nullable);
+		return(dict_index_get_n_fields(index));
+	}
+
+	switch (rec_get_status(rec)) {
+	case REC_STATUS_ORDINARY:
+		*n_null_bytes = index->n_core_null_bytes;
+		return(index->n_core_fields);
+	case REC_STATUS_COLUMNS_ADDED:
+		n_stored = index->n_core_fields + rec_get_n_add_field(nulls);
+		ut_ad(n_stored <= dict_index_get_n_fields(index));
+		*n_null_bytes = UT_BITS_IN_BYTES(
+			dict_index_get_n_nullable(index, n_stored));
+		return(n_stored);
+	}
+
+	ut_error;
+	return(0);
+}
+
 /******************************************************//**
 Determine how many of the first n columns in a compact
 physical record are stored externally.
@@ -179,6 +282,8 @@ rec_get_n_extern_new(
 	ut_ad(dict_table_is_comp(index->table));
 	ut_ad(rec_get_status(rec) == REC_STATUS_ORDINARY);
 	ut_ad(n == ULINT_UNDEFINED || n <= dict_index_get_n_fields(index));
+	/* Columns cannot be added instantly to ROW_FORMAT=COMPRESSED */
+	ut_ad(!dict_index_is_instant(index));
 
 	if (n == ULINT_UNDEFINED) {
 		n = dict_index_get_n_fields(index);
@@ -260,13 +365,26 @@ rec_init_offsets_comp_ordinary(
 	ulint		i		= 0;
 	ulint		offs		= 0;
 	ulint		any_ext		= 0;
+	ulint		any_def		= 0;
 	ulint		n_null		= index->n_nullable;
-	const byte*	nulls		= temp
-		? rec - 1
-		: rec - (1 + REC_N_NEW_EXTRA_BYTES);
-	const byte*	lens		= nulls - UT_BITS_IN_BYTES(n_null);
+	ulint		n_stored;
+	ulint		n_null_bytes;
+	const byte*	nulls;
+	const byte*	lens;
 	ulint		null_mask	= 1;
 
+	if (temp) {
+		/* Temporary files always contain all fields. */
+		nulls = rec - 1;
+		n_null_bytes = UT_BITS_IN_BYTES(n_null);
+		n_stored = ULINT_UNDEFINED;
+	} else {
+		n_stored = rec_get_n_stored_comp(
+			rec, index, &nulls, &n_null_bytes);
+	}
+
+	lens = nulls - n_null_bytes;
+
 #ifdef UNIV_DEBUG
 	/* We cannot invoke rec_offs_make_valid() here if temp=true.
 	Similarly, rec_offs_validate() will fail in that case, because
@@ -291,6 +409,17 @@ rec_init_offsets_comp_ordinary(
 			= dict_field_get_col(field);
 		ulint			len;
 
+		if (UNIV_UNLIKELY(i >= n_stored)) {
+			/* The column was added instantly after the
+			record was written. No data is stored. */
+			any_def = REC_OFFS_DEFAULT;
+			len = offs | REC_OFFS_DEFAULT;
+			if (col->def_val_len == UNIV_SQL_NULL) {
+				len |= REC_OFFS_SQL_NULL;
+			}
+			goto resolved;
+		}
+
 		if (!(col->prtype & DATA_NOT_NULL)) {
 			/* nullable field => read the null flag */
 			ut_ad(n_null--);
@@ -356,7 +485,7 @@ rec_init_offsets_comp_ordinary(
 	} while (++i < rec_offs_n_fields(offsets));
 
 	*rec_offs_base(offsets)
-		= (rec - (lens + 1)) | REC_OFFS_COMPACT | any_ext;
+		= (rec - (lens + 1)) | REC_OFFS_COMPACT | any_ext | any_def;
 }
 
 /******************************************************//**
@@ -408,13 +537,14 @@ rec_init_offsets(
 				= dict_index_get_n_unique_in_tree(index);
 			break;
 		case REC_STATUS_ORDINARY:
+		case REC_STATUS_COLUMNS_ADDED:
 			rec_init_offsets_comp_ordinary(
 				rec, false, index, offsets);
 			return;
 		}
 
 		nulls = rec - (REC_N_NEW_EXTRA_BYTES + 1);
-		lens = nulls - UT_BITS_IN_BYTES(index->n_nullable);
+		lens = nulls - dict_index_get_n_core_null_bytes(index);
 		offs = 0;
 		null_mask = 1;
 
@@ -495,9 +625,12 @@ rec_init_offsets(
 			= (rec - (lens + 1)) | REC_OFFS_COMPACT;
 	} else {
 		/* Old-style record: determine extra size and end offsets */
+		ulint	n_stored = ut_min(rec_get_n_fields_old(rec),
+					  rec_offs_n_fields(offsets));
+
 		offs = REC_N_OLD_EXTRA_BYTES;
 		if (rec_get_1byte_offs_flag(rec)) {
-			offs += rec_offs_n_fields(offsets);
+			offs += n_stored;
 			*rec_offs_base(offsets) = offs;
 			/* Determine offsets to fields */
 			do {
@@ -507,9 +640,9 @@ rec_init_offsets(
 					offs |= REC_OFFS_SQL_NULL;
 				}
 				rec_offs_base(offsets)[1 + i] = offs;
-			} while (++i < rec_offs_n_fields(offsets));
+			} while (++i < n_stored);
 		} else {
-			offs += 2 * rec_offs_n_fields(offsets);
+			offs += 2 * n_stored;
 			*rec_offs_base(offsets) = offs;
 			/* Determine offsets to fields */
 			do {
@@ -524,6 +657,23 @@ rec_init_offsets(
 					*rec_offs_base(offsets) |= REC_OFFS_EXTERNAL;
 				}
 				rec_offs_base(offsets)[1 + i] = offs;
+			} while (++i < n_stored);
+		}
+
+		if (i < rec_offs_n_fields(offsets)) {
+			/* The columns were added instantly after the
+			record was written. No data is stored. */
+			offs &= REC_OFFS_MASK;
+			*rec_offs_base(offsets) |= REC_OFFS_DEFAULT;
+
+			do {
+				const dict_col_t*	col
+					= dict_index_get_nth_col(index, i);
+
+				rec_offs_base(offsets)[1 + i]
+					= offs | REC_OFFS_DEFAULT
+					| (col->def_val_len == UNIV_SQL_NULL
+					   ? REC_OFFS_SQL_NULL : 0);
 			} while (++i < rec_offs_n_fields(offsets));
 		}
 	}
@@ -563,6 +713,7 @@ rec_get_offsets_func(
 		switch (UNIV_EXPECT(rec_get_status(rec),
 				    REC_STATUS_ORDINARY)) {
 		case REC_STATUS_ORDINARY:
+		case REC_STATUS_COLUMNS_ADDED:
 			n = dict_index_get_n_fields(index);
 			break;
 		case REC_STATUS_NODE_PTR:
@@ -582,6 +733,15 @@ rec_get_offsets_func(
 		}
 	} else {
 		n = rec_get_n_fields_old(rec);
+
+		if (dict_index_is_instant(index)
+		    && n >= index->n_core_fields) {
+			/* A leaf page record that was written before
+			columns were added instantly lacks those fields.
+			Node pointer records contain fewer fields than
+			dict_index_t::n_core_fields. */
+			n = dict_index_get_n_fields(index);
+		}
 	}
 
 	if (UNIV_UNLIKELY(n_fields < n)) {
@@ -640,6 +800,8 @@ rec_get_offsets_reverse(
 	ut_ad(index);
 	ut_ad(offsets);
 	ut_ad(dict_table_is_comp(index->table));
+	/* Columns cannot be added instantly to ROW_FORMAT=COMPRESSED */
+	ut_ad(!dict_index_is_instant(index));
 
 	if (UNIV_UNLIKELY(node_ptr)) {
 		n_node_ptr_field = dict_index_get_n_unique_in_tree(index);
@@ -799,6 +961,8 @@ rec_get_converted_size_comp_prefix_low(
 	const dfield_t*		fields,	/*!< in: array of data fields */
 	ulint			n_fields,/*!< in: number of data fields */
 	ulint*			extra,	/*!< out: extra size */
+	ulint			status,	/*!< in: status bits of the record,
+					ignored if temp */
 	bool			temp)	/*!< in: whether this is a
 					temporary file record */
 {
@@ -810,10 +974,20 @@ rec_get_converted_size_comp_prefix_low(
 	ut_ad(n_fields <= dict_index_get_n_fields(index));
 	ut_ad(!temp || extra);
 
-	extra_size = temp
-		? UT_BITS_IN_BYTES(n_null)
-		: REC_N_NEW_EXTRA_BYTES
-		+ UT_BITS_IN_BYTES(n_null);
+	if (temp) {
+		extra_size = UT_BITS_IN_BYTES(n_null);
+	} else if (status == REC_STATUS_COLUMNS_ADDED) {
+		ut_ad(n_fields >= index->n_core_fields);
+		extra_size = REC_N_NEW_EXTRA_BYTES
+			+ rec_get_n_add_field_size(
+				n_fields - index->n_core_fields)
+			+ UT_BITS_IN_BYTES(
+				dict_index_get_n_nullable(index, n_fields));
+	} else {
+		extra_size = REC_N_NEW_EXTRA_BYTES
+			+ dict_index_get_n_core_null_bytes(index);
+	}
+
 	data_size = 0;
 
 	if (temp && dict_table_is_comp(index->table)) {
@@ -911,7 +1085,8 @@ rec_get_converted_size_comp_prefix(
 {
 	ut_ad(dict_table_is_comp(index->table));
 	return(rec_get_converted_size_comp_prefix_low(
-		       index, fields, n_fields, extra, false));
+		       index, fields, n_fields, extra,
+		       REC_STATUS_NODE_PTR, false));
 }
 
 /**********************************************************//**
@@ -935,6 +1110,13 @@ rec_get_converted_size_comp(
 
 	switch (UNIV_EXPECT(status, REC_STATUS_ORDINARY)) {
 	case REC_STATUS_ORDINARY:
+		if (dict_index_is_instant(index)) {
+			/* Leaf page records are always written with
+			all fields, after columns were added instantly. */
+			status = REC_STATUS_COLUMNS_ADDED;
+		}
+		/* fall through */
+	case REC_STATUS_COLUMNS_ADDED:
 		ut_ad(n_fields == dict_index_get_n_fields(index));
 		size = 0;
 		break;
@@ -957,7 +1139,7 @@ rec_get_converted_size_comp(
 	}
 
 	return(size + rec_get_converted_size_comp_prefix_low(
-		       index, fields, n_fields, extra, false));
+		       index, fields, n_fields, extra, status, false));
 }
 
 /***********************************************************//**
@@ -1158,15 +1340,19 @@ rec_convert_dtuple_to_rec_comp(
 	ulint		fixed_len;
 	ulint		null_mask	= 1;
 	ulint		n_null;
+	ulint		n_null_bytes;
 
 	ut_ad(temp || dict_table_is_comp(index->table));
 	ut_ad(n_fields > 0);
 
+	n_null = index->n_nullable;
+
 	if (temp) {
 		ut_ad(status == REC_STATUS_ORDINARY);
 		ut_ad(n_fields <= dict_index_get_n_fields(index));
 		n_node_ptr_field = ULINT_UNDEFINED;
 		nulls = rec - 1;
+		n_null_bytes = UT_BITS_IN_BYTES(n_null);
 		if (dict_table_is_comp(index->table)) {
 			/* No need to do adjust fixed_len=0. We only
 			need to adjust it for ROW_FORMAT=REDUNDANT. */
@@ -1174,10 +1360,21 @@ rec_convert_dtuple_to_rec_comp(
 		}
 	} else {
 		nulls = rec - (REC_N_NEW_EXTRA_BYTES + 1);
+		n_null_bytes = dict_index_get_n_core_null_bytes(index);
 
 		switch (UNIV_EXPECT(status, REC_STATUS_ORDINARY)) {
 		case REC_STATUS_ORDINARY:
 			ut_ad(n_fields <= dict_index_get_n_fields(index));
+			ut_ad(!dict_index_is_instant(index));
+			n_node_ptr_field = ULINT_UNDEFINED;
+			break;
+		case REC_STATUS_COLUMNS_ADDED:
+			ut_ad(n_fields >= index->n_core_fields);
+			ut_ad(n_fields <= dict_index_get_n_fields(index));
+			rec_set_n_add_field(&nulls,
+					    n_fields - index->n_core_fields);
+			n_null_bytes = UT_BITS_IN_BYTES(
+				dict_index_get_n_nullable(index, n_fields));
 			n_node_ptr_field = ULINT_UNDEFINED;
 			break;
 		case REC_STATUS_NODE_PTR:
@@ -1197,8 +1394,7 @@ rec_convert_dtuple_to_rec_comp(
 	}
 
 	end = rec;
-	n_null = index->n_nullable;
-	lens = nulls - UT_BITS_IN_BYTES(n_null);
+	lens = nulls - n_null_bytes;
 	/* clear the SQL-null flags */
 	memset(lens + 1, 0, nulls - lens);
 
@@ -1313,6 +1509,13 @@ rec_convert_dtuple_to_rec_new(
 	rec_t*	rec;
 
 	status = dtuple_get_info_bits(dtuple) & REC_NEW_STATUS_MASK;
+
+	if (status == REC_STATUS_ORDINARY && dict_index_is_instant(index)) {
+		/* Leaf page records are always written with all
+		fields, after columns were added instantly. */
+		status = REC_STATUS_COLUMNS_ADDED;
+	}
+
 	rec_get_converted_size_comp(
 		index, status, dtuple->fields, dtuple->n_fields, &extra_size);
 	rec = buf + extra_size;
@@ -1321,7 +1524,9 @@ rec_convert_dtuple_to_rec_new(
 		rec, index, dtuple->fields, dtuple->n_fields, status, false);
 
 	/* Set the info bits of the record */
-	rec_set_info_and_status_bits(rec, dtuple_get_info_bits(dtuple));
+	rec_set_info_and_status_bits(
+		rec, (dtuple_get_info_bits(dtuple) & ~REC_NEW_STATUS_MASK)
+		| status);
 
 	return(rec);
 }
@@ -1394,7 +1599,8 @@ rec_get_converted_size_temp(
 	ulint*			extra)	/*!< out: extra size */
 {
 	return(rec_get_converted_size_comp_prefix_low(
-		       index, fields, n_fields, extra, true));
+		       index, fields, n_fields, extra,
+		       REC_STATUS_ORDINARY, true));
 }
 
 /******************************************************//**
@@ -1539,6 +1745,7 @@ rec_copy_prefix_to_buf(
 	ulint		i;
 	ulint		prefix_len;
 	ulint		null_mask;
+	ulint		n_null_bytes;
 	ulint		status;
 
 	UNIV_PREFETCH_RW(*buf);
@@ -1555,11 +1762,17 @@ rec_copy_prefix_to_buf(
 
 	switch (status) {
 	case REC_STATUS_ORDINARY:
-		ut_ad(n_fields <= dict_index_get_n_fields(index));
+	case REC_STATUS_COLUMNS_ADDED:
+		/* The prefix may not contain fields that were added
+		instantly after the record was written. */
+		ut_a(n_fields <= rec_get_n_stored_comp(
+			     rec, index, &nulls, &n_null_bytes));
 		break;
 	case REC_STATUS_NODE_PTR:
 		/* it doesn't make sense to copy the child page number field */
 		ut_ad(n_fields <= dict_index_get_n_unique_in_tree(index));
+		nulls = rec - (REC_N_NEW_EXTRA_BYTES + 1);
+		n_null_bytes = dict_index_get_n_core_null_bytes(index);
 		break;
 	case REC_STATUS_INFIMUM:
 	case REC_STATUS_SUPREMUM:
@@ -1569,8 +1782,7 @@ rec_copy_prefix_to_buf(
 		return(NULL);
 	}
 
-	nulls = rec - (REC_N_NEW_EXTRA_BYTES + 1);
-	lens = nulls - UT_BITS_IN_BYTES(index->n_nullable);
+	lens = nulls - n_null_bytes;
 	UNIV_PREFETCH_R(lens);
 	prefix_len = 0;
 	null_mask = 1;
@@ -1726,9 +1938,15 @@ rec_validate(
 		return(FALSE);
 	}
 
-	ut_a(rec_offs_comp(offsets) || n_fields <= rec_get_n_fields_old(rec));
+	ut_a(rec_offs_comp(offsets) || rec_offs_any_default(offsets)
+	     || n_fields <= rec_get_n_fields_old(rec));
 
 	for (i = 0; i < n_fields; i++) {
+		if (rec_offs_nth_default(offsets, i)) {
+			/* The field is not stored in the record. */
+			continue;
+		}
+
 		data = rec_get_nth_field(rec, offsets, i, &len);
 
 		if (!((len < UNIV_PAGE_SIZE) || (len == UNIV_SQL_NULL))) {
@@ -1841,7 +2059,9 @@ rec_print_comp(
 
 		fprintf(file, " %lu:", (ulong) i);
 
-		if (len != UNIV_SQL_NULL) {
+		if (len == UNIV_SQL_DEFAULT) {
+			fputs(" DEFAULT", file);
+		} else if (len != UNIV_SQL_NULL) {
 			if (len <= 30) {
 
 				ut_print_buf(file, data, len);
@@ -667,16 +667,19 @@ row_log_table_delete(
 }
 
 /******************************************************//**
-Logs an insert or update to a table that is being rebuilt. */
+Logs an insert or update to a table that is being rebuilt, converting
+a record that is not in the temporary file format of the new table:
+a ROW_FORMAT=REDUNDANT record, or a record that lacks instantly added
+columns. */
 static
 void
 row_log_table_low_redundant(
 /*========================*/
 	const rec_t*		rec,	/*!< in: clustered index leaf
-					page record in ROW_FORMAT=REDUNDANT,
-					page X-latched */
+					page record, page X-latched */
 	dict_index_t*		index,	/*!< in/out: clustered index, S-latched
 					or X-latched */
+	const ulint*		offsets,/*!< in: rec_get_offsets(rec,index) */
 	bool			insert,	/*!< in: true if insert,
 					false if update */
 	const dtuple_t*		old_pk,	/*!< in: old PRIMARY KEY value
@@ -695,10 +698,12 @@ row_log_table_low_redundant(
 	mem_heap_t*	heap		= NULL;
 	dtuple_t*	tuple;
 
-	ut_ad(!page_is_comp(page_align(rec)));
-	ut_ad(dict_index_get_n_fields(index) == rec_get_n_fields_old(rec));
+	ut_ad(!page_is_comp(page_align(rec)) == !dict_table_is_comp(
+		      index->table));
+	ut_ad(dict_index_get_n_fields(index) == rec_offs_n_fields(offsets));
 	ut_ad(dict_tf_is_valid(index->table->flags));
-	ut_ad(!dict_table_is_comp(index->table));  /* redundant row format */
+	ut_ad(!dict_table_is_comp(index->table)
+	      || dict_index_is_instant(index));
 	ut_ad(dict_index_is_clust(new_index));
 
 	heap = mem_heap_create(DTUPLE_EST_ALLOC(index->n_fields));
@@ -706,31 +711,18 @@ row_log_table_low_redundant(
 	dict_index_copy_types(tuple, index, index->n_fields);
 	dtuple_set_n_fields_cmp(tuple, dict_index_get_n_unique(index));
 
-	if (rec_get_1byte_offs_flag(rec)) {
-		for (ulint i = 0; i < index->n_fields; i++) {
-			dfield_t*	dfield;
-			ulint		len;
-			const void*	field;
-
-			dfield = dtuple_get_nth_field(tuple, i);
-			field = rec_get_nth_field_old(rec, i, &len);
-
-			dfield_set_data(dfield, field, len);
-		}
-	} else {
-		for (ulint i = 0; i < index->n_fields; i++) {
-			dfield_t*	dfield;
-			ulint		len;
-			const void*	field;
+	for (ulint i = 0; i < index->n_fields; i++) {
+		dfield_t*	dfield;
+		ulint		len;
+		const void*	field;
 
-			dfield = dtuple_get_nth_field(tuple, i);
-			field = rec_get_nth_field_old(rec, i, &len);
+		dfield = dtuple_get_nth_field(tuple, i);
+		field = rec_get_nth_cfield(rec, index, offsets, i, &len);
 
-			dfield_set_data(dfield, field, len);
+		dfield_set_data(dfield, field, len);
 
-			if (rec_2_is_field_extern(rec, i)) {
-				dfield_set_ext(dfield);
-			}
+		if (rec_offs_nth_extern(offsets, i)) {
+			dfield_set_ext(dfield);
 		}
 	}
 
@@ -832,9 +824,9 @@ row_log_table_low(
 		return;
 	}
 
-	if (!rec_offs_comp(offsets)) {
+	if (!rec_offs_comp(offsets) || dict_index_is_instant(index)) {
 		row_log_table_low_redundant(
-			rec, index, insert, old_pk, new_index);
+			rec, index, offsets, insert, old_pk, new_index);
 		return;
 	}
 
@@ -968,7 +960,14 @@ row_log_table_get_pk_col(
 
 	ut_ad(ut_is_2pow(zip_size));
 
-	field = rec_get_nth_field(rec, offsets, i, &len);
+	if (rec_offs_nth_default(offsets, i)) {
+		/* The column was added instantly after rec was
+		inserted. */
+		field = col->def_val;
+		len = col->def_val_len;
+	} else {
+		field = rec_get_nth_field(rec, offsets, i, &len);
+	}
 
 	if (len == UNIV_SQL_NULL) {
 		return(DB_INVALID_NULL);
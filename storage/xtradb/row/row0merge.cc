@@ -73,6 +73,10 @@ static ibool	row_merge_print_block_write;
 /* Whether to disable file system cache */
 UNIV_INTERN char	srv_disable_sort_file_cache;
 
+#ifdef UNIV_PFS_THREAD
+UNIV_INTERN mysql_pfs_key_t	row_merge_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 /* Maximum pending doc memory limit in bytes for a fts tokenization thread */
 #define FTS_PENDING_DOC_MEMORY_LIMIT	1000000
 
@@ -548,11 +552,19 @@ row_merge_dup_report(
 	row_merge_dup_t*	dup,	/*!< in/out: for reporting duplicates */
 	const dfield_t*		entry)	/*!< in: duplicate index entry */
 {
+	if (dup->mutex) {
+		os_fast_mutex_lock(dup->mutex);
+	}
+
 	if (!dup->n_dup++) {
 		/* Only report the first duplicate record,
 		but count all duplicate records. */
 		innobase_fields_to_mysql(dup->table, dup->index, entry);
 	}
+
+	if (dup->mutex) {
+		os_fast_mutex_unlock(dup->mutex);
+	}
 }
 
 /*************************************************************//**
@@ -1158,11 +1170,23 @@ row_merge_write_eof(
 	return(&block[0]);
 }
 
+/** Key range of the clustered index that is read by one of the threads
+of a parallel index build */
+struct row_merge_range_t {
+	const dtuple_t*		first;	/*!< the first key in the range,
+					or NULL for the start of the index */
+	const dtuple_t*		end;	/*!< the first key after the range,
+					or NULL for the end of the index */
+	os_fast_mutex_t*	mutex;	/*!< mutex for reporting duplicates */
+	ulint*			n_rows;	/*!< number of rows read by all
+					the threads */
+};
+
 /********************************************************************//**
 Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
 @return	DB_SUCCESS or error */
-static __attribute__((nonnull(1,2,3,4,6,9,10,16), warn_unused_result))
+static __attribute__((nonnull(1,2,3,4,6,9,10,16,19), warn_unused_result))
 dberr_t
 row_merge_read_clustered_index(
 /*===========================*/
@@ -1199,7 +1223,13 @@ row_merge_read_clustered_index(
 					ULINT_UNDEFINED if none is added */
 	ib_sequence_t&		sequence,/*!< in/out: autoinc sequence */
 	row_merge_block_t*	block, /*!< in/out: file buffer */
-	float pct_cost) /*!< in: percent of task weight out of total alter job */
+	float pct_cost, /*!< in: percent of task weight out of total alter job */
+	const row_merge_range_t* range,
+					/*!< in: key range to read, or NULL
+					to read the whole clustered index */
+	ulint*			error_key_num)
+					/*!< out: number of the index that
+					failed, if an error was returned */
 {
 	dict_index_t*		clust_index;	/* Clustered index */
 	mem_heap_t*		row_heap;	/* Heap memory to create
@@ -1284,8 +1314,19 @@ row_merge_read_clustered_index(
 
 	clust_index = dict_table_get_first_index(old_table);
 
-	btr_pcur_open_at_index_side(
-		true, clust_index, BTR_SEARCH_LEAF, &pcur, true, 0, &mtr);
+	if (range && range->first) {
+		/* Position the cursor before the first record of
+		the range. */
+		ut_ad(!fts_sort_idx);
+		ut_ad(add_autoinc == ULINT_UNDEFINED);
+
+		btr_pcur_open(clust_index, range->first, PAGE_CUR_L,
+			      BTR_SEARCH_LEAF, &pcur, &mtr);
+	} else {
+		btr_pcur_open_at_index_side(
+			true, clust_index, BTR_SEARCH_LEAF, &pcur, true, 0,
+			&mtr);
+	}
 
 	if (old_table != new_table) {
 		/* The table is being rebuilt.  Identify the columns
@@ -1337,14 +1378,14 @@ row_merge_read_clustered_index(
 		if (page_cur_is_after_last(cur)) {
 			if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
 				err = DB_INTERRUPTED;
-				trx->error_key_num = 0;
+				*error_key_num = 0;
 				goto func_exit;
 			}
 
 			if (online && old_table != new_table) {
 				err = row_log_table_get_error(clust_index);
 				if (err != DB_SUCCESS) {
-					trx->error_key_num = 0;
+					*error_key_num = 0;
 					goto func_exit;
 				}
 			}
@@ -1452,6 +1493,19 @@ row_merge_read_clustered_index(
 		offsets = rec_get_offsets(rec, clust_index, NULL,
 					  ULINT_UNDEFINED, &row_heap);
 
+		if (range && range->end
+		    && cmp_dtuple_rec(range->end, rec, offsets) <= 0) {
+			/* The rest of the index is read by another
+			thread. */
+			row = NULL;
+			mtr_commit(&mtr);
+			mem_heap_free(row_heap);
+			if (nonnull) {
+				mem_free(nonnull);
+			}
+			goto write_buffers;
+		}
+
 		if (online) {
 			/* Perform a REPEATABLE READ.
 
@@ -1535,7 +1589,7 @@ row_merge_read_clustered_index(
 
 			if (dfield_is_null(field)) {
 				err = DB_INVALID_NULL;
-				trx->error_key_num = 0;
+				*error_key_num = 0;
 				goto func_exit;
 			}
 		}
@@ -1564,7 +1618,7 @@ row_merge_read_clustered_index(
 
 			if (sequence.eof()) {
 				err = DB_ERROR;
-				trx->error_key_num = 0;
+				*error_key_num = 0;
 
 				ib_errf(trx->mysql_thd, IB_LOG_LEVEL_ERROR,
 					ER_AUTOINC_READ_FAILED, "[NULL]");
@@ -1627,7 +1681,7 @@ row_merge_read_clustered_index(
 					for (ulint j = 0; j < fts_sort_pll_degree; j++) {
 						if (psort_info[j].error != DB_SUCCESS) {
 							err = psort_info[j].error;
-							trx->error_key_num = i;
+							*error_key_num = i;
 							break;
 						}
 					}
@@ -1659,13 +1713,14 @@ row_merge_read_clustered_index(
 			if (buf->n_tuples) {
 				if (dict_index_is_unique(buf->index)) {
 					row_merge_dup_t	dup = {
-						buf->index, table, col_map, 0};
+						buf->index, table, col_map, 0,
+						range ? range->mutex : NULL};
 
 					row_merge_buf_sort(buf, &dup);
 
 					if (dup.n_dup) {
 						err = DB_DUPLICATE_KEY;
-						trx->error_key_num
+						*error_key_num
 							= key_numbers[i];
 						break;
 					}
@@ -1702,7 +1757,7 @@ row_merge_read_clustered_index(
 			if (!row_merge_write(file->fd, file->offset++,
 					     block)) {
 				err = DB_TEMP_FILE_WRITE_FAILURE;
-				trx->error_key_num = i;
+				*error_key_num = i;
 				break;
 			}
 
@@ -1739,7 +1794,9 @@ row_merge_read_clustered_index(
 		mem_heap_empty(row_heap);
 
 		/* Increment innodb_onlineddl_pct_progress status variable */
-		read_rows++;
+		read_rows = range
+			? os_atomic_increment_ulint(range->n_rows, 1)
+			: read_rows + 1;
 		if(read_rows % 1000 == 0) {
 			/* Update progress for each 1000 rows */
 			curr_progress = (read_rows >= table_total_rows) ?
@@ -1772,7 +1829,7 @@ row_merge_read_clustered_index(
 		for (ulint j = 0; j < fts_sort_pll_degree; j++) {
 			if (psort_info[j].error != DB_SUCCESS) {
 				err = psort_info[j].error;
-				trx->error_key_num = j;
+				*error_key_num = j;
 				break;
 			}
 		}
@@ -1955,8 +2012,16 @@ row_merge_blocks(
 	while (mrec0 && mrec1) {
 		switch (cmp_rec_rec_simple(
 				mrec0, mrec1, offsets0, offsets1,
-				dup->index, dup->table)) {
+				dup->index, dup->mutex ? NULL : dup->table)) {
 		case 0:
+			if (dup->mutex) {
+				/* The MySQL row buffer is shared by
+				the threads that sort the entries. */
+				os_fast_mutex_lock(dup->mutex);
+				innobase_rec_to_mysql(dup->table, mrec0,
+						      dup->index, offsets0);
+				os_fast_mutex_unlock(dup->mutex);
+			}
 			mem_heap_free(heap);
 			return(DB_DUPLICATE_KEY);
 		case -1:
@@ -2214,7 +2279,10 @@ row_merge_sort(
 					*/
 	const bool		update_progress,
 					/*!< in: update progress
-					status variable or not */
+					status variable and the progress
+					report of trx->mysql_thd or not;
+					false if not called by the thread
+					of trx->mysql_thd */
 	const float 		pct_progress,
 					/*!< in: total progress percent
 					until now */
@@ -2257,7 +2325,9 @@ row_merge_sort(
 	of file marker).  Thus, it must be at least one block. */
 	ut_ad(file->offset > 0);
 
-	thd_progress_init(trx->mysql_thd, num_runs);
+	if (update_progress) {
+		thd_progress_init(trx->mysql_thd, num_runs);
+	}
 	sql_print_information("InnoDB: Online DDL : merge-sorting has estimated %lu runs", num_runs);
 
 	/* Merge the runs until we have one big run */
@@ -2265,8 +2335,11 @@ row_merge_sort(
 		cur_run++;
 
 		/* Report progress of merge sort to MySQL for
-		show processlist progress field */
-		thd_progress_report(trx->mysql_thd, cur_run, num_runs);
+		show processlist progress field. Only the thread
+		that owns the THD may do this. */
+		if (update_progress) {
+			thd_progress_report(trx->mysql_thd, cur_run, num_runs);
+		}
 		sql_print_information("InnoDB: Online DDL : merge-sorting current run %lu estimated %lu runs", cur_run, num_runs);
 
 		error = row_merge(trx, dup, file, block, tmpfd,
@@ -2290,7 +2363,9 @@ row_merge_sort(
 
 	mem_free(run_offset);
 
-	thd_progress_end(trx->mysql_thd);
+	if (update_progress) {
+		thd_progress_end(trx->mysql_thd);
+	}
 
 	DBUG_RETURN(error);
 }
@@ -2338,31 +2413,464 @@ row_merge_copy_blobs(
 	}
 }
 
+/** A level of a B-tree that is being built by row_merge_bulk_insert() */
+struct row_merge_bulk_level_t {
+	ulint		page_no;	/*!< the rightmost page of the level */
+	ulint		n_pages;	/*!< number of pages in the level */
+	const dtuple_t*	node_ptr;	/*!< node pointer to the first page
+					of the level, while it is the only
+					page of the level */
+	mem_heap_t*	heap;		/*!< memory heap for node_ptr */
+};
+
+/** Bottom-up build of a secondary index tree from sorted index entries.
+The records are appended to the rightmost page of the leaf level, which
+starts in the root page. When the page is full, a new page is started
+and a node pointer to it is appended to the level above in the same way.
+Finally, the records of the topmost level are moved to the root page. */
+struct row_merge_bulk_t {
+	dict_index_t*		index;	/*!< the index being built */
+	trx_id_t		trx_id;	/*!< PAGE_MAX_TRX_ID of the leaf
+					pages */
+	ulint			n_levels;/*!< number of levels started */
+	row_merge_bulk_level_t	level[BTR_MAX_LEVELS];
+					/*!< the levels, leaf level first */
+	mtr_t			mtr;	/*!< mini-transaction of the
+					page that is being filled */
+	bool			mtr_active;/*!< whether mtr is active */
+	buf_block_t*		block;	/*!< the rightmost leaf page,
+					if mtr_active */
+	mem_heap_t*		heap;	/*!< memory heap for the offsets
+					of the inserted records */
+};
+
 /********************************************************************//**
-Read sorted file containing index data tuples and insert these data
-tuples to the index
-@return	DB_SUCCESS or error number */
+Appends a page to the right end of a level of an index that is being
+built by row_merge_bulk_insert().
+@return	DB_SUCCESS or DB_OUT_OF_FILE_SPACE */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_merge_bulk_page_alloc(
+/*======================*/
+	row_merge_bulk_t*	bulk,	/*!< in/out: index build */
+	ulint			level)	/*!< in: level of the page */
+{
+	row_merge_bulk_level_t*	lvl	= &bulk->level[level];
+	dict_index_t*		index	= bulk->index;
+	const ulint		space	= dict_index_get_space(index);
+	buf_block_t*		prev_block = NULL;
+	buf_block_t*		block;
+	page_t*			page;
+	ulint			n_reserved;
+	mtr_t			mtr;
+
+	ut_ad(!bulk->mtr_active);
+
+	log_free_check();
+	mtr_start(&mtr);
+	dict_disable_redo_if_unlogged(index->table, &mtr);
+	mtr_x_lock(dict_index_get_lock(index), &mtr);
+
+	if (lvl->n_pages) {
+		prev_block = btr_block_get(space, 0, lvl->page_no,
+					   RW_X_LATCH, index, &mtr);
+	}
+
+	if (!fsp_reserve_free_extents(&n_reserved, space, 2,
+				      FSP_NORMAL, &mtr)) {
+		mtr_commit(&mtr);
+		return(DB_OUT_OF_FILE_SPACE);
+	}
+
+	block = btr_page_alloc(index,
+			       prev_block
+			       ? lvl->page_no + 1
+			       : dict_index_get_page(index) + 1,
+			       FSP_UP, level, &mtr, &mtr);
+
+	if (n_reserved > 0) {
+		fil_space_release_free_extents(space, n_reserved);
+	}
+
+	if (block == NULL) {
+		mtr_commit(&mtr);
+		return(DB_OUT_OF_FILE_SPACE);
+	}
+
+	btr_page_create(block, NULL, index, level, &mtr);
+
+	page = buf_block_get_frame(block);
+	btr_page_set_next(page, NULL, FIL_NULL, &mtr);
+
+	if (prev_block) {
+		btr_page_set_prev(page, NULL, lvl->page_no, &mtr);
+		btr_page_set_next(buf_block_get_frame(prev_block), NULL,
+				  buf_block_get_page_no(block), &mtr);
+	} else {
+		btr_page_set_prev(page, NULL, FIL_NULL, &mtr);
+	}
+
+	if (level == 0) {
+		page_update_max_trx_id(block, NULL, bulk->trx_id, &mtr);
+	}
+
+	lvl->page_no = buf_block_get_page_no(block);
+	lvl->n_pages++;
+
+	mtr_commit(&mtr);
+
+	return(DB_SUCCESS);
+}
+
+/********************************************************************//**
+Moves the records of the leaf level of an index that is being built by
+row_merge_bulk_insert() from the root page to a new page, when the leaf
+level needs a second page.
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_merge_bulk_move_root(
+/*=====================*/
+	row_merge_bulk_t*	bulk)	/*!< in/out: index build */
+{
+	row_merge_bulk_level_t*	lvl	= &bulk->level[0];
+	dict_index_t*		index	= bulk->index;
+	const ulint		space	= dict_index_get_space(index);
+	buf_block_t*		root_block;
+	buf_block_t*		block;
+	page_t*			page;
+	dberr_t			error;
+	mtr_t			mtr;
+
+	ut_ad(!bulk->mtr_active);
+	ut_ad(lvl->n_pages == 1);
+	ut_ad(lvl->page_no == dict_index_get_page(index));
+
+	lvl->n_pages = 0;
+
+	error = row_merge_bulk_page_alloc(bulk, 0);
+
+	if (error != DB_SUCCESS) {
+		return(error);
+	}
+
+	log_free_check();
+	mtr_start(&mtr);
+	dict_disable_redo_if_unlogged(index->table, &mtr);
+	mtr_x_lock(dict_index_get_lock(index), &mtr);
+
+	root_block = btr_block_get(space, 0, dict_index_get_page(index),
+				   RW_X_LATCH, index, &mtr);
+	block = btr_block_get(space, 0, lvl->page_no,
+			      RW_X_LATCH, index, &mtr);
+	page = buf_block_get_frame(block);
+
+	/* PAGE_MAX_TRX_ID of the root page is otherwise only set when
+	the build ends, and page_copy_rec_list_end() copies it. */
+	page_update_max_trx_id(root_block, NULL, bulk->trx_id, &mtr);
+
+	if (!page_copy_rec_list_end(
+		    block, root_block,
+		    page_get_infimum_rec(buf_block_get_frame(root_block)),
+		    index, &mtr)) {
+		mtr_commit(&mtr);
+		return(DB_CORRUPTION);
+	}
+
+	btr_page_empty(root_block, NULL, index, 0, &mtr);
+
+	/* The node pointer to the first page of the level was built
+	while the page was the root page. */
+	mem_heap_empty(lvl->heap);
+	lvl->node_ptr = dict_index_build_node_ptr(
+		index, page_rec_get_next(page_get_infimum_rec(page)),
+		lvl->page_no, lvl->heap, 0);
+
+	mtr_commit(&mtr);
+
+	return(DB_SUCCESS);
+}
+
+/********************************************************************//**
+Appends an index entry or a node pointer to a level of an index that is
+being built bottom-up. The entries must be appended in ascending order.
+@return	DB_SUCCESS or error code */
 static __attribute__((nonnull, warn_unused_result))
 dberr_t
+row_merge_bulk_insert(
+/*==================*/
+	row_merge_bulk_t*	bulk,	/*!< in/out: index build */
+	ulint			level,	/*!< in: level, 0 for the leaf level */
+	const dtuple_t*		tuple)	/*!< in: entry to append */
+{
+	row_merge_bulk_level_t*	lvl	= &bulk->level[level];
+	dict_index_t*		index	= bulk->index;
+	mtr_t*			mtr	= &bulk->mtr;
+	const ulint		rec_size
+		= rec_get_converted_size(index, tuple, 0);
+	/* Leave some room for updates on the leaf pages. Node
+	pointers are never updated in place. */
+	const ulint		reserve	= level ? 0 : UNIV_PAGE_SIZE / 16;
+	page_t*			page;
+	page_cur_t		cur;
+	rec_t*			rec;
+	ulint*			offsets	= NULL;
+	dberr_t			error;
+
+	ut_ad(level <= bulk->n_levels);
+	ut_ad(!level || !bulk->mtr_active);
+
+	if (level == bulk->n_levels) {
+		if (level == BTR_MAX_LEVELS - 1) {
+			return(DB_CORRUPTION);
+		}
+
+		lvl->n_pages = 0;
+		lvl->node_ptr = NULL;
+		lvl->heap = mem_heap_create(256);
+		bulk->n_levels++;
+
+		if (level == 0) {
+			/* Start in the root page, so that an index
+			that fits in one page consists of the root
+			page only. */
+			lvl->page_no = dict_index_get_page(index);
+			lvl->n_pages = 1;
+		} else {
+			error = row_merge_bulk_page_alloc(bulk, level);
+
+			if (error != DB_SUCCESS) {
+				return(error);
+			}
+		}
+	}
+
+	if (!bulk->mtr_active) {
+get_page:
+		log_free_check();
+		mtr_start(mtr);
+		dict_disable_redo_if_unlogged(index->table, mtr);
+
+		if (level) {
+			mtr_x_lock(dict_index_get_lock(index), mtr);
+		}
+
+		bulk->block = btr_block_get(dict_index_get_space(index), 0,
+					    lvl->page_no, RW_X_LATCH,
+					    index, mtr);
+		bulk->mtr_active = true;
+	}
+
+	page = buf_block_get_frame(bulk->block);
+
+	if (!page_is_empty(page)
+	    && page_get_max_insert_size(page, 1) < rec_size + reserve) {
+		/* The page is full. Start a new one. */
+		mtr_commit(mtr);
+		bulk->mtr_active = false;
+
+		if (lvl->page_no == dict_index_get_page(index)) {
+			error = row_merge_bulk_move_root(bulk);
+
+			if (error != DB_SUCCESS) {
+				return(error);
+			}
+		}
+
+		if (lvl->n_pages == 1) {
+			/* Now that the level has more than one page,
+			it needs a parent. */
+			error = row_merge_bulk_insert(
+				bulk, level + 1, lvl->node_ptr);
+
+			if (error != DB_SUCCESS) {
+				return(error);
+			}
+		}
+
+		error = row_merge_bulk_page_alloc(bulk, level);
+
+		if (error != DB_SUCCESS) {
+			return(error);
+		}
+
+		goto get_page;
+	}
+
+	page_cur_position(page_rec_get_prev(page_get_supremum_rec(page)),
+			  bulk->block, &cur);
+
+	rec = page_cur_tuple_insert(&cur, tuple, index, &offsets,
+				    &bulk->heap, 0, mtr);
+
+	/* The record must fit in an empty page, and
+	page_get_max_insert_size() was checked above. */
+	ut_a(rec);
+
+	mem_heap_empty(bulk->heap);
+
+	if (page_rec_is_infimum(page_rec_get_prev(rec))) {
+		/* This is the first record on the page. */
+		dtuple_t*	node_ptr;
+
+		mem_heap_empty(lvl->heap);
+		node_ptr = dict_index_build_node_ptr(
+			index, rec, lvl->page_no, lvl->heap, level);
+
+		if (level && lvl->n_pages == 1) {
+			/* The leftmost record of a non-leaf level. */
+			btr_set_min_rec_mark(rec, mtr);
+		}
+
+		if (lvl->n_pages == 1) {
+			/* Defer the insert of the node pointer
+			until the level has a second page, because
+			the topmost level will be moved to the root
+			page. */
+			lvl->node_ptr = node_ptr;
+		} else {
+			mtr_commit(mtr);
+			bulk->mtr_active = false;
+
+			return(row_merge_bulk_insert(
+				       bulk, level + 1, node_ptr));
+		}
+	}
+
+	if (level) {
+		mtr_commit(mtr);
+		bulk->mtr_active = false;
+	}
+
+	return(DB_SUCCESS);
+}
+
+/********************************************************************//**
+Completes a bottom-up index build by moving the records of the topmost
+level to the root page, and frees the memory of the build.
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_merge_bulk_finish(
+/*==================*/
+	row_merge_bulk_t*	bulk,	/*!< in/out: index build */
+	dberr_t			error)	/*!< in: error code of the inserts */
+{
+	dict_index_t*	index	= bulk->index;
+
+	if (bulk->mtr_active) {
+		mtr_commit(&bulk->mtr);
+		bulk->mtr_active = false;
+	}
+
+	if (error == DB_SUCCESS && bulk->n_levels) {
+		const ulint	top	= bulk->n_levels - 1;
+		const ulint	space	= dict_index_get_space(index);
+		buf_block_t*	root_block;
+		buf_block_t*	block;
+		page_t*		root;
+		mtr_t		mtr;
+
+		ut_ad(bulk->level[top].n_pages == 1);
+
+		log_free_check();
+		mtr_start(&mtr);
+		dict_disable_redo_if_unlogged(index->table, &mtr);
+		mtr_x_lock(dict_index_get_lock(index), &mtr);
+
+		root_block = btr_block_get(space, 0, dict_index_get_page(index),
+					   RW_X_LATCH, index, &mtr);
+		root = buf_block_get_frame(root_block);
+
+		if (bulk->level[top].page_no == dict_index_get_page(index)) {
+			/* All the records fit in the root page. */
+			ut_ad(top == 0);
+			page_update_max_trx_id(root_block, NULL,
+					       bulk->trx_id, &mtr);
+			mtr_commit(&mtr);
+			goto func_exit;
+		}
+
+		ut_ad(page_is_empty(root));
+		ut_ad(page_is_leaf(root));
+
+		block = btr_block_get(space, 0, bulk->level[top].page_no,
+				      RW_X_LATCH, index, &mtr);
+
+		btr_page_set_level(root, NULL, top, &mtr);
+
+		if (!page_copy_rec_list_end(
+			    root_block, block,
+			    page_get_infimum_rec(buf_block_get_frame(block)),
+			    index, &mtr)) {
+			error = DB_CORRUPTION;
+		} else {
+			btr_page_free(index, block, &mtr);
+		}
+
+		mtr_commit(&mtr);
+	}
+
+func_exit:
+	for (ulint i = 0; i < bulk->n_levels; i++) {
+		mem_heap_free(bulk->level[i].heap);
+	}
+
+	mem_heap_free(bulk->heap);
+
+	return(error);
+}
+
+/** Read position in a sorted file of index entries, for
+row_merge_insert_index_tuples() */
+struct row_merge_cursor_t {
+	int			fd;	/*!< file descriptor */
+	ulint			foffs;	/*!< offset of the block being read,
+					in number of row_merge_block_t */
+	row_merge_block_t*	block;	/*!< buffer for the block */
+	const byte*		b;	/*!< pointer to the next record
+					in block */
+	mrec_buf_t*		buf;	/*!< buffer for a record that
+					spans two blocks */
+	const mrec_t*		mrec;	/*!< current record, or NULL
+					at the end of the file */
+	ulint*			offsets;/*!< offsets of mrec */
+};
+
+/********************************************************************//**
+Read sorted files containing index data tuples and insert these data
+tuples to the index. If there are several files, they are merged, and
+duplicates between them are reported as DB_DUPLICATE_KEY. In a
+parallel index build, secondary indexes in uncompressed tables are
+built bottom-up with row_merge_bulk_insert().
+@return	DB_SUCCESS or error number */
+static __attribute__((nonnull(2,3,4,7), warn_unused_result))
+dberr_t
 row_merge_insert_index_tuples(
 /*==========================*/
 	trx_id_t		trx_id,	/*!< in: transaction identifier */
 	dict_index_t*		index,	/*!< in: index */
 	const dict_table_t*	old_table,/*!< in: old table */
-	int			fd,	/*!< in: file descriptor */
-	row_merge_block_t*	block,	/*!< in/out: file buffer */
+	const merge_file_t*	files,	/*!< in: sorted files */
+	ulint			n_files,/*!< in: number of files */
+	struct TABLE*		table,	/*!< in/out: MySQL table, for
+					reporting duplicates between files */
+	row_merge_block_t*	block,	/*!< in/out: file buffer
+					of 3 blocks */
+	bool			bulk_load,/*!< in: whether secondary
+					indexes may be loaded bottom-up */
 	const ib_int64_t	table_total_rows, /*!< in: total rows of old table */
 	const float		pct_progress,	/*!< in: total progress percent until now */
 	const float		pct_cost) /*!< in: current progress percent */
 {
-	const byte*		b;
 	mem_heap_t*		heap;
 	mem_heap_t*		tuple_heap;
 	mem_heap_t*		ins_heap;
 	dberr_t			error = DB_SUCCESS;
-	ulint			foffs = 0;
-	ulint*			offsets;
-	mrec_buf_t*		buf;
+	row_merge_cursor_t*	cursors;
+	row_merge_block_t*	blocks = NULL;
+	ulint			blocks_size = 0;
+	row_merge_bulk_t*	bulk = NULL;
 	ib_int64_t		inserted_rows = 0;
 	float			curr_progress;
 	DBUG_ENTER("row_merge_insert_index_tuples");
@@ -2370,194 +2878,305 @@ row_merge_insert_index_tuples(
 	ut_ad(!srv_read_only_mode);
 	ut_ad(!(index->type & DICT_FTS));
 	ut_ad(trx_id);
+	ut_ad(n_files > 0);
 
 	tuple_heap = mem_heap_create(1000);
 
 	{
 		ulint i	= 1 + REC_OFFS_HEADER_SIZE
 			+ dict_index_get_n_fields(index);
-		heap = mem_heap_create(sizeof *buf + i * sizeof *offsets);
-		ins_heap = mem_heap_create(sizeof *buf + i * sizeof *offsets);
-		offsets = static_cast<ulint*>(
-			mem_heap_alloc(heap, i * sizeof *offsets));
-		offsets[0] = i;
-		offsets[1] = dict_index_get_n_fields(index);
+		heap = mem_heap_create(n_files * (sizeof *cursors
+						  + sizeof(mrec_buf_t)
+						  + i * sizeof(ulint)));
+		ins_heap = mem_heap_create(sizeof(mrec_buf_t)
+					   + i * sizeof(ulint));
+		cursors = static_cast<row_merge_cursor_t*>(
+			mem_heap_alloc(heap, n_files * sizeof *cursors));
+
+		for (ulint f = 0; f < n_files; f++) {
+			cursors[f].offsets = static_cast<ulint*>(
+				mem_heap_alloc(heap, i * sizeof(ulint)));
+			cursors[f].offsets[0] = i;
+			cursors[f].offsets[1]
+				= dict_index_get_n_fields(index);
+			cursors[f].buf = static_cast<mrec_buf_t*>(
+				mem_heap_alloc(heap, sizeof(mrec_buf_t)));
+		}
 	}
 
-	b = block;
+	if (n_files > 3) {
+		blocks_size = n_files * srv_sort_buf_size;
+		blocks = static_cast<row_merge_block_t*>(
+			os_mem_alloc_large(&blocks_size, FALSE));
 
-	if (!row_merge_read(fd, foffs, block)) {
-		error = DB_CORRUPTION;
-	} else {
-		buf = static_cast<mrec_buf_t*>(
-			mem_heap_alloc(heap, sizeof *buf));
+		if (blocks == NULL) {
+			error = DB_OUT_OF_MEMORY;
+			goto err_exit;
+		}
 
-		for (;;) {
-			const mrec_t*	mrec;
-			dtuple_t*	dtuple;
-			ulint		n_ext;
-			big_rec_t*	big_rec;
-			rec_t*		rec;
-			btr_cur_t	cursor;
-			mtr_t		mtr;
-
-			b = row_merge_read_rec(block, buf, b, index,
-					       fd, &foffs, &mrec, offsets);
-			if (UNIV_UNLIKELY(!b)) {
-				/* End of list, or I/O error */
-				if (mrec) {
-					error = DB_CORRUPTION;
-				}
-				break;
+		block = blocks;
+	}
+
+	for (ulint f = 0; f < n_files; f++) {
+		row_merge_cursor_t*	c = &cursors[f];
+
+		c->fd = files[f].fd;
+		c->foffs = 0;
+		c->block = &block[f * srv_sort_buf_size];
+
+		if (!row_merge_read(c->fd, c->foffs, c->block)) {
+			error = DB_CORRUPTION;
+			goto err_exit;
+		}
+
+		c->b = row_merge_read_rec(c->block, c->buf, c->block, index,
+					  c->fd, &c->foffs, &c->mrec,
+					  c->offsets);
+
+		if (UNIV_UNLIKELY(!c->b && c->mrec)) {
+			error = DB_CORRUPTION;
+			goto err_exit;
+		}
+	}
+
+	if (bulk_load && !dict_index_is_clust(index)
+	    && !dict_table_zip_size(index->table)) {
+		bulk = static_cast<row_merge_bulk_t*>(
+			mem_zalloc(sizeof *bulk));
+		bulk->index = index;
+		bulk->trx_id = trx_id;
+		bulk->heap = mem_heap_create(1024);
+	}
+
+	for (;;) {
+		const mrec_t*	mrec;
+		const ulint*	offsets;
+		dtuple_t*	dtuple;
+		ulint		n_ext;
+		big_rec_t*	big_rec;
+		rec_t*		rec;
+		btr_cur_t	cursor;
+		mtr_t		mtr;
+		ulint*		ins_offsets;
+		ulint		n = ULINT_UNDEFINED;
+
+		/* Find the smallest record of the files. */
+		for (ulint f = 0; f < n_files; f++) {
+			if (!cursors[f].mrec) {
+				continue;
 			}
 
-			dict_index_t*	old_index
-				= dict_table_get_first_index(old_table);
+			if (n == ULINT_UNDEFINED) {
+				n = f;
+				continue;
+			}
 
-			if (dict_index_is_clust(index)
-			    && dict_index_is_online_ddl(old_index)) {
-				error = row_log_table_get_error(old_index);
-				if (error != DB_SUCCESS) {
-					break;
-				}
+			switch (cmp_rec_rec_simple(
+					cursors[f].mrec, cursors[n].mrec,
+					cursors[f].offsets,
+					cursors[n].offsets,
+					index, table)) {
+			case 0:
+				error = DB_DUPLICATE_KEY;
+				goto err_exit;
+			case -1:
+				n = f;
 			}
+		}
+
+		if (n == ULINT_UNDEFINED) {
+			/* End of all files */
+			break;
+		}
 
-			dtuple = row_rec_to_index_entry_low(
-				mrec, index, offsets, &n_ext, tuple_heap);
+		mrec = cursors[n].mrec;
+		offsets = cursors[n].offsets;
 
-			if (!n_ext) {
-				/* There are no externally stored columns. */
-			} else {
-				ut_ad(dict_index_is_clust(index));
-				/* Off-page columns can be fetched safely
-				when concurrent modifications to the table
-				are disabled. (Purge can process delete-marked
-				records, but row_merge_read_clustered_index()
-				would have skipped them.)
-
-				When concurrent modifications are enabled,
-				row_merge_read_clustered_index() will
-				only see rows from transactions that were
-				committed before the ALTER TABLE started
-				(REPEATABLE READ).
-
-				Any modifications after the
-				row_merge_read_clustered_index() scan
-				will go through row_log_table_apply().
-				Any modifications to off-page columns
-				will be tracked by
-				row_log_table_blob_alloc() and
-				row_log_table_blob_free(). */
-				row_merge_copy_blobs(
-					mrec, offsets,
-					dict_table_zip_size(old_table),
-					dtuple, tuple_heap);
+		dict_index_t*	old_index
+			= dict_table_get_first_index(old_table);
+
+		if (dict_index_is_clust(index)
+		    && dict_index_is_online_ddl(old_index)) {
+			error = row_log_table_get_error(old_index);
+			if (error != DB_SUCCESS) {
+				break;
+			}
+		}
+
+		dtuple = row_rec_to_index_entry_low(
+			mrec, index, offsets, &n_ext, tuple_heap);
+
+		if (!n_ext) {
+			/* There are no externally stored columns. */
+		} else {
+			ut_ad(dict_index_is_clust(index));
+			/* Off-page columns can be fetched safely
+			when concurrent modifications to the table
+			are disabled. (Purge can process delete-marked
+			records, but row_merge_read_clustered_index()
+			would have skipped them.)
+
+			When concurrent modifications are enabled,
+			row_merge_read_clustered_index() will
+			only see rows from transactions that were
+			committed before the ALTER TABLE started
+			(REPEATABLE READ).
+
+			Any modifications after the
+			row_merge_read_clustered_index() scan
+			will go through row_log_table_apply().
+			Any modifications to off-page columns
+			will be tracked by
+			row_log_table_blob_alloc() and
+			row_log_table_blob_free(). */
+			row_merge_copy_blobs(
+				mrec, offsets,
+				dict_table_zip_size(old_table),
+				dtuple, tuple_heap);
+		}
+
+		ut_ad(dtuple_validate(dtuple));
+
+		if (bulk) {
+			error = row_merge_bulk_insert(bulk, 0, dtuple);
+
+			if (error != DB_SUCCESS) {
+				goto err_exit;
 			}
 
-			ut_ad(dtuple_validate(dtuple));
-			log_free_check();
+			goto next_rec;
+		}
+
+		log_free_check();
+
+		mtr_start(&mtr);
+		/* Insert after the last user record. */
+		btr_cur_open_at_index_side(
+			false, index, BTR_MODIFY_LEAF,
+			&cursor, 0, &mtr);
+		page_cur_position(
+			page_rec_get_prev(btr_cur_get_rec(&cursor)),
+			btr_cur_get_block(&cursor),
+			btr_cur_get_page_cur(&cursor));
+		cursor.flag = BTR_CUR_BINARY;
+#ifdef UNIV_DEBUG
+		/* Check that the records are inserted in order. */
+		rec = btr_cur_get_rec(&cursor);
+
+		if (!page_rec_is_infimum(rec)) {
+			ulint*	rec_offsets = rec_get_offsets(
+				rec, index, NULL,
+				ULINT_UNDEFINED, &tuple_heap);
+			ut_ad(cmp_dtuple_rec(dtuple, rec, rec_offsets)
+			      > 0);
+		}
+#endif /* UNIV_DEBUG */
+		ins_offsets = NULL;
+
+		error = btr_cur_optimistic_insert(
+			BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG
+			| BTR_KEEP_SYS_FLAG | BTR_CREATE_FLAG,
+			&cursor, &ins_offsets, &ins_heap,
+			dtuple, &rec, &big_rec, 0, NULL, &mtr);
 
+		if (error == DB_FAIL) {
+			ut_ad(!big_rec);
+			mtr_commit(&mtr);
 			mtr_start(&mtr);
-			/* Insert after the last user record. */
 			btr_cur_open_at_index_side(
-				false, index, BTR_MODIFY_LEAF,
+				false, index, BTR_MODIFY_TREE,
 				&cursor, 0, &mtr);
 			page_cur_position(
-				page_rec_get_prev(btr_cur_get_rec(&cursor)),
+				page_rec_get_prev(btr_cur_get_rec(
+							  &cursor)),
 				btr_cur_get_block(&cursor),
 				btr_cur_get_page_cur(&cursor));
-			cursor.flag = BTR_CUR_BINARY;
-#ifdef UNIV_DEBUG
-			/* Check that the records are inserted in order. */
-			rec = btr_cur_get_rec(&cursor);
-
-			if (!page_rec_is_infimum(rec)) {
-				ulint*	rec_offsets = rec_get_offsets(
-					rec, index, offsets,
-					ULINT_UNDEFINED, &tuple_heap);
-				ut_ad(cmp_dtuple_rec(dtuple, rec, rec_offsets)
-				      > 0);
-			}
-#endif /* UNIV_DEBUG */
-			ulint*	ins_offsets = NULL;
 
-			error = btr_cur_optimistic_insert(
-				BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG
+			error = btr_cur_pessimistic_insert(
+				BTR_NO_UNDO_LOG_FLAG
+				| BTR_NO_LOCKING_FLAG
 				| BTR_KEEP_SYS_FLAG | BTR_CREATE_FLAG,
 				&cursor, &ins_offsets, &ins_heap,
 				dtuple, &rec, &big_rec, 0, NULL, &mtr);
+		}
 
-			if (error == DB_FAIL) {
-				ut_ad(!big_rec);
-				mtr_commit(&mtr);
-				mtr_start(&mtr);
-				btr_cur_open_at_index_side(
-					false, index, BTR_MODIFY_TREE,
-					&cursor, 0, &mtr);
-				page_cur_position(
-					page_rec_get_prev(btr_cur_get_rec(
-								  &cursor)),
-					btr_cur_get_block(&cursor),
-					btr_cur_get_page_cur(&cursor));
-
-				error = btr_cur_pessimistic_insert(
-					BTR_NO_UNDO_LOG_FLAG
-					| BTR_NO_LOCKING_FLAG
-					| BTR_KEEP_SYS_FLAG | BTR_CREATE_FLAG,
-					&cursor, &ins_offsets, &ins_heap,
-					dtuple, &rec, &big_rec, 0, NULL, &mtr);
-			}
-
-			if (!dict_index_is_clust(index)) {
-				page_update_max_trx_id(
-					btr_cur_get_block(&cursor),
-					btr_cur_get_page_zip(&cursor),
-					trx_id, &mtr);
-			}
+		if (!dict_index_is_clust(index)) {
+			page_update_max_trx_id(
+				btr_cur_get_block(&cursor),
+				btr_cur_get_page_zip(&cursor),
+				trx_id, &mtr);
+		}
 
-			mtr_commit(&mtr);
+		mtr_commit(&mtr);
+
+		if (UNIV_LIKELY_NULL(big_rec)) {
+			/* If the system crashes at this
+			point, the clustered index record will
+			contain a null BLOB pointer. This
+			should not matter, because the copied
+			table will be dropped on crash
+			recovery anyway. */
+
+			ut_ad(dict_index_is_clust(index));
+			ut_ad(error == DB_SUCCESS);
+			error = row_ins_index_entry_big_rec(
+				dtuple, big_rec,
+				ins_offsets, &ins_heap,
+				index, NULL, __FILE__, __LINE__);
+			dtuple_convert_back_big_rec(
+				index, dtuple, big_rec);
+		}
 
-			if (UNIV_LIKELY_NULL(big_rec)) {
-				/* If the system crashes at this
-				point, the clustered index record will
-				contain a null BLOB pointer. This
-				should not matter, because the copied
-				table will be dropped on crash
-				recovery anyway. */
-
-				ut_ad(dict_index_is_clust(index));
-				ut_ad(error == DB_SUCCESS);
-				error = row_ins_index_entry_big_rec(
-					dtuple, big_rec,
-					ins_offsets, &ins_heap,
-					index, NULL, __FILE__, __LINE__);
-				dtuple_convert_back_big_rec(
-					index, dtuple, big_rec);
-			}
+		if (error != DB_SUCCESS) {
+			goto err_exit;
+		}
 
-			if (error != DB_SUCCESS) {
-				goto err_exit;
-			}
+next_rec:
+		mem_heap_empty(tuple_heap);
+		mem_heap_empty(ins_heap);
 
-			mem_heap_empty(tuple_heap);
-			mem_heap_empty(ins_heap);
+		/* Read the next record from the file of the record
+		that was inserted. */
+		{
+			row_merge_cursor_t*	c = &cursors[n];
 
-			/* Increment innodb_onlineddl_pct_progress status variable */
-			inserted_rows++;
-			if(inserted_rows % 1000 == 0) {
-				/* Update progress for each 1000 rows */
-				curr_progress = (inserted_rows >= table_total_rows ||
-					table_total_rows <= 0) ?
-						pct_cost :
-					((pct_cost * inserted_rows) / table_total_rows);
+			c->b = row_merge_read_rec(c->block, c->buf, c->b,
+						  index, c->fd, &c->foffs,
+						  &c->mrec, c->offsets);
 
-				/* presenting 10.12% as 1012 integer */;
-				onlineddl_pct_progress = (pct_progress + curr_progress) * 100;
+			if (UNIV_UNLIKELY(!c->b)) {
+				/* End of list, or I/O error */
+				if (c->mrec) {
+					error = DB_CORRUPTION;
+					goto err_exit;
+				}
 			}
 		}
+
+		/* Increment innodb_onlineddl_pct_progress status variable */
+		inserted_rows++;
+		if(inserted_rows % 1000 == 0) {
+			/* Update progress for each 1000 rows */
+			curr_progress = (inserted_rows >= table_total_rows ||
+				table_total_rows <= 0) ?
+					pct_cost :
+				((pct_cost * inserted_rows) / table_total_rows);
+
+			/* presenting 10.12% as 1012 integer */;
+			onlineddl_pct_progress = (pct_progress + curr_progress) * 100;
+		}
 	}
 
 err_exit:
+	if (bulk) {
+		error = row_merge_bulk_finish(bulk, error);
+		mem_free(bulk);
+	}
+
+	if (blocks) {
+		os_mem_free_large(blocks, blocks_size);
+	}
+
 	mem_heap_free(tuple_heap);
 	mem_heap_free(ins_heap);
 	mem_heap_free(heap);
@@ -3503,6 +4122,328 @@ row_merge_drop_table(
 	return(row_drop_table_for_mysql(table->name, trx, false, false));
 }
 
+/** Shared state of the threads of a parallel index build. The threads
+take jobs, key ranges of the clustered index to read or files to sort,
+in ascending order until there are no more jobs or one of them fails. */
+struct row_merge_pll_t {
+	trx_t*			trx;	/*!< transaction */
+	struct TABLE*		table;	/*!< MySQL table, for reporting
+					erroneous records */
+	const dict_table_t*	old_table;/*!< table where rows are read
+					from */
+	const dict_table_t*	new_table;/*!< table where indexes are
+					created */
+	bool			online;	/*!< true if creating indexes
+					online */
+	dict_index_t**		indexes;/*!< indexes to be created */
+	const ulint*		key_numbers;/*!< MySQL key numbers */
+	ulint			n_indexes;/*!< number of indexes */
+	const dtuple_t*		add_cols;/*!< default values of added
+					columns, or NULL */
+	const ulint*		col_map;/*!< mapping of old column numbers
+					to new ones, or NULL */
+	ib_sequence_t*		sequence;/*!< autoinc sequence, unused
+					because no AUTO_INCREMENT column
+					is added */
+	float			pct_cost;/*!< percent of task weight of
+					reading the clustered index */
+	const dtuple_t**	bounds;	/*!< the first keys of the key
+					ranges, except the first range */
+	merge_file_t*		files;	/*!< temporary files, n_indexes
+					for each key range */
+	ulint			n_jobs;	/*!< number of jobs */
+	ulint			next;	/*!< the next job to take */
+	ulint			n_done;	/*!< number of jobs completed */
+	ulint			n_rows;	/*!< number of rows read */
+	ulint			n_threads_active;/*!< number of threads
+					that have not exited yet */
+	os_fast_mutex_t		mutex;	/*!< protects error, error_key_num
+					and the MySQL row buffer of table */
+	dberr_t			error;	/*!< the first error, or
+					DB_SUCCESS */
+	ulint			error_key_num;/*!< trx->error_key_num
+					of the first error */
+};
+
+/*********************************************************************//**
+Notes an error of a thread of a parallel index build. The other threads
+will not take any more jobs. */
+static __attribute__((nonnull))
+void
+row_merge_pll_set_error(
+/*====================*/
+	row_merge_pll_t*	pll,	/*!< in/out: parallel index build */
+	dberr_t			error,	/*!< in: error code */
+	ulint			error_key_num)/*!< in: key number of
+					the error */
+{
+	os_fast_mutex_lock(&pll->mutex);
+
+	if (pll->error == DB_SUCCESS) {
+		pll->error = error;
+		pll->error_key_num = error_key_num;
+	}
+
+	os_fast_mutex_unlock(&pll->mutex);
+}
+
+/*********************************************************************//**
+Takes the next job of a parallel index build.
+@return	number of the job, or ULINT_UNDEFINED if there are no more jobs */
+static __attribute__((nonnull, warn_unused_result))
+ulint
+row_merge_pll_next(
+/*===============*/
+	row_merge_pll_t*	pll)	/*!< in/out: parallel index build */
+{
+	ulint	job;
+
+	if (pll->error != DB_SUCCESS) {
+		return(ULINT_UNDEFINED);
+	}
+
+	job = os_atomic_increment_ulint(&pll->next, 1) - 1;
+
+	return(job < pll->n_jobs ? job : ULINT_UNDEFINED);
+}
+
+/*********************************************************************//**
+Waits for the threads of a parallel index build to exit.
+@return	the first error of the threads, or DB_SUCCESS */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_merge_pll_wait(
+/*===============*/
+	row_merge_pll_t*	pll)	/*!< in/out: parallel index build */
+{
+	thd_progress_init(pll->trx->mysql_thd, pll->n_jobs);
+
+	while (os_atomic_increment_ulint(&pll->n_threads_active, 0)) {
+		/* Report progress of the jobs to MySQL for
+		show processlist progress field */
+		thd_progress_report(pll->trx->mysql_thd,
+				    os_atomic_increment_ulint(
+					    &pll->n_done, 0),
+				    pll->n_jobs);
+
+		os_thread_sleep(100000);
+	}
+
+	thd_progress_end(pll->trx->mysql_thd);
+
+	return(pll->error);
+}
+
+/*********************************************************************//**
+Thread of a parallel index build that reads key ranges of the clustered
+index, see row_merge_split_clustered_index(), and writes the index
+entries of each range to files of its own.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(row_merge_scan_thread)(
+/*==================================*/
+	void*	arg)	/*!< in: row_merge_pll_t */
+{
+	row_merge_pll_t*	pll = static_cast<row_merge_pll_t*>(arg);
+	ulint			block_size = srv_sort_buf_size;
+	row_merge_block_t*	block;
+	ulint			job;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(row_merge_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	block = static_cast<row_merge_block_t*>(
+		os_mem_alloc_large(&block_size, FALSE));
+
+	if (block == NULL) {
+		row_merge_pll_set_error(pll, DB_OUT_OF_MEMORY, 0);
+	} else {
+		while ((job = row_merge_pll_next(pll)) != ULINT_UNDEFINED) {
+			row_merge_range_t	range;
+			ulint			error_key_num;
+			dberr_t			error;
+
+			range.first = job ? pll->bounds[job - 1] : NULL;
+			range.end = job + 1 < pll->n_jobs
+				? pll->bounds[job] : NULL;
+			range.mutex = &pll->mutex;
+			range.n_rows = &pll->n_rows;
+
+			error = row_merge_read_clustered_index(
+				pll->trx, pll->table, pll->old_table,
+				pll->new_table, pll->online, pll->indexes,
+				NULL, NULL,
+				&pll->files[job * pll->n_indexes],
+				pll->key_numbers, pll->n_indexes,
+				pll->add_cols, pll->col_map,
+				ULINT_UNDEFINED, *pll->sequence,
+				block, pll->pct_cost, &range,
+				&error_key_num);
+
+			if (error != DB_SUCCESS) {
+				row_merge_pll_set_error(
+					pll, error, error_key_num);
+				break;
+			}
+
+			os_atomic_increment_ulint(&pll->n_done, 1);
+		}
+
+		os_mem_free_large(block, block_size);
+	}
+
+	os_atomic_decrement_ulint(&pll->n_threads_active, 1);
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Thread of a parallel index build that merge-sorts the temporary files
+written by the clustered index scan.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(row_merge_sort_thread)(
+/*==================================*/
+	void*	arg)	/*!< in: row_merge_pll_t */
+{
+	row_merge_pll_t*	pll = static_cast<row_merge_pll_t*>(arg);
+	ulint			block_size = 3 * srv_sort_buf_size;
+	row_merge_block_t*	block;
+	int			tmpfd;
+	ulint			job;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(row_merge_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	block = static_cast<row_merge_block_t*>(
+		os_mem_alloc_large(&block_size, FALSE));
+	tmpfd = row_merge_file_create_low();
+
+	if (block == NULL || tmpfd < 0) {
+		row_merge_pll_set_error(pll, DB_OUT_OF_MEMORY, 0);
+	} else {
+		while ((job = row_merge_pll_next(pll)) != ULINT_UNDEFINED) {
+			const ulint	i = job % pll->n_indexes;
+			dberr_t		error;
+			row_merge_dup_t	dup = {
+				pll->indexes[i], pll->table, pll->col_map,
+				0, &pll->mutex};
+
+			ut_ad(!(pll->indexes[i]->type & DICT_FTS));
+
+			error = row_merge_sort(
+				pll->trx, &dup, &pll->files[job], block,
+				&tmpfd, false, 0, 0);
+
+			if (error != DB_SUCCESS) {
+				row_merge_pll_set_error(
+					pll, error, pll->key_numbers[i]);
+				break;
+			}
+
+			os_atomic_increment_ulint(&pll->n_done, 1);
+		}
+	}
+
+	if (block != NULL) {
+		os_mem_free_large(block, block_size);
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	os_atomic_decrement_ulint(&pll->n_threads_active, 1);
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Divides the clustered index of a table into key ranges for the threads of
+a parallel index build. The ranges start at node pointer records of the
+root page that are evenly spaced, so that each range covers about as many
+subtrees of the root page.
+@return	number of key ranges; 1 if the index cannot be divided */
+static __attribute__((nonnull, warn_unused_result))
+ulint
+row_merge_split_clustered_index(
+/*============================*/
+	const dict_table_t*	table,	/*!< in: table */
+	ulint			n_threads,/*!< in: maximum number of
+					key ranges */
+	const dtuple_t***	bounds,	/*!< out: the first keys of the
+					ranges, except the first range */
+	mem_heap_t*		heap)	/*!< in/out: memory heap for bounds */
+{
+	dict_index_t*	index = dict_table_get_first_index(table);
+	buf_block_t*	block;
+	const page_t*	page;
+	const rec_t*	rec;
+	ulint		n_recs;
+	ulint		n_ranges;
+	mtr_t		mtr;
+
+	mtr_start(&mtr);
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	block = btr_block_get(dict_index_get_space(index),
+			      dict_table_zip_size(table),
+			      dict_index_get_page(index),
+			      RW_S_LATCH, index, &mtr);
+	page = buf_block_get_frame(block);
+	n_recs = page_get_n_recs(page);
+
+	if (page_is_leaf(page) || n_recs < 2) {
+		mtr_commit(&mtr);
+		*bounds = NULL;
+		return(1);
+	}
+
+	n_ranges = ut_min(n_threads, n_recs);
+
+	*bounds = static_cast<const dtuple_t**>(
+		mem_heap_alloc(heap, (n_ranges - 1) * sizeof **bounds));
+
+	rec = page_rec_get_next_const(page_get_infimum_rec(page));
+
+	/* Skip the first node pointer, whose subtree starts the
+	first range. */
+	for (ulint i = 0, r = 1; r < n_ranges;
+	     i++, rec = page_rec_get_next_const(rec)) {
+		ulint*	offsets;
+		rec_t*	copy;
+
+		if (i != r * n_recs / n_ranges) {
+			continue;
+		}
+
+		offsets = rec_get_offsets(rec, index, NULL,
+					  ULINT_UNDEFINED, &heap);
+		copy = rec_copy(mem_heap_alloc(heap, rec_offs_size(offsets)),
+				rec, offsets);
+
+		(*bounds)[r++ - 1] = dict_index_build_data_tuple(
+			index, copy, dict_index_get_n_unique_in_tree(index),
+			heap);
+	}
+
+	mtr_commit(&mtr);
+
+	return(n_ranges);
+}
+
 /*********************************************************************//**
 Build indexes on a table by reading a clustered index,
 creating a temporary file containing index entries, merge sorting
@@ -3549,6 +4490,14 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	ib_int64_t		sig_count = 0;
 	bool			fts_psort_initiated = false;
+	const ulint		n_threads = srv_index_build_threads;
+	row_merge_pll_t*	pll = NULL;
+	mem_heap_t*		bounds_heap = NULL;
+	const dtuple_t**	bounds = NULL;
+	ulint			n_ranges = 1;
+	ulint			n_files;
+	merge_file_t*		index_files;
+	bool			sorted = false;
 
 	float total_static_cost = 0;
 	float total_dynamic_cost = 0;
@@ -3575,14 +4524,44 @@ row_merge_build_indexes(
 
 	trx_start_if_not_started_xa(trx);
 
+	if (n_threads > 1) {
+		/* Full-text indexes have parallel threads of their
+		own, and the AUTO_INCREMENT values must be assigned
+		in the order of the clustered index. */
+		bool	serial = add_autoinc != ULINT_UNDEFINED;
+
+		for (i = 0; i < n_indexes; i++) {
+			if (indexes[i]->type & DICT_FTS) {
+				serial = true;
+			}
+		}
+
+		if (!serial) {
+			pll = static_cast<row_merge_pll_t*>(
+				mem_zalloc(sizeof *pll));
+			os_fast_mutex_init(PFS_NOT_INSTRUMENTED, &pll->mutex);
+			pll->error = DB_SUCCESS;
+
+			bounds_heap = mem_heap_create(1024);
+			n_ranges = row_merge_split_clustered_index(
+				old_table, n_threads, &bounds, bounds_heap);
+		}
+	}
+
+	/* Each key range of the clustered index is read into
+	files of its own, n_indexes files for each range. */
+	n_files = n_ranges * n_indexes;
+
 	merge_files = static_cast<merge_file_t*>(
-		mem_alloc(n_indexes * sizeof *merge_files));
+		mem_alloc(n_files * sizeof *merge_files));
+	index_files = static_cast<merge_file_t*>(
+		mem_alloc(n_ranges * sizeof *index_files));
 
 	/* Initialize all the merge file descriptors, so that we
 	don't call row_merge_file_destroy() on uninitialized
 	merge file descriptor */
 
-	for (i = 0; i < n_indexes; i++) {
+	for (i = 0; i < n_files; i++) {
 		merge_files[i].fd = -1;
 	}
 
@@ -3590,9 +4569,11 @@ row_merge_build_indexes(
 	total_dynamic_cost = COST_BUILD_INDEX_DYNAMIC * n_indexes;
 
 	for (i = 0; i < n_indexes; i++) {
-		if (row_merge_file_create(&merge_files[i]) < 0) {
-			error = DB_OUT_OF_MEMORY;
-			goto func_exit;
+		for (j = i; j < n_files; j += n_indexes) {
+			if (row_merge_file_create(&merge_files[j]) < 0) {
+				error = DB_OUT_OF_MEMORY;
+				goto func_exit;
+			}
 		}
 
 		if (indexes[i]->type & DICT_FTS) {
@@ -3611,6 +4592,7 @@ row_merge_build_indexes(
 			dup->table = table;
 			dup->col_map = col_map;
 			dup->n_dup = 0;
+			dup->mutex = NULL;
 
 			row_fts_psort_info_init(
 				trx, dup, new_table, opt_doc_id_size,
@@ -3642,18 +4624,61 @@ row_merge_build_indexes(
 	/* Read clustered index of the table and create files for
 	secondary index entries for merge sort */
 
-	error = row_merge_read_clustered_index(
-		trx, table, old_table, new_table, online, indexes,
-		fts_sort_idx, psort_info, merge_files, key_numbers,
-		n_indexes, add_cols, col_map,
-		add_autoinc, sequence, block, pct_cost);
+	if (pll) {
+		pll->trx = trx;
+		pll->table = table;
+		pll->old_table = old_table;
+		pll->new_table = new_table;
+		pll->online = online;
+		pll->indexes = indexes;
+		pll->key_numbers = key_numbers;
+		pll->n_indexes = n_indexes;
+		pll->add_cols = add_cols;
+		pll->col_map = col_map;
+		pll->sequence = &sequence;
+		pll->pct_cost = pct_cost;
+		pll->bounds = bounds;
+		pll->files = merge_files;
+	}
+
+	if (n_ranges > 1) {
+		sql_print_information("InnoDB: Online DDL : Reading %lu key"
+			" ranges of the clustered index with %lu threads",
+			n_ranges, n_ranges);
+
+		pll->n_jobs = n_ranges;
+		pll->n_threads_active = n_ranges;
+
+		for (j = 0; j < n_ranges; j++) {
+			os_thread_create(row_merge_scan_thread, pll, NULL);
+		}
+
+		error = row_merge_pll_wait(pll);
+
+		if (error != DB_SUCCESS) {
+			trx->error_key_num = pll->error_key_num;
+		}
+	} else {
+		ulint	error_key_num;
+
+		error = row_merge_read_clustered_index(
+			trx, table, old_table, new_table, online, indexes,
+			fts_sort_idx, psort_info, merge_files, key_numbers,
+			n_indexes, add_cols, col_map,
+			add_autoinc, sequence, block, pct_cost,
+			NULL, &error_key_num);
+
+		if (error != DB_SUCCESS) {
+			trx->error_key_num = error_key_num;
+		}
+	}
 
 	pct_progress += pct_cost;
 
 	sql_print_information("InnoDB: Online DDL : End of reading "
 		"clustered index of the table and create temporary files");
 
-	for (i = 0; i < n_indexes; i++) {
+	for (i = 0; i < n_files; i++) {
 		total_index_blocks += merge_files[i].offset;
 	}
 
@@ -3661,6 +4686,36 @@ row_merge_build_indexes(
 		goto func_exit;
 	}
 
+	if (pll && ut_min(n_threads, n_files) > 1) {
+		/* Sort the files of all the indexes at once. */
+		const ulint	n_sort_threads = ut_min(n_threads, n_files);
+
+		sql_print_information("InnoDB: Online DDL : Start merge-sorting"
+			" %lu files with %lu threads",
+			n_files, n_sort_threads);
+
+		pll->n_jobs = n_files;
+		pll->next = 0;
+		pll->n_done = 0;
+		pll->n_threads_active = n_sort_threads;
+
+		for (j = 0; j < n_sort_threads; j++) {
+			os_thread_create(row_merge_sort_thread, pll, NULL);
+		}
+
+		error = row_merge_pll_wait(pll);
+
+		sql_print_information("InnoDB: Online DDL : End of"
+			" merge-sorting %lu files", n_files);
+
+		if (error != DB_SUCCESS) {
+			trx->error_key_num = pll->error_key_num;
+			goto func_exit;
+		}
+
+		sorted = true;
+	}
+
 	DEBUG_SYNC_C("row_merge_after_scan");
 
 	/* Now we have files containing index entries ready for
@@ -3740,9 +4795,16 @@ row_merge_build_indexes(
 			char		*bufend;
 			row_merge_dup_t	dup = {
 				sort_idx, table, col_map, 0};
+			ulint		index_blocks = 0;
+			ib_int64_t	index_n_rec = 0;
+
+			for (j = i; j < n_files; j += n_indexes) {
+				index_blocks += merge_files[j].offset;
+				index_n_rec += merge_files[j].n_rec;
+			}
 
 			pct_cost = (COST_BUILD_INDEX_STATIC +
-				(total_dynamic_cost * merge_files[i].offset /
+				(total_dynamic_cost * index_blocks /
 					total_index_blocks)) /
 				(total_static_cost + total_dynamic_cost)
 				* PCT_COST_MERGESORT_INDEX * 100;
@@ -3754,23 +4816,27 @@ row_merge_build_indexes(
 
 			buf[bufend - buf]='\0';
 
-			sql_print_information("InnoDB: Online DDL : Start merge-sorting"
-				" index %s (%lu / %lu), estimated cost : %2.4f",
-				buf, (i+1), n_indexes, pct_cost);
+			if (!sorted) {
+				ut_ad(n_ranges == 1);
 
-			error = row_merge_sort(
-				trx, &dup, &merge_files[i],
-				block, &tmpfd, true, pct_progress, pct_cost);
+				sql_print_information("InnoDB: Online DDL : Start merge-sorting"
+					" index %s (%lu / %lu), estimated cost : %2.4f",
+					buf, (i+1), n_indexes, pct_cost);
 
-			pct_progress += pct_cost;
+				error = row_merge_sort(
+					trx, &dup, &merge_files[i],
+					block, &tmpfd, true, pct_progress, pct_cost);
 
-			sql_print_information("InnoDB: Online DDL : End of "
-				" merge-sorting index %s (%lu / %lu)",
-				buf, (i+1), n_indexes);
+				sql_print_information("InnoDB: Online DDL : End of "
+					" merge-sorting index %s (%lu / %lu)",
+					buf, (i+1), n_indexes);
+			}
+
+			pct_progress += pct_cost;
 
 			if (error == DB_SUCCESS) {
 				pct_cost = (COST_BUILD_INDEX_STATIC +
-					(total_dynamic_cost * merge_files[i].offset /
+					(total_dynamic_cost * index_blocks /
 						total_index_blocks)) /
 					(total_static_cost + total_dynamic_cost) *
 					PCT_COST_INSERT_INDEX * 100;
@@ -3780,10 +4846,18 @@ row_merge_build_indexes(
 					"cost : %2.4f", buf, (i+1),
 					n_indexes, pct_cost);
 
+				/* Collect the sorted files of the
+				index. */
+				for (j = 0; j < n_ranges; j++) {
+					index_files[j] = merge_files[
+						j * n_indexes + i];
+				}
+
 				error = row_merge_insert_index_tuples(
 					trx->id, sort_idx, old_table,
-					merge_files[i].fd, block,
-					merge_files[i].n_rec, pct_progress, pct_cost);
+					index_files, n_ranges, table, block,
+					pll != NULL, index_n_rec,
+					pct_progress, pct_cost);
 				pct_progress += pct_cost;
 
 				sql_print_information("InnoDB: Online DDL : "
@@ -3792,8 +4866,10 @@ row_merge_build_indexes(
 			}
 		}
 
-		/* Close the temporary file to free up space. */
-		row_merge_file_destroy(&merge_files[i]);
+		/* Close the temporary files to free up space. */
+		for (j = i; j < n_files; j += n_indexes) {
+			row_merge_file_destroy(&merge_files[j]);
+		}
 
 		if (indexes[i]->type & DICT_FTS) {
 			row_fts_psort_info_destroy(psort_info, merge_info);
@@ -3846,7 +4922,7 @@ row_merge_build_indexes(
 
 	row_merge_file_destroy_low(tmpfd);
 
-	for (i = 0; i < n_indexes; i++) {
+	for (i = 0; i < n_files; i++) {
 		row_merge_file_destroy(&merge_files[i]);
 	}
 
@@ -3854,6 +4930,16 @@ row_merge_build_indexes(
 		dict_mem_index_free(fts_sort_idx);
 	}
 
+	if (pll) {
+		os_fast_mutex_free(&pll->mutex);
+		mem_free(pll);
+	}
+
+	if (bounds_heap) {
+		mem_heap_free(bounds_heap);
+	}
+
+	mem_free(index_files);
 	mem_free(merge_files);
 	os_mem_free_large(block, block_size);
 
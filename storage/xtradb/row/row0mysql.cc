@@ -2842,6 +2842,40 @@ row_add_table_to_background_drop_list(
 	return(TRUE);
 }
 
+/*********************************************************************//**
+Removes the default values of the columns that were added to a table
+without rebuilding it from SYS_COLUMNS_ADDED. This must only be done
+when the table is being emptied, because the records that were inserted
+before the first such ALTER TABLE lack those columns.
+@return	error code or DB_SUCCESS */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_mysql_drop_columns_added(
+/*=========================*/
+	const dict_table_t*	table,	/*!< in: table */
+	trx_t*			trx)	/*!< in/out: transaction */
+{
+	pars_info_t*		info;
+	const dict_index_t*	index = dict_table_get_first_index(table);
+
+	/* The clustered index is missing if its creation failed. */
+	if (index == NULL || !dict_index_is_instant(index)) {
+		return(DB_SUCCESS);
+	}
+
+	info = pars_info_create();
+
+	pars_info_add_ull_literal(info, "id", table->id);
+
+	return(que_eval_sql(
+		       info,
+		       "PROCEDURE DROP_COLUMNS_ADDED_PROC () IS\n"
+		       "BEGIN\n"
+		       "DELETE FROM SYS_COLUMNS_ADDED\n"
+		       " WHERE TABLE_ID = :id;\n"
+		       "END;\n", FALSE, trx));
+}
+
 /*********************************************************************//**
 Reassigns the table identifier of a table.
 @return	error code or DB_SUCCESS */
@@ -3063,6 +3097,14 @@ row_discard_tablespace(
 		fts_drop_tables(trx, table);
 	}
 
+	/* The records of an imported tablespace contain all columns. */
+
+	err = row_mysql_drop_columns_added(table, trx);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
 	/* Assign a new space ID to the table definition so that purge
 	can ignore the changes. Update the system table on disk. */
 
@@ -3089,6 +3131,8 @@ row_discard_tablespace(
 
 		dict_table_change_id_in_cache(table, new_id);
 
+		dict_table_get_first_index(table)->n_core_fields = 0;
+
 		/* Reset the root page numbers. */
 
 		for (dict_index_t* index = UT_LIST_GET_FIRST(table->indexes);
@@ -3681,25 +3725,32 @@ row_truncate_table_for_mysql(
 		}
 	}
 
-	info = pars_info_create();
+	/* The table will be empty, and the records that will be
+	inserted into it will contain all columns. */
+	err = row_mysql_drop_columns_added(table, trx);
 
-	pars_info_add_int4_literal(info, "new_space", (lint) table->space);
-	pars_info_add_ull_literal(info, "old_id", table->id);
-	pars_info_add_ull_literal(info, "new_id", new_id);
+	if (err == DB_SUCCESS) {
+		info = pars_info_create();
 
-	err = que_eval_sql(info,
-			   "PROCEDURE RENUMBER_TABLE_ID_PROC () IS\n"
-			   "BEGIN\n"
-			   "UPDATE SYS_TABLES"
-			   " SET ID = :new_id, SPACE = :new_space\n"
-			   " WHERE ID = :old_id;\n"
-			   "UPDATE SYS_COLUMNS SET TABLE_ID = :new_id\n"
-			   " WHERE TABLE_ID = :old_id;\n"
-			   "UPDATE SYS_INDEXES"
-			   " SET TABLE_ID = :new_id, SPACE = :new_space\n"
-			   " WHERE TABLE_ID = :old_id;\n"
-			   "END;\n"
-			   , FALSE, trx);
+		pars_info_add_int4_literal(
+			info, "new_space", (lint) table->space);
+		pars_info_add_ull_literal(info, "old_id", table->id);
+		pars_info_add_ull_literal(info, "new_id", new_id);
+
+		err = que_eval_sql(info,
+				   "PROCEDURE RENUMBER_TABLE_ID_PROC () IS\n"
+				   "BEGIN\n"
+				   "UPDATE SYS_TABLES"
+				   " SET ID = :new_id, SPACE = :new_space\n"
+				   " WHERE ID = :old_id;\n"
+				   "UPDATE SYS_COLUMNS SET TABLE_ID = :new_id\n"
+				   " WHERE TABLE_ID = :old_id;\n"
+				   "UPDATE SYS_INDEXES"
+				   " SET TABLE_ID = :new_id, SPACE = :new_space\n"
+				   " WHERE TABLE_ID = :old_id;\n"
+				   "END;\n"
+				   , FALSE, trx);
+	}
 
 	if (err == DB_SUCCESS && old_space != table->space) {
 		info = pars_info_create();
@@ -3772,6 +3823,8 @@ row_truncate_table_for_mysql(
 
 		dict_table_change_id_in_cache(table, new_id);
 
+		dict_table_get_first_index(table)->n_core_fields = 0;
+
 		/* Reset the Doc ID in cache to 0 */
 		if (has_internal_doc_id && table->fts->cache) {
 			table->fts->fts_status |= TABLE_DICT_LOCKED;
@@ -4285,6 +4338,10 @@ row_drop_table_for_mysql(
 			   "END;\n"
 			   , FALSE, trx);
 
+	if (err == DB_SUCCESS) {
+		err = row_mysql_drop_columns_added(table, trx);
+	}
+
 	switch (err) {
 		ibool	is_temp;
 
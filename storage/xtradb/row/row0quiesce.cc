@@ -654,6 +654,17 @@ row_quiesce_set_state(
 		ib_senderrf(trx->mysql_thd, IB_LOG_LEVEL_WARN,
 			    ER_TABLE_IN_SYSTEM_TABLESPACE, table_name);
 
+		return(DB_UNSUPPORTED);
+	} else if (dict_index_is_instant(dict_table_get_first_index(table))) {
+		/* The records that were inserted before ALTER TABLE
+		added columns without rebuilding the table lack those
+		columns, and IMPORT TABLESPACE cannot know about it. */
+
+		ib_senderrf(trx->mysql_thd, IB_LOG_LEVEL_WARN,
+			    ER_NOT_SUPPORTED_YET,
+			    "FLUSH TABLES FOR EXPORT on a table to which "
+			    "columns were added without rebuilding it");
+
 		return(DB_UNSUPPORTED);
 	} else if (row_quiesce_table_has_fts_index(table)) {
 
@@ -339,8 +339,8 @@ row_build(
 
 		dfield_t*	dfield = dtuple_get_nth_field(row, col_no);
 
-		const byte*	field = rec_get_nth_field(
-			copy, offsets, i, &len);
+		const byte*	field = rec_get_nth_cfield(
+			copy, index, offsets, i, &len);
 
 		dfield_set_data(dfield, field, len);
 
@@ -429,6 +429,18 @@ row_rec_to_index_entry_low(
 	for (i = 0; i < rec_len; i++) {
 
 		dfield = dtuple_get_nth_field(entry, i);
+
+		if (rec_offs_nth_default(offsets, i)) {
+			const dict_col_t*	col
+				= dict_index_get_nth_col(index, i);
+
+			/* The column was added instantly after
+			the record was inserted. */
+			dfield_set_data(dfield, col->def_val,
+					col->def_val_len);
+			continue;
+		}
+
 		field = rec_get_nth_field(rec, offsets, i, &len);
 
 		dfield_set_data(dfield, field, len);
@@ -216,8 +216,9 @@ row_sel_sec_rec_is_for_clust_rec(
 		col = dict_field_get_col(ifield);
 		clust_pos = dict_col_get_clust_pos(col, clust_index);
 
-		clust_field = rec_get_nth_field(
-			clust_rec, clust_offs, clust_pos, &clust_len);
+		clust_field = rec_get_nth_cfield(
+			clust_rec, clust_index, clust_offs, clust_pos,
+			&clust_len);
 		sec_field = rec_get_nth_field(sec_rec, sec_offs, i, &sec_len);
 
 		len = clust_len;
@@ -471,8 +472,8 @@ row_sel_fetch_columns(
 
 				needs_copy = TRUE;
 			} else {
-				data = rec_get_nth_field(rec, offsets,
-							 field_no, &len);
+				data = rec_get_nth_cfield(rec, index, offsets,
+							  field_no, &len);
 
 				needs_copy = column->copy_val;
 			}
@@ -2741,15 +2742,9 @@ row_sel_field_store_in_mysql_format_func(
 	}
 }
 
-#ifdef UNIV_DEBUG
 /** Convert a field from Innobase format to MySQL format. */
-# define row_sel_store_mysql_field(m,p,r,i,o,f,t) \
+#define row_sel_store_mysql_field(m,p,r,i,o,f,t) \
 	row_sel_store_mysql_field_func(m,p,r,i,o,f,t)
-#else /* UNIV_DEBUG */
-/** Convert a field from Innobase format to MySQL format. */
-# define row_sel_store_mysql_field(m,p,r,i,o,f,t) \
-	row_sel_store_mysql_field_func(m,p,r,o,f,t)
-#endif /* UNIV_DEBUG */
 /**************************************************************//**
 Convert a field in the Innobase format to a field in the MySQL format. */
 static __attribute__((warn_unused_result))
@@ -2762,9 +2757,7 @@ row_sel_store_mysql_field_func(
 	const rec_t*		rec,		/*!< in: InnoDB record;
 						must be protected by
 						a page latch */
-#ifdef UNIV_DEBUG
 	const dict_index_t*	index,		/*!< in: index of rec */
-#endif
 	const ulint*		offsets,	/*!< in: array returned by
 						rec_get_offsets() */
 	ulint			field_no,	/*!< in: templ->rec_field_no or
@@ -2842,7 +2835,7 @@ row_sel_store_mysql_field_func(
 	} else {
 		/* Field is stored in the row. */
 
-		data = rec_get_nth_field(rec, offsets, field_no, &len);
+		data = rec_get_nth_cfield(rec, index, offsets, field_no, &len);
 
 		if (len == UNIV_SQL_NULL) {
 			/* MySQL assumes that the field for an SQL
@@ -78,6 +78,7 @@ row_undo_ins_remove_clust_rec(
 	ut_ad(dict_index_is_clust(index));
 
 	mtr_start(&mtr);
+	dict_disable_redo_if_unlogged(index->table, &mtr);
 
 	/* This is similar to row_undo_mod_clust(). The DDL thread may
 	already have copied this row from the log to the new table.
@@ -140,6 +141,7 @@ row_undo_ins_remove_clust_rec(
 retry:
 	/* If did not succeed, try pessimistic descent to tree */
 	mtr_start(&mtr);
+	dict_disable_redo_if_unlogged(index->table, &mtr);
 
 	success = btr_pcur_restore_position(BTR_MODIFY_TREE,
 					    &(node->pcur), &mtr);
@@ -195,6 +197,7 @@ row_undo_ins_remove_sec_low(
 	log_free_check();
 
 	mtr_start(&mtr);
+	dict_disable_redo_if_unlogged(index->table, &mtr);
 
 	if (mode == BTR_MODIFY_LEAF) {
 		mode = BTR_MODIFY_LEAF | BTR_ALREADY_S_LATCHED;
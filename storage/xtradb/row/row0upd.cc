@@ -594,6 +594,13 @@ row_upd_changes_field_size_or_external(
 	ulint			i;
 
 	ut_ad(rec_offs_validate(NULL, index, offsets));
+
+	if (rec_offs_any_default(offsets)) {
+		/* The record lacks some instantly added columns.
+		It must be rebuilt with all columns. */
+		return(TRUE);
+	}
+
 	n_fields = upd_get_n_fields(update);
 
 	for (i = 0; i < n_fields; i++) {
@@ -1101,7 +1108,7 @@ row_upd_build_difference_binary(
 
 	for (i = 0; i < dtuple_get_n_fields(entry); i++) {
 
-		data = rec_get_nth_field(rec, offsets, i, &len);
+		data = rec_get_nth_cfield(rec, index, offsets, i, &len);
 
 		dfield = dtuple_get_nth_field(entry, i);
 
@@ -1860,6 +1867,7 @@ row_upd_sec_index_entry(
 #endif /* UNIV_DEBUG */
 
 	mtr_start_trx(&mtr, trx);
+	dict_disable_redo_if_unlogged(index->table, &mtr);
 
 	if (*index->name == TEMP_INDEX_PREFIX) {
 		/* The index->online_status may change if the
@@ -2401,6 +2409,7 @@ row_upd_clust_rec(
 	down the index tree */
 
 	mtr_start_trx(mtr, thr_get_trx(thr));
+	dict_disable_redo_if_unlogged(index->table, mtr);
 
 	/* NOTE: this transaction has an s-lock or x-lock on the record and
 	therefore other transactions cannot modify the record when we have no
@@ -2616,6 +2625,7 @@ row_upd_clust_step(
 	/* We have to restore the cursor to its position */
 
 	mtr_start_trx(&mtr, thr_get_trx(thr));
+	dict_disable_redo_if_unlogged(node->table, &mtr);
 
 	/* If the restoration does not succeed, then the same
 	transaction has deleted the record on which the cursor was,
@@ -153,6 +153,9 @@ UNIV_INTERN my_bool	srv_read_only_mode;
 /** store to its own file each table created by an user; data
 dictionary tables are in the system tablespace 0 */
 UNIV_INTERN my_bool	srv_file_per_table;
+/** create each temporary table in a tablespace of its own whose changes
+are not written to the redo log nor to the doublewrite buffer */
+UNIV_INTERN my_bool	srv_unlogged_temp_tables = FALSE;
 /** The file format to use on new *.ibd files. */
 UNIV_INTERN ulint	srv_file_format = 0;
 /** Whether to check file format during startup.  A value of
@@ -169,6 +172,9 @@ on duplicate key checking and foreign key checking */
 UNIV_INTERN ibool	srv_locks_unsafe_for_binlog = FALSE;
 /** Sort buffer size in index creation */
 UNIV_INTERN ulong	srv_sort_buf_size = 1048576;
+/** Number of threads that read, sort and load the entries of new
+indexes in index creation */
+UNIV_INTERN ulong	srv_index_build_threads = 1;
 /** Maximum modification log file size for online index creation */
 UNIV_INTERN unsigned long long	srv_online_max_size;
 
@@ -456,6 +462,9 @@ UNIV_INTERN ulong	srv_n_purge_threads = 1;
 /* the number of pages to purge in one batch */
 UNIV_INTERN ulong	srv_purge_batch_size = 20;
 
+/* The number of threads that apply redo log records in crash recovery */
+UNIV_INTERN ulong	srv_n_recovery_threads = 4;
+
 /* Internal setting for "innodb_stats_method". Decides how InnoDB treats
 NULL value when collecting statistics. By default, it is set to
 SRV_STATS_NULLS_EQUAL(0), ie. all NULL value are treated equal */
@@ -481,6 +490,9 @@ UNIV_INTERN ulong	srv_force_recovery_crash;
 
 UNIV_INTERN my_bool	srv_print_all_deadlocks = FALSE;
 
+/** When to look for deadlocks, see lock_deadlock_detect_t */
+UNIV_INTERN ulong	srv_deadlock_detect_mode = LOCK_DEADLOCK_DETECT_EAGER;
+
 /* Produce a stacktrace on long semaphore wait */
 UNIV_INTERN my_bool     srv_use_stacktrace = FALSE;
 
@@ -521,6 +533,10 @@ UNIV_INTERN my_bool	srv_stats_sample_traditional = TRUE;
 
 UNIV_INTERN ibool	srv_use_doublewrite_buf	= TRUE;
 
+/** TRUE if the batch flushes of each buffer pool instance use their own
+doublewrite buffer and file */
+UNIV_INTERN my_bool	srv_parallel_doublewrite = FALSE;
+
 /** doublewrite buffer is 1MB is size i.e.: it can hold 128 16K pages.
 The following parameter is the size of the buffer that is used for
 batch flushing i.e.: LRU flushing and flush_list flushing. The rest
@@ -832,6 +848,9 @@ and/or load it during startup. */
 UNIV_INTERN char	srv_buffer_pool_dump_at_shutdown = FALSE;
 UNIV_INTERN char	srv_buffer_pool_load_at_startup = FALSE;
 
+/** The number of threads reading the pages of a buffer pool load */
+UNIV_INTERN ulong	srv_buf_load_threads = 4;
+
 /** Slot index in the srv_sys->sys_threads array for the purge thread. */
 static const ulint	SRV_PURGE_SLOT	= 1;
 
@@ -1814,6 +1833,10 @@ srv_export_innodb_status(void)
 	export_vars.innodb_buffer_pool_pages_free = free_len;
 
 	export_vars.innodb_deadlocks = srv_stats.lock_deadlock_count;
+	export_vars.innodb_deadlock_detect_time =
+		lock_sys->deadlock_detect_time;
+	export_vars.innodb_deadlock_graph_size =
+		lock_sys->deadlock_graph_size;
 
 #ifdef UNIV_DEBUG
 	export_vars.innodb_buffer_pool_pages_latched =
@@ -1977,6 +2000,10 @@ srv_export_innodb_status(void)
 	export_vars.innodb_available_undo_logs = srv_available_undo_logs;
 	export_vars.innodb_read_views_memory
 		= os_atomic_increment_ulint(&srv_read_views_memory, 0);
+	export_vars.innodb_read_views_reused
+		= srv_stats.n_read_views_reused;
+	export_vars.innodb_read_views_recopied
+		= srv_stats.n_read_views_recopied;
 	export_vars.innodb_descriptors_memory
 		= os_atomic_increment_ulint(&srv_descriptors_memory, 0);
 
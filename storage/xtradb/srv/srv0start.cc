@@ -2590,6 +2590,11 @@ innobase_start_or_create_for_mysql(void)
 				return(err);
 			}
 
+			err = dict_create_or_check_sys_columns_added();
+			if (err != DB_SUCCESS) {
+				return(err);
+			}
+
 			sys_datafiles_created = true;
 
 			/* This function assumes that SYS_DATAFILES exists */
@@ -2808,6 +2813,11 @@ innobase_start_or_create_for_mysql(void)
 		if (err != DB_SUCCESS) {
 			return(err);
 		}
+
+		err = dict_create_or_check_sys_columns_added();
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
 	}
 
 	srv_is_being_started = FALSE;
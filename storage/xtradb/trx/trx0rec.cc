@@ -688,7 +688,8 @@ trx_undo_page_report_modify(
 			ptr += mach_write_compressed(ptr, pos);
 
 			/* Save the old value of field */
-			field = rec_get_nth_field(rec, offsets, pos, &flen);
+			field = rec_get_nth_cfield(rec, index, offsets, pos,
+						   &flen);
 
 			if (trx_undo_left(undo_page, ptr) < 15) {
 
@@ -786,8 +787,8 @@ trx_undo_page_report_modify(
 				ptr += mach_write_compressed(ptr, pos);
 
 				/* Save the old value of field */
-				field = rec_get_nth_field(rec, offsets, pos,
-							  &flen);
+				field = rec_get_nth_cfield(rec, index, offsets,
+							   pos, &flen);
 
 				if (rec_offs_nth_extern(offsets, pos)) {
 					const dict_col_t*	col =
@@ -1380,6 +1380,10 @@ trx_sys_close(void)
 	ut_ad(trx_sys->descr_n_used == 0);
 	ut_free(trx_sys->descriptors);
 
+	for (ulint i = 0; i < trx_sys->descr_n_retired; i++) {
+		ut_free(trx_sys->descr_retired[i]);
+	}
+
 	mem_free(trx_sys);
 
 	trx_sys = NULL;
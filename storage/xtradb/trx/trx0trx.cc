@@ -116,6 +116,44 @@ trx_descr_cmp(
 	return 0;
 }
 
+/*************************************************************//**
+Replaces the descriptors array with a bigger one, for the readers that
+do not hold trx_sys->mutex. */
+UNIV_INLINE
+void
+trx_publish_descriptors(
+/*====================*/
+	trx_id_t*	descriptors)	/*!< in: new descriptors array */
+{
+	ut_ad(mutex_own(&trx_sys->mutex) || srv_is_being_started);
+
+#ifdef HAVE_ATOMIC_LOAD_STORE
+	os_atomic_store_release(&trx_sys->descriptors, descriptors);
+#else
+	trx_sys->descriptors = descriptors;
+#endif /* HAVE_ATOMIC_LOAD_STORE */
+}
+
+/*************************************************************//**
+Sets the number of used elements of the descriptors array after it was
+modified, for the readers that do not hold trx_sys->mutex. */
+UNIV_INLINE
+void
+trx_publish_descr_n_used(
+/*=====================*/
+	ulint		n_used)		/*!< in: number of used elements */
+{
+	ut_ad(mutex_own(&trx_sys->mutex) || srv_is_being_started);
+
+	trx_sys->descr_version++;
+
+#ifdef HAVE_ATOMIC_LOAD_STORE
+	os_atomic_store_release(&trx_sys->descr_n_used, n_used);
+#else
+	trx_sys->descr_n_used = n_used;
+#endif /* HAVE_ATOMIC_LOAD_STORE */
+}
+
 /*************************************************************//**
 Reserve a slot for a given trx in the global descriptors array. */
 UNIV_INLINE
@@ -139,11 +177,25 @@ trx_reserve_descriptor(
 
 	if (UNIV_UNLIKELY(n_used > n_max)) {
 
+		trx_id_t*	old_descriptors = trx_sys->descriptors;
+
 		n_max = n_max * 2;
 
-		trx_sys->descriptors = static_cast<trx_id_t*>(
-			ut_realloc(trx_sys->descriptors,
-				   n_max * sizeof(trx_id_t)));
+		descr = static_cast<trx_id_t*>(
+			ut_malloc(n_max * sizeof(trx_id_t)));
+
+		memcpy(descr, old_descriptors,
+		       trx_sys->descr_n_used * sizeof(trx_id_t));
+
+		/* read_view_open_now() may be copying the old array
+		without holding trx_sys->mutex */
+
+		ut_a(trx_sys->descr_n_retired
+		     < UT_ARR_SIZE(trx_sys->descr_retired));
+		trx_sys->descr_retired[trx_sys->descr_n_retired++]
+			= old_descriptors;
+
+		trx_publish_descriptors(descr);
 
 		trx_sys->descr_n_max = n_max;
 		srv_descriptors_memory = n_max * sizeof(trx_id_t);
@@ -174,7 +226,7 @@ trx_reserve_descriptor(
 
 	*descr = trx->id;
 
-	trx_sys->descr_n_used = n_used;
+	trx_publish_descr_n_used(n_used);
 }
 
 /*************************************************************//**
@@ -214,7 +266,7 @@ trx_release_descriptor(
 		ut_memmove(descr, descr + 1, size);
 	}
 
-	trx_sys->descr_n_used--;
+	trx_publish_descr_n_used(trx_sys->descr_n_used - 1);
 }
 
 /****************************************************************//**
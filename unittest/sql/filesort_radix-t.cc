@@ -0,0 +1,84 @@
+/*
+   Copyright (c) 2015, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+*/
+
+/** Unit test case for the function msd_radixsort_for_str_ptr(). */
+
+#include <tap.h>
+#include <my_global.h>
+#include <my_sys.h>
+#include <filesort_utils.h>
+
+/*
+  Sort 'count' keys of 'length' bytes, where only the last 'vary' bytes
+  of each key differ, and check that the result is in memcmp order.
+*/
+static void test_sort(uint count, uint length, uint vary, uint distinct)
+{
+  uchar *data= (uchar*) my_malloc(count * length, MYF(MY_FAE));
+  uchar **keys= (uchar**) my_malloc(count * sizeof(uchar*), MYF(MY_FAE));
+  Sort_key_prefix *work=
+    (Sort_key_prefix*) my_malloc(2 * count * sizeof(Sort_key_prefix),
+                                 MYF(MY_FAE));
+  ulonglong sum_before= 0, sum_after= 0;
+  bool sorted= true;
+
+  for (uint i= 0; i < count; i++)
+  {
+    uchar *key= data + i * length;
+    uint value= (uint) ((i * 2654435761U) % distinct);
+    memset(key, 'a', length);
+    for (uint j= 0; j < vary && j < 4; j++)
+      key[length - 1 - j]= (uchar) (value >> (8 * j));
+    keys[i]= key;
+    sum_before+= (ulonglong) (size_t) key;
+  }
+
+  msd_radixsort_for_str_ptr(keys, count, length, work);
+
+  for (uint i= 0; i < count; i++)
+  {
+    sum_after+= (ulonglong) (size_t) keys[i];
+    if (i && memcmp(keys[i - 1], keys[i], length) > 0)
+      sorted= false;
+  }
+  ok(sorted && sum_before == sum_after,
+     "count: %u length: %u varying bytes: %u distinct: %u",
+     count, length, vary, distinct);
+
+  my_free(work);
+  my_free(keys);
+  my_free(data);
+}
+
+
+int main(int argc __attribute__((unused)),char *argv[])
+{
+  MY_INIT(argv[0]);
+  plan(8);
+
+  test_sort(1000, 4, 4, 1000000);
+  test_sort(100000, 5, 4, 1000000);
+  test_sort(100000, 12, 3, 1000);
+  test_sort(50000, 17, 4, 50000);
+  test_sort(50000, 32, 2, 300);
+  test_sort(5000, 9, 1, 1);
+  test_sort(5000, 8, 4, 7);
+  test_sort(20, 16, 4, 20);
+
+  my_end(0);
+  return exit_status();
+}